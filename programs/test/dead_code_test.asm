@@ -0,0 +1,6 @@
+; Note: only for unit tests
+LDI  1
+OUT
+HLT
+JMP  0
+DB   5
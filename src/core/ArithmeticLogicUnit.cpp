@@ -1,5 +1,7 @@
 #include <iostream>
 
+#include "EventObserver.h"
+#include "Log.h"
 #include "Utils.h"
 
 #include "ArithmeticLogicUnit.h"
@@ -17,6 +19,8 @@ Core::ArithmeticLogicUnit::ArithmeticLogicUnit(const std::shared_ptr<GenericRegi
     this->value = 0;
     this->carry = false;
     this->zero = true;
+    this->stale = false;
+    this->eager = false;
 }
 
 Core::ArithmeticLogicUnit::~ArithmeticLogicUnit() {
@@ -26,18 +30,22 @@ Core::ArithmeticLogicUnit::~ArithmeticLogicUnit() {
 }
 
 void Core::ArithmeticLogicUnit::writeToBus() {
+    update();
     bus->write(value);
 }
 
 void Core::ArithmeticLogicUnit::print() const {
-    printf("ArithmeticLogicUnit: value - %d / 0x%02X / " BYTE_PATTERN " \n", value, value, BYTE_TO_BINARY(value));
-    std::cout << "ArithmeticLogicUnit: bits - C=" << carry << ", Z=" << zero << std::endl;
+    const State state = getState();
+    Log::printf("ArithmeticLogicUnit: value - %d / 0x%02X / " BYTE_PATTERN " \n", state.value, state.value,
+                BYTE_TO_BINARY(state.value));
+    Log::printf("ArithmeticLogicUnit: bits - C=%d, Z=%d\n", state.carry, state.zero);
 }
 
 void Core::ArithmeticLogicUnit::reset() {
     value = 0;
     carry = false;
     zero = true;
+    stale = false;
 }
 
 void Core::ArithmeticLogicUnit::out() {
@@ -48,32 +56,49 @@ void Core::ArithmeticLogicUnit::out() {
     writeToBus();
 }
 
-void Core::ArithmeticLogicUnit::registerValueChanged(const uint8_t registerValue) {
-    add();
+void Core::ArithmeticLogicUnit::registerValueChanged(const uint8_t) {
+    if (eager) {
+        add();
+    } else {
+        stale = true;
+    }
 }
 
-void Core::ArithmeticLogicUnit::add() {
-    uint8_t aValue = aRegister->readValue();
-    uint8_t bValue = bRegister->readValue();
-    uint16_t result = aValue + bValue;
-    uint8_t newValue = result;
-    bool newCarry = result > 255;
-    bool newZero = newValue == 0; // Both can be active at once if result is 256 (0b100000000) / new value is 0
+void Core::ArithmeticLogicUnit::update() const {
+    if (stale) {
+        add();
+    }
+}
+
+void Core::ArithmeticLogicUnit::add() const {
+    const State sum = calculateSum();
 
     if (Utils::debugL2()) {
-        std::cout << "ArithmeticLogicUnit: add. changing value from " << (int) value << " to " << (int) result
-                  << " (" << (int) newValue << ")" << std::endl;
+        std::cout << "ArithmeticLogicUnit: add. changing value from " << (int) value << " to " << (int) sum.value
+                  << std::endl;
         std::cout << "ArithmeticLogicUnit: add. changing bits from C=" << carry << ", Z=" << zero
-                  << " to C=" << newCarry << ", Z=" << newZero << std::endl;
+                  << " to C=" << sum.carry << ", Z=" << sum.zero << std::endl;
     }
 
-    value = newValue;
-    carry = newCarry;
-    zero = newZero;
+    value = sum.value;
+    carry = sum.carry;
+    zero = sum.zero;
+    stale = false;
 
     notifyObserver();
 }
 
+Core::ArithmeticLogicUnit::State Core::ArithmeticLogicUnit::calculateSum() const {
+    uint8_t aValue = aRegister->readValue();
+    uint8_t bValue = bRegister->readValue();
+    uint16_t result = aValue + bValue;
+    uint8_t newValue = result;
+    bool newCarry = result > 255;
+    bool newZero = newValue == 0; // Both can be active at once if result is 256 (0b100000000) / new value is 0
+
+    return {newValue, newCarry, newZero};
+}
+
 /**
  * Subtracts using two's compliment.
  *
@@ -123,24 +148,58 @@ void Core::ArithmeticLogicUnit::subtract() {
     value = newValue;
     carry = newCarry;
     zero = newZero;
+    stale = false;
 
     notifyObserver();
 }
 
 bool Core::ArithmeticLogicUnit::isCarry() const {
+    update();
     return carry;
 }
 
 bool Core::ArithmeticLogicUnit::isZero() const {
+    update();
     return zero;
 }
 
 void Core::ArithmeticLogicUnit::notifyObserver() const {
-    if (observer != nullptr) {
+    if (Utils::OBSERVED && observer != nullptr && changeFilter.shouldPass(Event::pack(value, carry, zero))) {
         observer->resultUpdated(value, carry, zero);
     }
 }
 
+Core::ArithmeticLogicUnit::State Core::ArithmeticLogicUnit::getState() const {
+    // Not stored, so looking at the state doesn't notify the observer, and the result is still stale for out()
+    if (stale) {
+        return calculateSum();
+    }
+
+    return {value, carry, zero};
+}
+
+void Core::ArithmeticLogicUnit::setState(const State &state) {
+    value = state.value;
+    carry = state.carry;
+    zero = state.zero;
+    stale = false;
+
+    notifyObserver();
+}
+
 void Core::ArithmeticLogicUnit::setObserver(const std::shared_ptr<ArithmeticLogicUnitObserver> &newObserver) {
     observer = newObserver;
 }
+
+void Core::ArithmeticLogicUnit::setNotifyEveryWrite(const bool everyWrite) {
+    changeFilter.setEveryWrite(everyWrite);
+}
+
+Core::ChangeFilter::Statistics Core::ArithmeticLogicUnit::getNotificationStatistics() const {
+    return changeFilter.getStatistics();
+}
+
+void Core::ArithmeticLogicUnit::setEager(const bool newEager) {
+    eager = newEager;
+    update();
+}
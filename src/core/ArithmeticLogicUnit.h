@@ -4,6 +4,7 @@
 #include <memory>
 
 #include "ArithmeticLogicUnitObserver.h"
+#include "ChangeFilter.h"
 #include "GenericRegister.h"
 #include "RegisterListener.h"
 
@@ -13,8 +14,10 @@ namespace Core {
      * An 8-bit ALU that can do addition and subtraction based on the values in the A- and B-registers,
      * and output the result to the bus.
      *
-     * Addition is performed as A-register + B-register and stored as soon as any of the registers change value,
-     * without waiting for the clock to tick.
+     * Addition is performed as A-register + B-register, without waiting for the clock to tick. The registers
+     * change value a lot more often than the result is used, so it's only calculated when something needs it,
+     * like out() or the flags register reading the bits. In eager mode it's calculated as soon as any of the
+     * registers change value instead, so an observer can show the result as it changes.
      *
      * Subtraction can be invoked to perform a recalculation as A-register - B-register and stored,
      * also without waiting for the clock to tick. Subtraction is a one off operation and not a state change,
@@ -31,6 +34,13 @@ namespace Core {
     class ArithmeticLogicUnit: public RegisterListener {
 
     public:
+        /** Everything needed to put this arithmetic logic unit back the way it was. */
+        struct State {
+            uint8_t value;
+            bool carry;
+            bool zero;
+        };
+
         ArithmeticLogicUnit(const std::shared_ptr<GenericRegister> &aRegister,
                             const std::shared_ptr<GenericRegister> &bRegister,
                             const std::shared_ptr<Bus> &bus);
@@ -54,20 +64,44 @@ namespace Core {
         /** Is the zero bit set. */
         [[nodiscard]] virtual bool isZero() const;
 
+        /** Get a copy of the current state. A stale result is calculated, but not stored or sent to the observer. */
+        [[nodiscard]] State getState() const;
+
+        /** Put back a state from getState(), and notify the observer. */
+        void setState(const State &state);
+
         /** Set an optional external observer of this arithmetic logic unit. */
         void setObserver(const std::shared_ptr<ArithmeticLogicUnitObserver> &newObserver);
 
+        /** Notify the observer of every write, instead of only when the result changes. Off by default. */
+        void setNotifyEveryWrite(bool everyWrite);
+
+        /** How many notifications to the observer were passed on or skipped. */
+        [[nodiscard]] ChangeFilter::Statistics getNotificationStatistics() const;
+
+        /** Calculate the sum every time a register changes, instead of when it's used. Off by default. */
+        void setEager(bool newEager);
+
     private:
         std::shared_ptr<GenericRegister> aRegister;
         std::shared_ptr<GenericRegister> bRegister;
         std::shared_ptr<Bus> bus;
         std::shared_ptr<ArithmeticLogicUnitObserver> observer;
-        uint8_t value;
-        bool carry;
-        bool zero;
+        mutable ChangeFilter changeFilter;
+        // The result is calculated on demand from const methods
+        mutable uint8_t value;
+        mutable bool carry;
+        mutable bool zero;
+        /** Whether a register changed since the result was calculated. */
+        mutable bool stale;
+        bool eager;
 
         void writeToBus();
-        void add();
+        void update() const;
+        void add() const;
+
+        /** The sum of the registers, without storing it or notifying the observer. */
+        [[nodiscard]] State calculateSum() const;
         void notifyObserver() const;
 
         void registerValueChanged(uint8_t newValue) override;
@@ -1,19 +1,35 @@
+#include <algorithm>
+#include <charconv>
 #include <fstream>
 #include <iostream>
-#include <sstream>
 #include <vector>
 
-#include "Instructions.h"
+#include "MachineImage.h"
 #include "Utils.h"
 
 #include "Assembler.h"
 
+namespace {
+    /** A problem with the source code, that points to the token where it is. */
+    class SourceError: public std::runtime_error {
+
+    public:
+        SourceError(const std::string_view token, const std::string &description) :
+                std::runtime_error("Assembler: " + description), token(token), description(description) {
+        }
+
+        const std::string_view token;
+        const std::string description;
+    };
+}
+
 Core::Assembler::Assembler() {
     if (Utils::debugL2()) {
         std::cout << "Assembler construct" << std::endl;
     }
 
     this->currentMemoryLocation = 0;
+    this->optimize = false;
 }
 
 Core::Assembler::~Assembler() {
@@ -23,97 +39,232 @@ Core::Assembler::~Assembler() {
 }
 
 std::vector<Core::Assembler::Instruction> Core::Assembler::loadInstructions(const std::string &fileName) {
-    std::vector<std::string> lines = loadFile(fileName);
-    std::vector<Instruction> instructions = interpret(lines);
+    const std::string source = loadFile(fileName);
+
+    return interpretSource(source);
+}
+
+void Core::Assembler::assembleToImage(const std::string &sourceFileName, const std::string &imageFileName) {
+    const std::vector<Instruction> instructions = loadInstructions(sourceFileName);
+
+    if (instructions.empty()) {
+        throw std::runtime_error("Assembler: no instructions in file: " + sourceFileName);
+    }
+
+    MachineImage::Program program{};
+    program.memory = toImage(instructions);
+
+    MachineImage::save(imageFileName, program);
+}
+
+Core::MemoryImage Core::Assembler::toImage(const std::vector<Instruction> &instructions) {
+    MemoryImage image{};
+
+    for (const auto &instruction : instructions) {
+        image[instruction.address.to_ulong()] = (instruction.opcode.to_ulong() << 4) | instruction.operand.to_ulong();
+    }
+
+    return image;
+}
+
+std::vector<Core::Assembler::Instruction> Core::Assembler::fromImage(const MemoryImage &image) {
+    std::vector<Instruction> instructions;
+
+    for (size_t address = 0; address < image.size(); address++) {
+        instructions.push_back({address, (unsigned long) image[address] >> 4, (unsigned long) image[address] & 0x0F});
+    }
 
     return instructions;
 }
 
-std::vector<std::string> Core::Assembler::loadFile(const std::string &fileName) {
+std::string Core::Assembler::loadFile(const std::string &fileName) {
     std::cout << "Assembler: loading file: " << fileName << std::endl;
 
-    std::ifstream file(fileName);
+    std::ifstream file(fileName, std::ios::binary | std::ios::ate);
 
     if (!file.is_open()) {
         throw std::runtime_error("Assembler: failed to open file: " + fileName);
     }
 
-    std::vector<std::string> lines;
-    std::string currentLine;
+    // One read of the whole file, which the lines and tokens then point into
+    std::string source(file.tellg(), '\0');
+    file.seekg(0);
+    file.read(source.data(), source.size());
 
-    while (std::getline(file, currentLine)) {
-        if (!currentLine.empty()) {
-            lines.push_back(currentLine);
-        }
+    return source;
+}
+
+void Core::Assembler::setOptimize(const bool newOptimize) {
+    optimize = newOptimize;
+}
+
+const std::vector<Core::PeepholeOptimizer::Rewrite> &Core::Assembler::getRewrites() const {
+    return rewrites;
+}
+
+void Core::Assembler::optimizeInstructions(std::vector<Instruction> &instructions) {
+    rewrites.clear();
+
+    if (!optimize || instructions.empty()) {
+        return;
     }
 
-    file.close();
+    rewrites = PeepholeOptimizer::optimize(toImage(instructions)).rewrites;
+
+    for (const auto &rewrite : rewrites) {
+        const Instruction optimized = {rewrite.address, (unsigned long) rewrite.after >> 4,
+                                       (unsigned long) rewrite.after & 0x0F};
+
+        // The last one wins when an address is defined more than once, same as in toImage()
+        auto existing = std::find_if(instructions.rbegin(), instructions.rend(), [&rewrite](const auto &instruction) {
+            return instruction.address == rewrite.address;
+        });
+
+        if (existing != instructions.rend()) {
+            *existing = optimized;
+        } else {
+            instructions.push_back(optimized);
+        }
+
+        if (Utils::debugL1()) {
+            std::cout << "Assembler: optimized " << PeepholeOptimizer::describe(rewrite) << std::endl;
+        }
+    }
+}
 
-    return lines;
+void Core::Assembler::fail(const std::string_view token, const std::string &message) const {
+    // The token points into the line, which gives the column of the problem
+    throw SourceError(token, message);
 }
 
 std::vector<Core::Assembler::Instruction> Core::Assembler::interpret(const std::vector<std::string> &lines) {
     std::vector<Instruction> instructions;
+    currentMemoryLocation = 0;
 
     for (const auto &line : lines) {
-        if (Utils::debugL1()) {
-            std::cout << "Assembler: " << line << std::endl;
+        // Empty lines are skipped before the address is checked, the same as in assemble()
+        if (!line.empty()) {
+            interpretLine(instructions, line);
         }
+    }
 
-        if (currentMemoryLocation > Utils::FOUR_BITS_MAX) {
-            throw std::runtime_error("Assembler: address out of bounds " + std::to_string(currentMemoryLocation));
-        }
+    optimizeInstructions(instructions);
+
+    return instructions;
+}
+
+std::vector<Core::Assembler::Instruction> Core::Assembler::interpretSource(const std::string_view source) {
+    Result result = assemble(source);
+
+    if (!result.ok()) {
+        throw std::runtime_error("Assembler: " + result.errors.front().message);
+    }
+
+    return std::move(result.instructions);
+}
+
+Core::Assembler::Result Core::Assembler::assemble(const std::string_view source) {
+    Result result{};
+    currentMemoryLocation = 0;
+
+    size_t lineStart = 0;
+    size_t lineNumber = 0;
 
-        std::vector<std::string> tokens = tokenize(line);
+    while (lineStart < source.size()) {
+        size_t lineEnd = source.find('\n', lineStart);
 
-        if (tokens.empty()) {
-            continue; // Skip pure comment lines
+        if (lineEnd == std::string_view::npos) {
+            lineEnd = source.size();
         }
 
-        std::string mnemonic = tokens[0];
-
-        // Supports 2 pseudo-instructions that can be used for adding data to the memory before the program runs.
-        // This is to support the flexibility of the DIP switches in the memory module.
-        if (mnemonic == "ORG") {
-            // "Origin" - changes memory location to the address in the parameter
-            std::string operand = tokens[1];
-            currentMemoryLocation = std::stoi(operand);
-        } else if (mnemonic == "DB") {
-            // "Define byte" - sets the parameter as a byte in memory at the current memory location
-            addData(instructions, tokens);
-            currentMemoryLocation++;
-        } else {
-            addInstruction(instructions, mnemonic, tokens);
-            currentMemoryLocation++;
+        const std::string_view line = source.substr(lineStart, lineEnd - lineStart);
+        lineNumber++;
+
+        // Empty lines are skipped before the address is checked, the same as in interpret()
+        if (!line.empty()) {
+            try {
+                interpretLine(result.instructions, line);
+            } catch (const SourceError &e) {
+                const size_t column = e.token.data() - line.data() + 1;
+                result.errors.push_back({lineNumber, column, e.description});
+            }
         }
+
+        lineStart = lineEnd + 1;
     }
 
-    return instructions;
+    if (result.ok()) {
+        optimizeInstructions(result.instructions);
+    }
+
+    result.image = toImage(result.instructions);
+
+    return result;
+}
+
+bool Core::Assembler::Result::ok() const {
+    return errors.empty();
 }
 
-void Core::Assembler::addData(std::vector<Instruction> &instructions, const std::vector<std::string> &tokens) const {
-    if (tokens.size() != 2) {
-        throw std::runtime_error("Assembler: wrong number of arguments to data");
+void Core::Assembler::interpretLine(std::vector<Instruction> &instructions, const std::string_view line) {
+    if (Utils::debugL1()) {
+        std::cout << "Assembler: " << line << std::endl;
     }
 
-    uint8_t value = std::stoi(tokens[1]);
-    std::bitset<4> msb = value >> 4;
-    std::bitset<4> lsb = value & 0x0F;
+    const Tokens tokens = tokenize(line);
 
-    Assembler::Instruction instruction = {std::bitset<4>(currentMemoryLocation), msb, lsb};
-    instructions.push_back(instruction);
+    if (currentMemoryLocation > Utils::FOUR_BITS_MAX) {
+        fail(tokens.count > 0 ? tokens.values[0] : line,
+             "address out of bounds " + std::to_string(currentMemoryLocation));
+    }
 
-    if (Utils::debugL1()) {
-        std::cout << "Assembler: " << instruction.address << " " << instruction.opcode << " " << instruction.operand
-                  << std::endl;
+    if (tokens.count == 0) {
+        return; // Skip pure comment lines
+    }
+
+    const std::string_view mnemonic = tokens.values[0];
+
+    // Supports 2 pseudo-instructions that can be used for adding data to the memory before the program runs.
+    // This is to support the flexibility of the DIP switches in the memory module.
+    if (mnemonic == "ORG") {
+        // "Origin" - changes memory location to the address in the parameter
+        if (tokens.count != 2) {
+            fail(mnemonic, "wrong number of arguments to origin");
+        }
+
+        const int address = parseNumber(tokens.values[1]);
+
+        if (address < 0 || address > Utils::FOUR_BITS_MAX + 1) {
+            fail(tokens.values[1], "address out of bounds " + std::to_string(address));
+        }
+
+        currentMemoryLocation = address;
+    } else if (mnemonic == "DB") {
+        // "Define byte" - sets the parameter as a byte in memory at the current memory location
+        addData(instructions, tokens);
+        currentMemoryLocation++;
+    } else {
+        addInstruction(instructions, tokens);
+        currentMemoryLocation++;
     }
 }
 
-void Core::Assembler::addInstruction(std::vector<Instruction> &instructions, const std::string &mnemonic, const std::vector<std::string> &tokens) {
-    const std::bitset<4> &opcodeBitset = interpretMnemonic(mnemonic);
-    const std::bitset<4> &operandBitset = interpretOperand(mnemonic, tokens);
+void Core::Assembler::addData(std::vector<Instruction> &instructions, const Tokens &tokens) const {
+    if (tokens.count != 2) {
+        fail(tokens.values[0], "wrong number of arguments to data");
+    }
 
-    Assembler::Instruction instruction = {std::bitset<4>(currentMemoryLocation), opcodeBitset, operandBitset};
+    const int number = parseNumber(tokens.values[1]);
+
+    if (number < 0 || number > 255) {
+        fail(tokens.values[1], "data out of bounds " + std::to_string(number));
+    }
+
+    uint8_t value = number;
+    std::bitset<4> msb = value >> 4;
+    std::bitset<4> lsb = value & 0x0F;
+
+    Assembler::Instruction instruction = {std::bitset<4>(currentMemoryLocation), msb, lsb};
     instructions.push_back(instruction);
 
     if (Utils::debugL1()) {
@@ -122,32 +273,39 @@ void Core::Assembler::addInstruction(std::vector<Instruction> &instructions, con
     }
 }
 
-std::bitset<4> Core::Assembler::interpretMnemonic(const std::string &mnemonic) {
-    const Instructions::Instruction &instruction = Instructions::find(mnemonic);
+void Core::Assembler::addInstruction(std::vector<Instruction> &instructions, const Tokens &tokens) const {
+    const std::string_view mnemonic = tokens.values[0];
+    // Looked up once, for both the opcode and the operand
+    const Instructions::Instruction instruction = Instructions::find(mnemonic);
 
     if (instruction == Instructions::UNKNOWN) {
-        throw std::runtime_error("Assembler: interpret mnemonic - unknown mnemonic " + mnemonic);
+        fail(mnemonic, "interpret mnemonic - unknown mnemonic " + std::string(mnemonic));
     }
 
-    return instruction.opcodeAsBitset();
-}
+    const std::bitset<4> &operandBitset = interpretOperand(instruction, tokens);
 
-std::bitset<4> Core::Assembler::interpretOperand(const std::string &mnemonic, const std::vector<std::string> &tokens) {
-    const Instructions::Instruction &instruction = Instructions::find(mnemonic);
+    Assembler::Instruction assembled = {std::bitset<4>(currentMemoryLocation), instruction.opcodeAsBitset(),
+                                        operandBitset};
+    instructions.push_back(assembled);
 
-    if (instruction == Instructions::UNKNOWN) {
-        throw std::runtime_error("Assembler: interpret operand - unknown mnemonic " + mnemonic);
+    if (Utils::debugL1()) {
+        std::cout << "Assembler: " << assembled.address << " " << assembled.opcode << " " << assembled.operand
+                  << std::endl;
     }
+}
 
+std::bitset<4> Core::Assembler::interpretOperand(const Instructions::Instruction &instruction,
+                                                 const Tokens &tokens) const {
     if (instruction.hasOperand) {
-        if (tokens.size() != 2) {
-            throw std::runtime_error("Assembler: interpret operand - wrong number of arguments to " + mnemonic);
+        if (tokens.count != 2) {
+            fail(tokens.values[0], "interpret operand - wrong number of arguments to " +
+                                  std::string(instruction.mnemonic));
         }
 
-        uint8_t operand = std::stoi(tokens[1]);
+        const int operand = parseNumber(tokens.values[1]);
 
-        if (operand > Utils::FOUR_BITS_MAX) {
-            throw std::runtime_error("Assembler: interpret operand - out of bounds " + std::to_string(operand));
+        if (operand < 0 || operand > Utils::FOUR_BITS_MAX) {
+            fail(tokens.values[1], "interpret operand - out of bounds " + std::to_string(operand));
         }
 
         return std::bitset<4>(operand);
@@ -156,23 +314,54 @@ std::bitset<4> Core::Assembler::interpretOperand(const std::string &mnemonic, co
     }
 }
 
-std::vector<std::string> Core::Assembler::tokenize(const std::string &line) const {
-    std::stringstream stream(line);
-    std::vector<std::string> tokens;
-    std::string token;
+Core::Assembler::Tokens Core::Assembler::tokenize(const std::string_view line) const {
+    Tokens tokens{};
+    size_t position = 0;
+
+    while (true) {
+        // Same whitespace as std::isspace
+        const size_t tokenStart = line.find_first_not_of(" \t\r\n\v\f", position);
+
+        if (tokenStart == std::string_view::npos) {
+            break;
+        }
 
-    while (stream >> token) {
         // Drop comments
-        if (Utils::startsWith(token, ";")) {
+        if (line[tokenStart] == ';') {
             break;
         }
 
-        tokens.push_back(token);
+        const size_t tokenEnd = std::min(line.find_first_of(" \t\r\n\v\f", tokenStart), line.size());
+        const std::string_view token = line.substr(tokenStart, tokenEnd - tokenStart);
+
+        // No line has more than 2 tokens, so the rest are only counted for the error message
+        if (tokens.count < tokens.values.size()) {
+            tokens.values[tokens.count] = token;
+        }
+
+        tokens.count++;
 
         if (Utils::debugL2()) {
             std::cout << "Token: " << token << std::endl;
         }
+
+        position = tokenEnd;
     }
 
     return tokens;
 }
+
+int Core::Assembler::parseNumber(const std::string_view token) const {
+    // Allow an explicit plus sign, which from_chars does not
+    const std::string_view digits = token.size() > 1 && token[0] == '+' && token[1] != '-' ? token.substr(1) : token;
+    int number = 0;
+
+    const auto [end, error] = std::from_chars(digits.data(), digits.data() + digits.size(), number);
+
+    // Also fails on trailing garbage like in "12abc"
+    if (error != std::errc() || end != digits.data() + digits.size()) {
+        fail(token, "invalid number " + std::string(token));
+    }
+
+    return number;
+}
@@ -1,10 +1,16 @@
 #ifndef INC_8_BIT_COMPUTER_EMULATOR_ASSEMBLER_H
 #define INC_8_BIT_COMPUTER_EMULATOR_ASSEMBLER_H
 
+#include <array>
 #include <bitset>
 #include <string>
+#include <string_view>
 #include <vector>
 
+#include "Instructions.h"
+#include "MemoryImage.h"
+#include "PeepholeOptimizer.h"
+
 namespace Core {
 
     /**
@@ -32,19 +38,78 @@ namespace Core {
             std::bitset<4> operand;
         };
 
+        /** A problem with the source code. Line and column start at 1. */
+        struct Error {
+            size_t line;
+            size_t column;
+            std::string message;
+        };
+
+        /** The outcome of assemble(). The image is only complete when there are no errors. */
+        struct Result {
+            MemoryImage image;
+            std::vector<Instruction> instructions;
+            std::vector<Error> errors;
+
+            [[nodiscard]] bool ok() const;
+        };
+
         /** Turns the assembly code in the file into machine instructions. */
         std::vector<Instruction> loadInstructions(const std::string &fileName);
 
+        /**
+         * Turns lines of assembly code into machine instructions. Invalid code throws a runtime_error
+         * that describes the problem, and nothing else.
+         */
+        std::vector<Instruction> interpret(const std::vector<std::string> &lines);
+
+        /** Same as interpret(), but for a whole source with lines separated by newlines. Nothing is copied. */
+        std::vector<Instruction> interpretSource(std::string_view source);
+
+        /**
+         * Assembles source code that is already in memory, without reading any files or throwing on invalid code.
+         * Every line with a problem is reported, and the rest of the lines are still assembled.
+         */
+        Result assemble(std::string_view source);
+
+        /**
+         * Run the peephole optimizer on the instructions of every program assembled from now on, before they are
+         * turned into an image. Off by default, so the memory is exactly what the source says.
+         */
+        void setOptimize(bool newOptimize);
+
+        /** What the optimizer changed in the last program that was assembled. */
+        [[nodiscard]] const std::vector<PeepholeOptimizer::Rewrite> &getRewrites() const;
+
+        /** Assembles the source file, and writes the result as a machine image file that loads without assembling. */
+        void assembleToImage(const std::string &sourceFileName, const std::string &imageFileName);
+
+        /** Puts the machine instructions in their place in a full image of the memory. The rest of the memory is 0. */
+        static MemoryImage toImage(const std::vector<Instruction> &instructions);
+
+        /** Turns a full image of the memory back into machine instructions, one for each address. */
+        static std::vector<Instruction> fromImage(const MemoryImage &image);
+
     private:
+        /** The tokens of one line, pointing into the line. Only the first ones are kept. */
+        struct Tokens {
+            std::array<std::string_view, 2> values;
+            size_t count;
+        };
+
         uint8_t currentMemoryLocation;
+        bool optimize;
+        std::vector<PeepholeOptimizer::Rewrite> rewrites;
 
-        std::vector<std::string> loadFile(const std::string &fileName);
-        std::vector<Instruction> interpret(const std::vector<std::string> &lines);
-        std::bitset<4> interpretMnemonic(const std::string &mnemonic);
-        std::bitset<4> interpretOperand(const std::string &mnemonic, const std::vector<std::string> &tokens);
-        void addInstruction(std::vector<Instruction> &instructions, const std::string &mnemonic, const std::vector<std::string> &tokens);
-        void addData(std::vector<Instruction> &instructions, const std::vector<std::string> &tokens) const;
-        [[nodiscard]] std::vector<std::string> tokenize(const std::string &line) const;
+        std::string loadFile(const std::string &fileName);
+        void optimizeInstructions(std::vector<Instruction> &instructions);
+        [[noreturn]] void fail(std::string_view token, const std::string &message) const;
+        void interpretLine(std::vector<Instruction> &instructions, std::string_view line);
+        std::bitset<4> interpretOperand(const Instructions::Instruction &instruction, const Tokens &tokens) const;
+        void addInstruction(std::vector<Instruction> &instructions, const Tokens &tokens) const;
+        void addData(std::vector<Instruction> &instructions, const Tokens &tokens) const;
+        [[nodiscard]] Tokens tokenize(std::string_view line) const;
+        [[nodiscard]] int parseNumber(std::string_view token) const;
     };
 }
 
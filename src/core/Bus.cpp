@@ -1,5 +1,6 @@
 #include <iostream>
 
+#include "Log.h"
 #include "Utils.h"
 
 #include "Bus.h"
@@ -33,21 +34,44 @@ void Core::Bus::write(const uint8_t newValue) {
 }
 
 void Core::Bus::print() const {
-    printf("Bus: %d / 0x%02X / " BYTE_PATTERN "\n", value, value, BYTE_TO_BINARY(value));
+    Log::printf("Bus: %d / 0x%02X / " BYTE_PATTERN "\n", value, value, BYTE_TO_BINARY(value));
 }
 
 void Core::Bus::reset() {
+    // Reset at the start of every step, when it's mostly 0 already
+    if (value == 0 && !changeFilter.isEveryWrite()) {
+        return;
+    }
+
     value = 0;
 
     notifyObserver();
 }
 
-void Core::Bus::notifyObserver() const {
-    if (observer != nullptr) {
+void Core::Bus::notifyObserver() {
+    if (Utils::OBSERVED && observer != nullptr && changeFilter.shouldPass(value)) {
         observer->valueUpdated(value);
     }
 }
 
+Core::Bus::State Core::Bus::getState() const {
+    return {value};
+}
+
+void Core::Bus::setState(const State &state) {
+    value = state.value;
+
+    notifyObserver();
+}
+
 void Core::Bus::setObserver(const std::shared_ptr<ValueObserver> &newObserver) {
     observer = newObserver;
 }
+
+void Core::Bus::setNotifyEveryWrite(const bool everyWrite) {
+    changeFilter.setEveryWrite(everyWrite);
+}
+
+Core::ChangeFilter::Statistics Core::Bus::getNotificationStatistics() const {
+    return changeFilter.getStatistics();
+}
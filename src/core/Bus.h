@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <memory>
 
+#include "ChangeFilter.h"
 #include "ValueObserver.h"
 
 namespace Core {
@@ -14,6 +15,11 @@ namespace Core {
     class Bus {
 
     public:
+        /** Everything needed to put this bus back the way it was. */
+        struct State {
+            uint8_t value;
+        };
+
         Bus();
         ~Bus();
 
@@ -26,17 +32,30 @@ namespace Core {
         /** Print current value to standard out. */
         void print() const;
 
-        /** Reset the bus to 0. */
+        /** Reset the bus to 0. Only notifies the observer when it wasn't 0 already, unless notifying every write. */
         virtual void reset();
 
+        /** Get a copy of the current state. */
+        [[nodiscard]] State getState() const;
+
+        /** Put back a state from getState(), and notify the observer. */
+        void setState(const State &state);
+
         /** Set an optional external observer of this bus. */
         void setObserver(const std::shared_ptr<ValueObserver> &newObserver);
 
+        /** Notify the observer of every write, instead of only when the value changes. Off by default. */
+        void setNotifyEveryWrite(bool everyWrite);
+
+        /** How many notifications to the observer were passed on or skipped. */
+        [[nodiscard]] ChangeFilter::Statistics getNotificationStatistics() const;
+
     private:
         std::shared_ptr<ValueObserver> observer;
+        ChangeFilter changeFilter;
         uint8_t value;
 
-        void notifyObserver() const;
+        void notifyObserver();
     };
 }
 
@@ -0,0 +1,63 @@
+#ifndef INC_8_BIT_COMPUTER_EMULATOR_CHANGEFILTER_H
+#define INC_8_BIT_COMPUTER_EMULATOR_CHANGEFILTER_H
+
+#include <cstdint>
+
+namespace Core {
+
+    /**
+     * Remembers the values a component last sent to its observer, so the component only notifies it when
+     * they are different.
+     *
+     * The components write on every step, even when nothing changes. Observers that show the values only care
+     * about the changes, so checking in the component saves the call to the observer. Tools that trace every
+     * write can turn the check off. Only used from the thread the emulator runs on.
+     */
+    class ChangeFilter {
+
+    public:
+        struct Statistics {
+            unsigned long passed = 0;
+            unsigned long skipped = 0;
+        };
+
+        ChangeFilter() : everyWrite(false), notified(false), lastValues(0) {}
+
+        /** Whether to notify the observer, with all the values packed into one number. */
+        bool shouldPass(const uint32_t values) {
+            // The first notification always goes through, so the observer knows where it starts
+            if (notified && values == lastValues && !everyWrite) {
+                statistics.skipped++;
+                return false;
+            }
+
+            notified = true;
+            lastValues = values;
+            statistics.passed++;
+
+            return true;
+        }
+
+        /** Pass on every notification, even when nothing changed. Off by default. */
+        void setEveryWrite(const bool newEveryWrite) {
+            everyWrite = newEveryWrite;
+        }
+
+        [[nodiscard]] bool isEveryWrite() const {
+            return everyWrite;
+        }
+
+        /** How many notifications were passed on or skipped. */
+        [[nodiscard]] Statistics getStatistics() const {
+            return statistics;
+        }
+
+    private:
+        bool everyWrite;
+        bool notified;
+        uint32_t lastValues;
+        Statistics statistics;
+    };
+}
+
+#endif //INC_8_BIT_COMPUTER_EMULATOR_CHANGEFILTER_H
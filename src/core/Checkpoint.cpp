@@ -0,0 +1,143 @@
+#include <fstream>
+#include <iterator>
+
+#include "Checkpoint.h"
+#include "Utils.h"
+
+namespace {
+    const char MAGIC[] = {'8', 'B', 'C', 'P'};
+
+    uint8_t bits(const bool first, const bool second = false, const bool third = false) {
+        return first | second << 1 | third << 2;
+    }
+
+    bool bit(const uint8_t value, const int index) {
+        return (value >> index) & 1;
+    }
+}
+
+std::vector<uint8_t> Core::Checkpoint::toBytes(const Snapshot &snapshot) {
+    std::vector<uint8_t> bytes(MAGIC, MAGIC + sizeof(MAGIC));
+    bytes.push_back(VERSION);
+    bytes.push_back(STATE_SIZE);
+
+    const auto &memory = snapshot.randomAccessMemory;
+    bytes.insert(bytes.end(), memory.memory.begin(), memory.memory.end());
+    bytes.push_back(memory.address);
+    bytes.push_back(bits(memory.readOnClock));
+
+    bytes.push_back(bits(snapshot.clock.halted));
+    bytes.push_back(snapshot.bus.value);
+    bytes.push_back(snapshot.aRegister.value);
+    bytes.push_back(bits(snapshot.aRegister.readOnClock));
+    bytes.push_back(snapshot.bRegister.value);
+    bytes.push_back(bits(snapshot.bRegister.readOnClock));
+    bytes.push_back(snapshot.arithmeticLogicUnit.value);
+    bytes.push_back(bits(snapshot.arithmeticLogicUnit.carry, snapshot.arithmeticLogicUnit.zero));
+    bytes.push_back(snapshot.memoryAddressRegister.value);
+    bytes.push_back(bits(snapshot.memoryAddressRegister.readOnClock));
+    bytes.push_back(snapshot.programCounter.value);
+    bytes.push_back(bits(snapshot.programCounter.incrementOnClock, snapshot.programCounter.readOnClock));
+    bytes.push_back(snapshot.instructionRegister.value);
+    bytes.push_back(bits(snapshot.instructionRegister.readOnClock));
+    bytes.push_back(snapshot.outputRegister.value);
+    bytes.push_back(bits(snapshot.outputRegister.readOnClock));
+    bytes.push_back(snapshot.stepCounter.counter);
+    bytes.push_back(bits(snapshot.flagsRegister.carryFlag, snapshot.flagsRegister.zeroFlag,
+                         snapshot.flagsRegister.readOnClock));
+
+    return bytes;
+}
+
+Core::Snapshot Core::Checkpoint::fromBytes(const std::vector<uint8_t> &bytes) {
+    if (bytes.size() < HEADER_SIZE || !std::equal(MAGIC, MAGIC + sizeof(MAGIC), bytes.begin())) {
+        throw std::runtime_error("Checkpoint: not a checkpoint");
+    }
+
+    if (bytes[4] != VERSION) {
+        throw std::runtime_error("Checkpoint: unsupported version " + std::to_string(bytes[4]));
+    }
+
+    if (bytes[5] != STATE_SIZE || bytes.size() != HEADER_SIZE + STATE_SIZE) {
+        throw std::runtime_error("Checkpoint: wrong size");
+    }
+
+    Snapshot snapshot{};
+    auto next = bytes.begin() + HEADER_SIZE;
+
+    auto &memory = snapshot.randomAccessMemory;
+    std::copy(next, next + memory.memory.size(), memory.memory.begin());
+    next += memory.memory.size();
+    memory.address = *next++;
+    memory.readOnClock = bit(*next++, 0);
+
+    if (memory.address >= RandomAccessMemory::MEMORY_SIZE) {
+        throw std::runtime_error("Checkpoint: memory address out of bounds " + std::to_string(memory.address));
+    }
+
+    snapshot.clock.halted = bit(*next++, 0);
+    snapshot.bus.value = *next++;
+    snapshot.aRegister.value = *next++;
+    snapshot.aRegister.readOnClock = bit(*next++, 0);
+    snapshot.bRegister.value = *next++;
+    snapshot.bRegister.readOnClock = bit(*next++, 0);
+    snapshot.arithmeticLogicUnit.value = *next++;
+    snapshot.arithmeticLogicUnit.carry = bit(*next, 0);
+    snapshot.arithmeticLogicUnit.zero = bit(*next++, 1);
+    snapshot.memoryAddressRegister.value = *next++;
+    snapshot.memoryAddressRegister.readOnClock = bit(*next++, 0);
+    snapshot.programCounter.value = *next++;
+    snapshot.programCounter.incrementOnClock = bit(*next, 0);
+    snapshot.programCounter.readOnClock = bit(*next++, 1);
+    snapshot.instructionRegister.value = *next++;
+    snapshot.instructionRegister.readOnClock = bit(*next++, 0);
+    snapshot.outputRegister.value = *next++;
+    snapshot.outputRegister.readOnClock = bit(*next++, 0);
+    snapshot.stepCounter.counter = *next++;
+    snapshot.flagsRegister.carryFlag = bit(*next, 0);
+    snapshot.flagsRegister.zeroFlag = bit(*next, 1);
+    snapshot.flagsRegister.readOnClock = bit(*next, 2);
+
+    if (snapshot.memoryAddressRegister.value > Utils::FOUR_BITS_MAX) {
+        throw std::runtime_error("Checkpoint: memory address register out of bounds " +
+                                 std::to_string(snapshot.memoryAddressRegister.value));
+    }
+
+    if (snapshot.programCounter.value > Utils::FOUR_BITS_MAX) {
+        throw std::runtime_error("Checkpoint: program counter out of bounds " +
+                                 std::to_string(snapshot.programCounter.value));
+    }
+
+    if (snapshot.stepCounter.counter > 4) {
+        throw std::runtime_error("Checkpoint: step out of bounds " + std::to_string(snapshot.stepCounter.counter));
+    }
+
+    return snapshot;
+}
+
+void Core::Checkpoint::save(const std::string &fileName, const Snapshot &snapshot) {
+    std::ofstream file(fileName, std::ios::binary);
+
+    if (!file.is_open()) {
+        throw std::runtime_error("Checkpoint: failed to open file: " + fileName);
+    }
+
+    const std::vector<uint8_t> bytes = toBytes(snapshot);
+    file.write(reinterpret_cast<const char *>(bytes.data()), bytes.size());
+
+    if (!file) {
+        throw std::runtime_error("Checkpoint: failed to write file: " + fileName);
+    }
+}
+
+Core::Snapshot Core::Checkpoint::load(const std::string &fileName) {
+    std::ifstream file(fileName, std::ios::binary);
+
+    if (!file.is_open()) {
+        throw std::runtime_error("Checkpoint: failed to open file: " + fileName);
+    }
+
+    const std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    return fromBytes(bytes);
+}
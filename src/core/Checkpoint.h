@@ -0,0 +1,48 @@
+#ifndef INC_8_BIT_COMPUTER_EMULATOR_CHECKPOINT_H
+#define INC_8_BIT_COMPUTER_EMULATOR_CHECKPOINT_H
+
+#include <string>
+#include <vector>
+
+#include "Snapshot.h"
+
+namespace Core {
+
+    /**
+     * Static class for storing a Snapshot in a binary file, so a long run can be continued later.
+     *
+     * The format is independent of the layout of Snapshot in memory:
+     *
+     * - 4 bytes: magic "8BCP"
+     * - 1 byte: format version
+     * - 1 byte: size of the state that follows
+     * - 36 bytes: the state, with the memory first and then one byte for each value in the order of Snapshot.
+     *   The flags of each part are packed as bits in one byte
+     */
+    class Checkpoint {
+
+    public:
+        static constexpr uint8_t VERSION = 1;
+        static constexpr uint8_t STATE_SIZE = 36;
+
+        Checkpoint() = delete;
+        ~Checkpoint() = delete;
+
+        /** Convert the snapshot to bytes in the checkpoint format. */
+        static std::vector<uint8_t> toBytes(const Snapshot &snapshot);
+
+        /** Convert bytes in the checkpoint format back to a snapshot. Throws exception if the format is wrong. */
+        static Snapshot fromBytes(const std::vector<uint8_t> &bytes);
+
+        /** Write the snapshot to a checkpoint file. */
+        static void save(const std::string &fileName, const Snapshot &snapshot);
+
+        /** Read a snapshot from a checkpoint file. */
+        static Snapshot load(const std::string &fileName);
+
+    private:
+        static const int HEADER_SIZE = 6;
+    };
+}
+
+#endif //INC_8_BIT_COMPUTER_EMULATOR_CHECKPOINT_H
@@ -2,6 +2,7 @@
 #include <iostream>
 #include <string>
 
+#include "Log.h"
 #include "Utils.h"
 
 #include "Clock.h"
@@ -32,7 +33,7 @@ Core::Clock::~Clock() {
 }
 
 void Core::Clock::start() {
-    std::cout << "Clock: starting clock" << std::endl;
+    Log::println("Clock: starting clock");
 
     if (halted) {
         std::cerr << "Clock: halted" << std::endl;
@@ -53,7 +54,7 @@ void Core::Clock::start() {
 
 void Core::Clock::stop() {
     running = false;
-    std::cout << "Clock: stopped" << std::endl;
+    Log::println("Clock: stopped");
 }
 
 void Core::Clock::halt() {
@@ -74,7 +75,7 @@ void Core::Clock::detach() {
 }
 
 void Core::Clock::singleStep() {
-    std::cout << "Clock: single stepping clock" << std::endl;
+    Log::println("Clock: single stepping clock");
 
     if (halted) {
         std::cerr << "Clock: halted" << std::endl;
@@ -100,10 +101,39 @@ void Core::Clock::singleStep() {
     clockThread.join();
 }
 
+unsigned long Core::Clock::runCycles(const unsigned long maxCycles) {
+    if (halted) {
+        return 0;
+    }
+
+    unsigned long cycles = 0;
+    running = true;
+
+    try {
+        while (running && cycles < maxCycles) {
+            notifyTick();
+            notifyInvertedTick();
+            cycles++;
+        }
+    } catch (...) {
+        // Make sure the clock can be used again after a failure in one of the parts
+        running = false;
+        throw;
+    }
+
+    running = false;
+
+    return cycles;
+}
+
 bool Core::Clock::isRunning() const {
     return running;
 }
 
+bool Core::Clock::isHalted() const {
+    return halted;
+}
+
 void Core::Clock::reset() {
     halted = false;
 }
@@ -208,7 +238,7 @@ void Core::Clock::clearListeners() {
 }
 
 void Core::Clock::notifyTick() const {
-    if (observer != nullptr) {
+    if (Utils::OBSERVED && observer != nullptr) {
         observer->clockTicked(true);
     }
 
@@ -218,7 +248,7 @@ void Core::Clock::notifyTick() const {
 }
 
 void Core::Clock::notifyInvertedTick() const {
-    if (observer != nullptr) {
+    if (Utils::OBSERVED && observer != nullptr) {
         observer->clockTicked(false);
     }
 
@@ -228,11 +258,19 @@ void Core::Clock::notifyInvertedTick() const {
 }
 
 void Core::Clock::notifyFrequencyChanged() const {
-    if (observer != nullptr) {
+    if (Utils::OBSERVED && observer != nullptr) {
         observer->frequencyChanged(hz);
     }
 }
 
+Core::Clock::State Core::Clock::getState() const {
+    return {halted};
+}
+
+void Core::Clock::setState(const State &state) {
+    halted = state.halted;
+}
+
 void Core::Clock::setObserver(const std::shared_ptr<ClockObserver> &newObserver) {
     observer = newObserver;
 }
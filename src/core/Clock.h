@@ -1,6 +1,7 @@
 #ifndef INC_8_BIT_COMPUTER_CLOCK_H
 #define INC_8_BIT_COMPUTER_CLOCK_H
 
+#include <memory>
 #include <thread>
 #include <vector>
 
@@ -24,6 +25,11 @@ namespace Core {
     class Clock {
 
     public:
+        /** Everything needed to put this clock back the way it was. */
+        struct State {
+            bool halted;
+        };
+
         explicit Clock(const std::shared_ptr<TimeSource> &timeSource);
         ~Clock();
 
@@ -49,9 +55,18 @@ namespace Core {
         /** Run one clock cycle synchronously and then stop. */
         void singleStep();
 
+        /**
+         * Run up to maxCycles clock cycles in the calling thread, as fast as possible without looking at the
+         * frequency or the time source. Stops early on halt(). Returns the number of clock cycles that were run.
+         */
+        unsigned long runCycles(unsigned long maxCycles);
+
         /** Whether the clock is currently running. */
         [[nodiscard]] bool isRunning() const;
 
+        /** Whether the clock has been halted by a program, and needs a reset() to run again. */
+        [[nodiscard]] bool isHalted() const;
+
         /** Reset the halted status of the clock to allow it to restart. */
         void reset();
 
@@ -70,6 +85,12 @@ namespace Core {
         /** Clear all the listeners. */
         void clearListeners();
 
+        /** Get a copy of the current state. */
+        [[nodiscard]] State getState() const;
+
+        /** Put back a state from getState(). */
+        void setState(const State &state);
+
         /** Set an optional external observer of this clock. */
         void setObserver(const std::shared_ptr<ClockObserver> &newObserver);
 
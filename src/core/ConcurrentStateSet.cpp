@@ -0,0 +1,103 @@
+#include <iostream>
+#include <thread>
+
+#include "Utils.h"
+
+#include "ConcurrentStateSet.h"
+
+Core::ConcurrentStateSet::ConcurrentStateSet(const size_t maxStates) {
+    if (Utils::debugL2()) {
+        std::cout << "ConcurrentStateSet construct" << std::endl;
+    }
+
+    if (maxStates == 0) {
+        throw std::runtime_error("ConcurrentStateSet: max states must be more than 0");
+    }
+
+    // At most half full, so a free slot is never far away
+    size_t capacity = 1;
+
+    while (capacity < maxStates * 2) {
+        capacity *= 2;
+    }
+
+    this->slots = std::make_unique<Slot[]>(capacity);
+    this->mask = capacity - 1;
+    this->maxStates = maxStates;
+    this->count = 0;
+
+    for (size_t i = 0; i < capacity; i++) {
+        slots[i].tag.store(EMPTY, std::memory_order_relaxed);
+    }
+}
+
+Core::ConcurrentStateSet::~ConcurrentStateSet() {
+    if (Utils::debugL2()) {
+        std::cout << "ConcurrentStateSet destruct" << std::endl;
+    }
+}
+
+Core::ConcurrentStateSet::Insert Core::ConcurrentStateSet::insert(const Key &key) {
+    const uint64_t keyHash = hash(key);
+    // The high bits for the tag and the low bits for the slot, with 0 and 1 reserved
+    const uint32_t keyTag = std::max<uint32_t>(keyHash >> 32, BUSY + 1);
+    size_t index = keyHash & mask;
+
+    while (true) {
+        Slot &slot = slots[index];
+        uint32_t tag = slot.tag.load(std::memory_order_acquire);
+
+        if (tag == EMPTY) {
+            // Reserve room first, so the table never gets more than half full
+            if (count.fetch_add(1, std::memory_order_relaxed) >= maxStates) {
+                count.fetch_sub(1, std::memory_order_relaxed);
+                return Insert::FULL;
+            }
+
+            if (slot.tag.compare_exchange_strong(tag, BUSY, std::memory_order_acquire)) {
+                slot.key = key;
+                slot.tag.store(keyTag, std::memory_order_release);
+                return Insert::ADDED;
+            }
+
+            // Another thread got the slot first, and it might be writing the same key
+            count.fetch_sub(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        while (tag == BUSY) {
+            std::this_thread::yield();
+            tag = slot.tag.load(std::memory_order_acquire);
+        }
+
+        if (tag == keyTag && slot.key == key) {
+            return Insert::EXISTS;
+        }
+
+        index = (index + 1) & mask;
+    }
+}
+
+size_t Core::ConcurrentStateSet::size() const {
+    return count;
+}
+
+size_t Core::ConcurrentStateSet::getMaxStates() const {
+    return maxStates;
+}
+
+uint64_t Core::ConcurrentStateSet::hash(const Key &key) {
+    // FNV-1a, with a final mix since the table index comes from the low bits
+    uint64_t value = 14695981039346656037ULL;
+
+    for (const uint8_t byte : key) {
+        value ^= byte;
+        value *= 1099511628211ULL;
+    }
+
+    value ^= value >> 29;
+    value *= 0xBF58476D1CE4E5B9ULL;
+    value ^= value >> 32;
+
+    return value;
+}
@@ -0,0 +1,62 @@
+#ifndef INC_8_BIT_COMPUTER_EMULATOR_CONCURRENTSTATESET_H
+#define INC_8_BIT_COMPUTER_EMULATOR_CONCURRENTSTATESET_H
+
+#include <array>
+#include <atomic>
+#include <memory>
+
+namespace Core {
+
+    /**
+     * A set of compact machine states that many threads can add to at the same time, without locks.
+     *
+     * Uses open addressing in a fixed size table, with linear probing. Each slot has an atomic tag that is
+     * 0 while the slot is empty, 1 while a thread is writing the key, and part of the hash of the key after that.
+     * Only keys with the same tag have to be compared. The table never grows, and states are never removed,
+     * so the slots can be claimed with a single compare and swap.
+     *
+     * Each state takes 24 bytes, plus the free slots needed to keep the probing short.
+     */
+    class ConcurrentStateSet {
+
+    public:
+        static const int KEY_SIZE = 20;
+
+        using Key = std::array<uint8_t, KEY_SIZE>;
+
+        enum class Insert {
+            ADDED, EXISTS, FULL
+        };
+
+        /** Room for at least maxStates states. */
+        explicit ConcurrentStateSet(size_t maxStates);
+        ~ConcurrentStateSet();
+
+        /** Adds the key if it's not already in the set. Safe to call from any number of threads. */
+        Insert insert(const Key &key);
+
+        /** Number of keys added so far. */
+        [[nodiscard]] size_t size() const;
+
+        /** Number of keys that fit. */
+        [[nodiscard]] size_t getMaxStates() const;
+
+    private:
+        static const uint32_t EMPTY = 0;
+        static const uint32_t BUSY = 1;
+
+        struct Slot {
+            std::atomic<uint32_t> tag;
+            Key key;
+        };
+
+        std::unique_ptr<Slot[]> slots;
+        size_t mask;
+        size_t maxStates;
+        std::atomic<size_t> count;
+
+        [[nodiscard]] static uint64_t hash(const Key &key);
+    };
+}
+
+#endif //INC_8_BIT_COMPUTER_EMULATOR_CONCURRENTSTATESET_H
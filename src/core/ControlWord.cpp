@@ -0,0 +1,33 @@
+#include <array>
+
+#include "ControlWord.h"
+
+namespace {
+    const std::array<const char *, Core::ControlWord::LINES> NAMES = {
+            "HLT", "MI", "RI", "RO", "II", "IO", "AI", "AO", "BI", "BO", "S-", "SO", "OI", "O-", "CE", "CO", "CJ", "FI"
+    };
+}
+
+std::vector<Core::ControlLine> Core::ControlWord::toLines() const {
+    std::vector<ControlLine> lines;
+
+    for (const ControlLine line : *this) {
+        lines.push_back(line);
+    }
+
+    return lines;
+}
+
+std::string Core::ControlWord::toString() const {
+    std::string text;
+
+    for (const ControlLine line : *this) {
+        text += (text.empty() ? "" : " ") + name(line);
+    }
+
+    return text;
+}
+
+std::string Core::ControlWord::name(const ControlLine line) {
+    return NAMES[static_cast<int>(line)];
+}
@@ -0,0 +1,103 @@
+#ifndef INC_8_BIT_COMPUTER_EMULATOR_CONTROLWORD_H
+#define INC_8_BIT_COMPUTER_EMULATOR_CONTROLWORD_H
+
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace Core {
+
+    /** The short name of all the different control lines. */
+    enum class ControlLine {
+        //                                       S-          O-
+        HLT, MI, RI, RO, II, IO, AI, AO, BI, BO, SM, SO, OI, OM, CE, CO, CJ, FI
+    };
+
+    /**
+     * The control lines that are enabled at the same time, with one bit for each line in the order of ControlLine.
+     *
+     * A plain 32-bit value, so it can be built for every microstep without allocating anything.
+     * Iterating gives the enabled lines in order.
+     */
+    class ControlWord {
+
+    public:
+        /** The number of control lines. */
+        static constexpr int LINES = 18;
+
+        class Iterator {
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = ControlLine;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const ControlLine *;
+            using reference = ControlLine;
+
+            constexpr explicit Iterator(const uint32_t remaining) : remaining(remaining) {}
+
+            constexpr ControlLine operator*() const {
+                int line = 0;
+
+                while ((remaining & (1u << line)) == 0) {
+                    line++;
+                }
+
+                return static_cast<ControlLine>(line);
+            }
+
+            constexpr Iterator &operator++() {
+                remaining &= remaining - 1; // Clear the lowest bit
+                return *this;
+            }
+
+            constexpr bool operator!=(const Iterator &other) const { return remaining != other.remaining; }
+
+        private:
+            uint32_t remaining;
+        };
+
+        constexpr ControlWord() : word(0) {}
+
+        constexpr ControlWord(const std::initializer_list<ControlLine> lines) : word(0) {
+            for (const ControlLine line : lines) {
+                word |= bit(line);
+            }
+        }
+
+        /** A control word from the bits of an earlier one. */
+        static constexpr ControlWord fromBits(const uint32_t bits) {
+            ControlWord controlWord;
+            controlWord.word = bits;
+            return controlWord;
+        }
+
+        [[nodiscard]] constexpr uint32_t bits() const { return word; }
+        [[nodiscard]] constexpr bool has(const ControlLine line) const { return (word & bit(line)) != 0; }
+        [[nodiscard]] constexpr bool empty() const { return word == 0; }
+
+        constexpr bool operator==(const ControlWord &other) const { return word == other.word; }
+        constexpr bool operator!=(const ControlWord &other) const { return word != other.word; }
+
+        [[nodiscard]] constexpr Iterator begin() const { return Iterator(word); }
+        [[nodiscard]] constexpr Iterator end() const { return Iterator(0); }
+
+        /** The enabled lines as a list, the way observers used to get them. */
+        [[nodiscard]] std::vector<ControlLine> toLines() const;
+
+        /** The enabled lines by name, like "MI CO", or an empty string if none. */
+        [[nodiscard]] std::string toString() const;
+
+        /** The name of a line, like on the computer, with S- for SM and O- for OM. */
+        [[nodiscard]] static std::string name(ControlLine line);
+
+    private:
+        uint32_t word;
+
+        static constexpr uint32_t bit(const ControlLine line) { return 1u << static_cast<int>(line); }
+    };
+}
+
+#endif //INC_8_BIT_COMPUTER_EMULATOR_CONTROLWORD_H
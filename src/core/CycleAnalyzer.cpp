@@ -0,0 +1,264 @@
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+#include "Disassembler.h"
+#include "Instructions.h"
+#include "Interpreter.h"
+
+#include "CycleAnalyzer.h"
+
+namespace {
+    bool isJump(const uint8_t opcode) {
+        return opcode == Core::Instructions::JMP.opcode || opcode == Core::Instructions::JC.opcode ||
+               opcode == Core::Instructions::JZ.opcode;
+    }
+
+    /** Not one of the instructions, which stops the computer like HLT, but as a failure. */
+    bool isUnknown(const uint8_t opcode) {
+        return opcode > Core::Instructions::JZ.opcode && opcode < Core::Instructions::OUT.opcode;
+    }
+
+    // In a depth first search
+    const int NOT_VISITED = 0;
+    const int VISITING = 1;
+    const int VISITED = 2;
+
+    const long CAN_NOT_HALT = -1;
+}
+
+Core::CycleAnalyzer::Analysis Core::CycleAnalyzer::analyze(const MemoryImage &image) {
+    Analysis analysis{};
+    analysis.blockAt.fill(-1);
+
+    std::array<bool, 16> executed{};
+    std::array<bool, 16> leaders{};
+    std::vector<uint8_t> pending = {0};
+    leaders[0] = true;
+
+    while (!pending.empty()) {
+        const uint8_t address = pending.back();
+        pending.pop_back();
+
+        if (executed[address]) {
+            continue;
+        }
+
+        executed[address] = true;
+
+        const uint8_t opcode = image[address] >> 4;
+        const uint8_t operand = image[address] & 0x0F;
+        const uint8_t next = (address + 1) % 16;
+        const bool halts = opcode == Instructions::HLT.opcode || isUnknown(opcode);
+
+        analysis.cycles[address] = halts ? Interpreter::HALT_CYCLES : Interpreter::INSTRUCTION_CYCLES;
+
+        if (isJump(opcode)) {
+            leaders[operand] = true;
+            pending.push_back(operand);
+        }
+
+        if (opcode == Instructions::JC.opcode || opcode == Instructions::JZ.opcode) {
+            leaders[next] = true;
+        }
+
+        if (!halts && opcode != Instructions::JMP.opcode) {
+            pending.push_back(next);
+        }
+
+        if (opcode == Instructions::STA.opcode) {
+            analysis.selfModifying = analysis.selfModifying || executed[operand];
+        }
+    }
+
+    // The stores could come before the code they store into is found
+    for (uint8_t address = 0; address < 16; address++) {
+        if (executed[address] && image[address] >> 4 == Instructions::STA.opcode) {
+            analysis.selfModifying = analysis.selfModifying || executed[image[address] & 0x0F];
+        }
+    }
+
+    for (uint8_t address = 0; address < 16; address++) {
+        leaders[address] = leaders[address] && executed[address];
+    }
+
+    findBlocks(image, analysis, leaders);
+    findBestCase(analysis);
+    findWorstCase(analysis);
+
+    return analysis;
+}
+
+std::string Core::CycleAnalyzer::toListing(const MemoryImage &image, const Analysis &analysis) {
+    std::stringstream listing;
+
+    for (uint8_t address = 0; address < 16; address++) {
+        const int blockIndex = analysis.blockAt[address];
+
+        if (blockIndex >= 0 && analysis.blocks[blockIndex].first == address) {
+            const Block &block = analysis.blocks[blockIndex];
+            listing << "; Block " << blockIndex << " at " << (int) block.first << "-" << (int) block.last << ": "
+                    << block.cycles << " cycles, ";
+
+            if (block.halts) {
+                listing << "halts";
+            } else if (block.successors.empty()) {
+                listing << "fails";
+            } else {
+                listing << "next";
+
+                for (const size_t successor : block.successors) {
+                    listing << " " << successor;
+                }
+            }
+
+            listing << "\n";
+        }
+
+        if (blockIndex >= 0) {
+            listing << std::setw(2) << (int) address << ": " << std::left << std::setw(8)
+                    << Disassembler::disassemble(image[address]) << std::right << " ; " << analysis.cycles[address]
+                    << " cycles\n";
+        } else if (image[address] != 0) {
+            listing << std::setw(2) << (int) address << ": DB " << (int) image[address] << "\n";
+        }
+    }
+
+    if (analysis.selfModifying) {
+        listing << "; Stores into its own code, so the timing may differ when it runs\n";
+    }
+
+    if (analysis.canHalt) {
+        listing << "; Best case: " << analysis.bestCase << " cycles to HLT\n";
+    } else {
+        listing << "; Best case: never halts\n";
+    }
+
+    if (!analysis.bounded) {
+        listing << "; Worst case: unbounded, the program can go around a loop\n";
+    } else if (analysis.canHalt) {
+        listing << "; Worst case: " << analysis.worstCase << " cycles to HLT\n";
+    } else {
+        listing << "; Worst case: never halts\n";
+    }
+
+    return listing.str();
+}
+
+bool Core::CycleAnalyzer::endsBlock(const uint8_t instruction) {
+    const uint8_t opcode = instruction >> 4;
+
+    return isJump(opcode) || isUnknown(opcode) || opcode == Instructions::HLT.opcode;
+}
+
+void Core::CycleAnalyzer::findBlocks(const MemoryImage &image, Analysis &analysis,
+                                     const std::array<bool, 16> &leaders) {
+    // Address 0 is always a leader, so blocks never wrap around, and the first block is where the program starts
+    for (uint8_t first = 0; first < 16; first++) {
+        if (!leaders[first]) {
+            continue;
+        }
+
+        Block block = {first, first, 0, {}, false};
+        uint8_t address = first;
+
+        while (true) {
+            analysis.blockAt[address] = analysis.blocks.size();
+            block.cycles += analysis.cycles[address];
+
+            if (endsBlock(image[address]) || leaders[(address + 1) % 16]) {
+                break;
+            }
+
+            address++;
+        }
+
+        block.last = address;
+        analysis.blocks.push_back(block);
+    }
+
+    for (Block &block : analysis.blocks) {
+        const uint8_t opcode = image[block.last] >> 4;
+        const uint8_t operand = image[block.last] & 0x0F;
+        const int next = analysis.blockAt[(block.last + 1) % 16];
+        const int target = analysis.blockAt[operand];
+
+        if (opcode == Instructions::HLT.opcode) {
+            block.halts = true;
+        } else if (opcode == Instructions::JMP.opcode) {
+            block.successors.push_back(target);
+        } else if (opcode == Instructions::JC.opcode || opcode == Instructions::JZ.opcode) {
+            block.successors.push_back(next);
+
+            if (target != next) {
+                block.successors.push_back(target);
+            }
+        } else if (!isUnknown(opcode)) {
+            block.successors.push_back(next);
+        }
+    }
+}
+
+void Core::CycleAnalyzer::findBestCase(Analysis &analysis) {
+    // Bellman-Ford, since there are at most 16 blocks
+    std::vector<unsigned long> fewest(analysis.blocks.size(), std::numeric_limits<unsigned long>::max());
+    fewest[0] = analysis.blocks[0].cycles;
+
+    for (size_t round = 0; round < analysis.blocks.size(); round++) {
+        for (size_t index = 0; index < analysis.blocks.size(); index++) {
+            if (fewest[index] == std::numeric_limits<unsigned long>::max()) {
+                continue;
+            }
+
+            for (const size_t successor : analysis.blocks[index].successors) {
+                fewest[successor] = std::min(fewest[successor], fewest[index] + analysis.blocks[successor].cycles);
+            }
+        }
+    }
+
+    analysis.canHalt = false;
+    analysis.bestCase = 0;
+
+    for (size_t index = 0; index < analysis.blocks.size(); index++) {
+        if (analysis.blocks[index].halts && fewest[index] != std::numeric_limits<unsigned long>::max() &&
+            (!analysis.canHalt || fewest[index] < analysis.bestCase)) {
+            analysis.canHalt = true;
+            analysis.bestCase = fewest[index];
+        }
+    }
+}
+
+void Core::CycleAnalyzer::findWorstCase(Analysis &analysis) {
+    std::vector<int> visits(analysis.blocks.size(), NOT_VISITED);
+    std::vector<long> longest(analysis.blocks.size(), CAN_NOT_HALT);
+    bool loops = false;
+
+    const long worstCase = longestPath(analysis, 0, visits, longest, loops);
+
+    analysis.bounded = !loops;
+    analysis.worstCase = loops || worstCase == CAN_NOT_HALT ? 0 : worstCase;
+}
+
+long Core::CycleAnalyzer::longestPath(const Analysis &analysis, const size_t block, std::vector<int> &visits,
+                                      std::vector<long> &longest, bool &loops) {
+    if (visits[block] == VISITING) {
+        loops = true;
+        return CAN_NOT_HALT;
+    }
+
+    if (visits[block] == VISITED) {
+        return longest[block];
+    }
+
+    visits[block] = VISITING;
+    long rest = analysis.blocks[block].halts ? 0 : CAN_NOT_HALT;
+
+    for (const size_t successor : analysis.blocks[block].successors) {
+        rest = std::max(rest, longestPath(analysis, successor, visits, longest, loops));
+    }
+
+    visits[block] = VISITED;
+    longest[block] = rest == CAN_NOT_HALT ? CAN_NOT_HALT : rest + (long) analysis.blocks[block].cycles;
+
+    return longest[block];
+}
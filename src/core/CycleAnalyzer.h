@@ -0,0 +1,72 @@
+#ifndef INC_8_BIT_COMPUTER_EMULATOR_CYCLEANALYZER_H
+#define INC_8_BIT_COMPUTER_EMULATOR_CYCLEANALYZER_H
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "MemoryImage.h"
+
+namespace Core {
+
+    /**
+     * Static class for finding how many clock cycles a program takes, without running it. The microcode has
+     * a fixed timing, with 5 cycles for every instruction, and 2 for HLT, so only the jumps are unknown.
+     *
+     * The program is split into basic blocks, which are straight runs of instructions that are only entered at
+     * the top, and only left at the bottom. The blocks and the jumps between them make up the control flow graph.
+     * Both ways of JC and JZ are possible, since the flags are not known without running it.
+     *
+     * Programs that store into their own code may not follow the graph, since it's built from the code as loaded.
+     */
+    class CycleAnalyzer {
+
+    public:
+        CycleAnalyzer() = delete;
+        ~CycleAnalyzer() = delete;
+
+        struct Block {
+            uint8_t first;
+            uint8_t last;
+            unsigned long cycles;
+            /** Indexes of the blocks that can come next. */
+            std::vector<size_t> successors;
+            bool halts;
+        };
+
+        struct Analysis {
+            /** Cycles for the instruction at each address, or 0 where it's never executed. */
+            std::array<unsigned long, 16> cycles;
+            /** Which block each address is in, or -1 where it's never executed. */
+            std::array<int, 16> blockAt;
+            /** The first block is where the program starts. */
+            std::vector<Block> blocks;
+            /** Whether any path gets to HLT. */
+            bool canHalt;
+            /** Fewest cycles to HLT, if it can halt. */
+            unsigned long bestCase;
+            /** Whether the program always stops, with no way to go around a loop. */
+            bool bounded;
+            /** Most cycles to HLT, if bounded and it can halt. */
+            unsigned long worstCase;
+            /** Whether the program stores into addresses that are executed as code. */
+            bool selfModifying;
+        };
+
+        /** Analyze the program starting at address 0. */
+        static Analysis analyze(const MemoryImage &image);
+
+        /** The program as assembly, with the cycles of each instruction and block, and the best and worst case. */
+        static std::string toListing(const MemoryImage &image, const Analysis &analysis);
+
+    private:
+        [[nodiscard]] static bool endsBlock(uint8_t instruction);
+        static void findBlocks(const MemoryImage &image, Analysis &analysis, const std::array<bool, 16> &leaders);
+        static void findBestCase(Analysis &analysis);
+        static void findWorstCase(Analysis &analysis);
+        [[nodiscard]] static long longestPath(const Analysis &analysis, size_t block, std::vector<int> &visits,
+                                              std::vector<long> &longest, bool &loops);
+    };
+}
+
+#endif //INC_8_BIT_COMPUTER_EMULATOR_CYCLEANALYZER_H
@@ -1,10 +1,42 @@
 #include <iostream>
 
-#include "Assembler.h"
+#include "Checkpoint.h"
+#include "Log.h"
 #include "Utils.h"
 
 #include "Emulator.h"
 
+namespace {
+    /** The headless core never notifies observers, so anything relying on one would quietly get nothing. */
+    void requireObserved(const bool hasObserver) {
+        if (!Core::Utils::OBSERVED && hasObserver) {
+            throw std::runtime_error("Emulator: observers are not available in the headless core");
+        }
+    }
+}
+
+/** Assembles the watched file when it changes, and swaps in the new program between instructions. */
+class Core::Emulator::HotReloadListener: public FileListener, public ClockListener {
+
+public:
+    explicit HotReloadListener(Emulator *emulator) {
+        this->emulator = emulator;
+    }
+
+    void fileChanged() override {
+        emulator->assembleChangedFile();
+    }
+
+    void clockTicked() override {} // Not implemented
+
+    void invertedClockTicked() override {
+        emulator->swapAtInstructionBoundary();
+    }
+
+private:
+    Emulator *emulator;
+};
+
 Core::Emulator::Emulator() {
     if (Utils::debugL2()) {
         std::cout << "Emulator construct" << std::endl;
@@ -27,6 +59,14 @@ Core::Emulator::Emulator() {
                                                               bRegister, arithmeticLogicUnit, outputRegister,
                                                               flagsRegister, clock);
     stepCounter = std::make_shared<StepCounter>(instructionDecoder);
+    loadedSnapshot = {};
+    observers = std::make_shared<EventDispatcher>();
+    loaded = false;
+    notifyEveryWrite = false;
+    hotReload = HotReload::OFF;
+    hotReloadImage = {};
+    hotReloadPending = false;
+    hotReloadLatency = 0;
 
     // Cyclic dependency - also, setting it here to reuse the shared pointers
     aRegister->setRegisterListener(arithmeticLogicUnit);
@@ -50,6 +90,9 @@ Core::Emulator::~Emulator() {
         std::cout << "Emulator destruct" << std::endl;
     }
 
+    // Before the parts it uses are gone
+    fileWatcher.reset();
+
     // Fix memory not being freed automatically, probably due to cyclic reference
     aRegister->setRegisterListener(nullptr);
     bRegister->setRegisterListener(nullptr);
@@ -60,12 +103,170 @@ Core::Emulator::~Emulator() {
 void Core::Emulator::load(const std::string &newFileName) {
     fileName = newFileName;
     initializeProgram();
+
+    // Watch the new file instead
+    if (hotReload != HotReload::OFF) {
+        setHotReload(hotReload);
+    }
+}
+
+void Core::Emulator::load(const std::vector<Assembler::Instruction> &newInstructions) {
+    stopHotReload();
+    fileName.clear();
+    instructions = newInstructions;
+    loaded = false;
+
+    reset();
+
+    if (!programMemory()) {
+        throw std::runtime_error("Emulator: no instructions loaded. Aborting");
+    }
+
+    loadedSnapshot = snapshot();
+    loaded = true;
+}
+
+void Core::Emulator::load(const MemoryImage &image) {
+    stopHotReload();
+    fileName.clear();
+    instructions.clear();
+    loaded = false;
+
+    reset();
+    randomAccessMemory->program(image);
+
+    loadedSnapshot = snapshot();
+    loaded = true;
+}
+
+void Core::Emulator::loadSource(const std::string_view source) {
+    auto assembler = std::make_unique<Assembler>();
+    const Assembler::Result result = assembler->assemble(source);
+
+    if (!result.ok()) {
+        const Assembler::Error &error = result.errors.front();
+        throw std::runtime_error("Emulator: line " + std::to_string(error.line) + " column " +
+                                 std::to_string(error.column) + ": " + error.message);
+    }
+
+    load(result.instructions);
 }
 
 void Core::Emulator::reload() {
+    if (!loaded) {
+        initializeProgram();
+        return;
+    }
+
+    if (Utils::debugL1()) {
+        std::cout << "Emulator: reload from cache" << std::endl;
+    }
+
+    // Only the memory of the cache changes, the rest is the same for any program
+    if (hotReloadPending) {
+        applyHotReload(false);
+    }
+
+    restore(loadedSnapshot);
+    printValues();
+}
+
+void Core::Emulator::reloadFile() {
     initializeProgram();
 }
 
+void Core::Emulator::setHotReload(const HotReload mode) {
+    stopHotReload();
+    hotReload = mode;
+
+    if (mode == HotReload::OFF) {
+        return;
+    }
+
+    if (fileName.empty()) {
+        throw std::runtime_error("Emulator: hot reload needs a program loaded from a file");
+    }
+
+    // Only added once, and does nothing unless there is a program waiting
+    if (hotReloadListener == nullptr) {
+        hotReloadListener = std::make_shared<HotReloadListener>(this);
+        clock->addListener(hotReloadListener);
+    }
+
+    watchedFileName = fileName;
+    fileWatcher = std::make_unique<FileWatcher>(watchedFileName, hotReloadListener);
+    fileWatcher->start();
+}
+
+bool Core::Emulator::isHotReloadPending() const {
+    return hotReloadPending;
+}
+
+std::chrono::microseconds Core::Emulator::getHotReloadLatency() const {
+    return std::chrono::microseconds(hotReloadLatency);
+}
+
+Core::Snapshot Core::Emulator::snapshot() const {
+    return {
+            clock->getState(),
+            bus->getState(),
+            aRegister->getState(),
+            bRegister->getState(),
+            arithmeticLogicUnit->getState(),
+            memoryAddressRegister->getState(),
+            programCounter->getState(),
+            randomAccessMemory->getState(),
+            instructionRegister->getState(),
+            outputRegister->getState(),
+            stepCounter->getState(),
+            flagsRegister->getState()
+    };
+}
+
+void Core::Emulator::restore(const Snapshot &snapshot) {
+    if (Utils::debugL1()) {
+        std::cout << "Emulator: restore snapshot" << std::endl;
+    }
+
+    // Same order as reset(). The ALU comes after the registers, so its own state is the one that is kept
+    clock->setState(snapshot.clock);
+    bus->setState(snapshot.bus);
+    aRegister->setState(snapshot.aRegister);
+    bRegister->setState(snapshot.bRegister);
+    arithmeticLogicUnit->setState(snapshot.arithmeticLogicUnit);
+    memoryAddressRegister->setState(snapshot.memoryAddressRegister);
+    randomAccessMemory->setState(snapshot.randomAccessMemory);
+    programCounter->setState(snapshot.programCounter);
+    instructionRegister->setState(snapshot.instructionRegister);
+    outputRegister->setState(snapshot.outputRegister);
+    stepCounter->setState(snapshot.stepCounter);
+    flagsRegister->setState(snapshot.flagsRegister);
+
+    // The control lines are not part of the state. The decoder enables the same lines again for the restored step,
+    // which changes nothing since the snapshot was taken after they were enabled, but it notifies the observer
+    std::static_pointer_cast<StepListener>(instructionDecoder)->stepReady(snapshot.stepCounter.counter);
+}
+
+std::vector<Core::Fork> Core::Emulator::fork(const size_t children) const {
+    return std::vector<Fork>(children, Fork(snapshot()));
+}
+
+Core::Fork Core::Emulator::fork(const Fork &sibling) const {
+    return sibling.withState(snapshot());
+}
+
+void Core::Emulator::restore(const Fork &fork) {
+    restore(fork.toSnapshot());
+}
+
+void Core::Emulator::saveCheckpoint(const std::string &checkpointFileName) const {
+    Checkpoint::save(checkpointFileName, snapshot());
+}
+
+void Core::Emulator::loadCheckpoint(const std::string &checkpointFileName) {
+    restore(Checkpoint::load(checkpointFileName));
+}
+
 void Core::Emulator::startAsynchronous() {
     if (Utils::debugL1()) {
         std::cout << "Emulator: start asynchronous" << std::endl;
@@ -82,6 +283,7 @@ void Core::Emulator::startSynchronous() {
 
     clock->start();
     clock->join();
+    flushEvents();
 }
 
 void Core::Emulator::initializeProgram() {
@@ -89,12 +291,26 @@ void Core::Emulator::initializeProgram() {
         std::cout << "Emulator: initialize start" << std::endl;
     }
 
+    loaded = false;
+    hotReloadPending = false; // Reads the file anyway
     reset();
 
-    if (!programMemory()) {
-        throw std::runtime_error("Emulator: no instructions loaded. Aborting");
+    if (MachineImage::isImageFile(fileName)) {
+        programImage(MachineImage::load(fileName));
+    } else {
+        if (!fileName.empty()) {
+            assembleFile();
+        }
+
+        if (!programMemory()) {
+            throw std::runtime_error("Emulator: no instructions loaded. Aborting");
+        }
     }
 
+    // Everything reload() needs, so it doesn't have to assemble and program the memory again
+    loadedSnapshot = snapshot();
+    loaded = true;
+
     printValues();
 
     if (Utils::debugL1()) {
@@ -102,12 +318,28 @@ void Core::Emulator::initializeProgram() {
     }
 }
 
+unsigned long Core::Emulator::runSynchronous(const unsigned long maxCycles) {
+    if (Utils::debugL1()) {
+        std::cout << "Emulator: run synchronous for at most " << maxCycles << " cycles" << std::endl;
+    }
+
+    const unsigned long cycles = clock->runCycles(maxCycles);
+    flushEvents();
+
+    return cycles;
+}
+
 bool Core::Emulator::isRunning() {
     return clock->isRunning();
 }
 
+bool Core::Emulator::isHalted() {
+    return clock->isHalted();
+}
+
 void Core::Emulator::singleStep() {
     clock->singleStep();
+    flushEvents();
 }
 
 void Core::Emulator::stop() {
@@ -126,29 +358,114 @@ void Core::Emulator::decreaseFrequency() {
     clock->decreaseFrequency();
 }
 
-bool Core::Emulator::programMemory() {
-    std::cout << "Emulator: program memory" << std::endl;
-
+void Core::Emulator::assembleFile() {
     auto assembler = std::make_unique<Assembler>();
-    const std::vector<Assembler::Instruction> instructions = assembler->loadInstructions(fileName);
+    instructions = assembler->loadInstructions(fileName);
+}
 
-    if (instructions.empty()) {
-        return false;
+void Core::Emulator::assembleChangedFile() {
+    const auto changeTime = std::chrono::steady_clock::now();
+    MemoryImage image;
+
+    // Keeps running the old program if the new one is broken
+    try {
+        if (MachineImage::isImageFile(watchedFileName)) {
+            image = MachineImage::load(watchedFileName).memory;
+        } else {
+            const std::vector<Assembler::Instruction> changedInstructions = Assembler().loadInstructions(
+                    watchedFileName);
+
+            if (changedInstructions.empty()) {
+                throw std::runtime_error("Emulator: no instructions in file: " + watchedFileName);
+            }
+
+            image = Assembler::toImage(changedInstructions);
+        }
+    } catch (const std::runtime_error &e) {
+        std::cerr << "Emulator: hot reload failed: " << e.what() << std::endl;
+        return;
     }
 
-    for (auto instruction : instructions) {
-        memoryAddressRegister->program(instruction.address);
-        randomAccessMemory->program(instruction.opcode, instruction.operand);
+    std::lock_guard<std::mutex> lock(hotReloadMutex);
+    hotReloadImage = image;
+    hotReloadChangeTime = changeTime;
+    hotReloadPending = true;
+}
+
+void Core::Emulator::stopHotReload() {
+    // Stops the watcher thread first, so nothing can be pending again afterwards
+    fileWatcher.reset();
+
+    std::lock_guard<std::mutex> lock(hotReloadMutex);
+    hotReloadPending = false;
+}
+
+void Core::Emulator::swapAtInstructionBoundary() {
+    // Called on the clock thread after every falling edge, so the atomic check must come first
+    if (!hotReloadPending || hotReload != HotReload::INSTRUCTION) {
+        return;
+    }
+
+    // The step counter was just set to fetch the next instruction, so that comes from the new program
+    if (stepCounter->getState().counter == 0) {
+        applyHotReload(true);
     }
+}
+
+void Core::Emulator::applyHotReload(const bool programMemory) {
+    std::lock_guard<std::mutex> lock(hotReloadMutex);
+
+    if (programMemory) {
+        randomAccessMemory->program(hotReloadImage);
+    }
+
+    // Also what reload() goes back to
+    loadedSnapshot.randomAccessMemory.memory = hotReloadImage;
+    hotReloadPending = false;
 
-    // Reset pointer to address 0 before continuing
-    memoryAddressRegister->program(0);
+    const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - hotReloadChangeTime);
+    hotReloadLatency = latency.count();
+
+    Log::printf("Emulator: hot reload running after %lld us\n", (long long) latency.count());
+}
+
+void Core::Emulator::programImage(const MachineImage::Program &program) {
+    Log::println("Emulator: program image");
+
+    // Copy everything in one go, instead of programming the memory one byte at a time
+    Snapshot state = snapshot();
+    state.randomAccessMemory.memory = program.memory;
+    state.programCounter.value = program.entry.programCounter;
+    state.aRegister.value = program.entry.aRegister;
+    state.bRegister.value = program.entry.bRegister;
+
+    instructions.clear();
+    restore(state);
+
+    // The sum in the arithmetic logic unit follows the registers
+    std::static_pointer_cast<RegisterListener>(arithmeticLogicUnit)->registerValueChanged(program.entry.bRegister);
+}
+
+bool Core::Emulator::programMemory() {
+    Log::println("Emulator: program memory");
+
+    if (instructions.empty()) {
+        return false;
+    }
+
+    // All at once instead of one address at a time through the memory address register, which is still at 0
+    randomAccessMemory->program(Assembler::toImage(instructions));
 
     return true;
 }
 
 void Core::Emulator::printValues() {
-    std::cout << "Emulator: print current values" << std::endl;
+    if (Log::isQuiet()) {
+        return;
+    }
+
+    Log::println("Emulator: print current values");
 
     bus->print();
     aRegister->print();
@@ -164,7 +481,7 @@ void Core::Emulator::printValues() {
 }
 
 void Core::Emulator::reset() {
-    std::cout << "Emulator: reset" << std::endl;
+    Log::println("Emulator: reset");
 
     clock->reset();
     bus->reset();
@@ -181,53 +498,241 @@ void Core::Emulator::reset() {
 }
 
 void Core::Emulator::setClockObserver(const std::shared_ptr<ClockObserver> &observer) {
+    requireObserved(observer != nullptr);
+
     clock->setObserver(observer);
 }
 
+void Core::Emulator::addClockListener(const std::shared_ptr<ClockListener> &listener) {
+    clock->addListener(listener);
+}
+
 void Core::Emulator::setBusObserver(const std::shared_ptr<ValueObserver> &observer) {
-    bus->setObserver(observer);
+    requireObserved(observer != nullptr);
+
+    observers->setValueObserver(Event::Component::BUS, observer);
+    connectObservers();
 }
 
 void Core::Emulator::setARegisterObserver(const std::shared_ptr<ValueObserver> &observer) {
-    aRegister->setObserver(observer);
+    requireObserved(observer != nullptr);
+
+    observers->setValueObserver(Event::Component::A_REGISTER, observer);
+    connectObservers();
 }
 
 void Core::Emulator::setBRegisterObserver(const std::shared_ptr<ValueObserver> &observer) {
-    bRegister->setObserver(observer);
+    requireObserved(observer != nullptr);
+
+    observers->setValueObserver(Event::Component::B_REGISTER, observer);
+    connectObservers();
 }
 
 void Core::Emulator::setArithmeticLogicUnitObserver(const std::shared_ptr<ArithmeticLogicUnitObserver> &observer) {
-    arithmeticLogicUnit->setObserver(observer);
+    requireObserved(observer != nullptr);
+
+    observers->setArithmeticLogicUnitObserver(observer);
+    connectObservers();
+}
+
+void Core::Emulator::setArithmeticLogicUnitEager(const bool eager) {
+    arithmeticLogicUnit->setEager(eager);
 }
 
 void Core::Emulator::setMemoryAddressRegisterObserver(const std::shared_ptr<ValueObserver> &observer) {
-    memoryAddressRegister->setObserver(observer);
+    requireObserved(observer != nullptr);
+
+    observers->setValueObserver(Event::Component::MEMORY_ADDRESS_REGISTER, observer);
+    connectObservers();
 }
 
 void Core::Emulator::setProgramCounterObserver(const std::shared_ptr<ValueObserver> &observer) {
-    programCounter->setObserver(observer);
+    requireObserved(observer != nullptr);
+
+    observers->setValueObserver(Event::Component::PROGRAM_COUNTER, observer);
+    connectObservers();
 }
 
-void Core::Emulator::setRandomAccessMemoryObserver(const std::shared_ptr<ValueObserver> &observer) {
-    randomAccessMemory->setObserver(observer);
+void Core::Emulator::setRandomAccessMemoryObserver(const std::shared_ptr<RandomAccessMemoryObserver> &observer) {
+    requireObserved(observer != nullptr);
+
+    observers->setRandomAccessMemoryObserver(observer);
+    connectObservers();
 }
 
 void Core::Emulator::setInstructionRegisterObserver(const std::shared_ptr<ValueObserver> &observer) {
-    instructionRegister->setObserver(observer);
+    requireObserved(observer != nullptr);
+
+    observers->setValueObserver(Event::Component::INSTRUCTION_REGISTER, observer);
+    connectObservers();
 }
 
 void Core::Emulator::setOutputRegisterObserver(const std::shared_ptr<ValueObserver> &observer) {
-    outputRegister->setObserver(observer);
+    requireObserved(observer != nullptr);
+
+    observers->setValueObserver(Event::Component::OUTPUT_REGISTER, observer);
+    connectObservers();
 }
 
 void Core::Emulator::setStepCounterObserver(const std::shared_ptr<ValueObserver> &observer) {
-    stepCounter->setObserver(observer);
+    requireObserved(observer != nullptr);
+
+    observers->setValueObserver(Event::Component::STEP_COUNTER, observer);
+    connectObservers();
 }
 
 void Core::Emulator::setInstructionDecoderObserver(const std::shared_ptr<InstructionDecoderObserver> &observer) {
-    instructionDecoder->setObserver(observer);
+    requireObserved(observer != nullptr);
+
+    observers->setInstructionDecoderObserver(observer);
+    connectObservers();
 }
 
 void Core::Emulator::setFlagsRegisterObserver(const std::shared_ptr<FlagsRegisterObserver> &observer) {
-    flagsRegister->setObserver(observer);
+    requireObserved(observer != nullptr);
+
+    observers->setFlagsRegisterObserver(observer);
+    connectObservers();
+}
+
+void Core::Emulator::setNotifyEveryWrite(const bool everyWrite) {
+    notifyEveryWrite = everyWrite;
+
+    bus->setNotifyEveryWrite(everyWrite);
+    aRegister->setNotifyEveryWrite(everyWrite);
+    bRegister->setNotifyEveryWrite(everyWrite);
+    arithmeticLogicUnit->setNotifyEveryWrite(everyWrite);
+    memoryAddressRegister->setNotifyEveryWrite(everyWrite);
+    programCounter->setNotifyEveryWrite(everyWrite);
+    randomAccessMemory->setNotifyEveryWrite(everyWrite);
+    instructionRegister->setNotifyEveryWrite(everyWrite);
+    outputRegister->setNotifyEveryWrite(everyWrite);
+    stepCounter->setNotifyEveryWrite(everyWrite);
+    flagsRegister->setNotifyEveryWrite(everyWrite);
+
+    if (eventRecorder != nullptr) {
+        eventRecorder->setEveryWrite(everyWrite);
+    }
+}
+
+Core::ChangeFilter::Statistics Core::Emulator::getNotificationStatistics() const {
+    const ChangeFilter::Statistics components[] = {
+            bus->getNotificationStatistics(),
+            aRegister->getNotificationStatistics(),
+            bRegister->getNotificationStatistics(),
+            arithmeticLogicUnit->getNotificationStatistics(),
+            memoryAddressRegister->getNotificationStatistics(),
+            programCounter->getNotificationStatistics(),
+            randomAccessMemory->getNotificationStatistics(),
+            instructionRegister->getNotificationStatistics(),
+            outputRegister->getNotificationStatistics(),
+            stepCounter->getNotificationStatistics(),
+            flagsRegister->getNotificationStatistics()
+    };
+
+    ChangeFilter::Statistics statistics;
+
+    for (const ChangeFilter::Statistics &component : components) {
+        statistics.passed += component.passed;
+        statistics.skipped += component.skipped;
+    }
+
+    return statistics;
+}
+
+void Core::Emulator::setEventObserver(const std::shared_ptr<EventObserver> &observer, const unsigned long flushCycles) {
+    requireObserved(observer != nullptr);
+
+    // Only added once, and does nothing while there is no observer
+    if (eventRecorder == nullptr) {
+        eventRecorder = std::make_shared<EventRecorder>(clock);
+        eventRecorder->setEveryWrite(notifyEveryWrite);
+        clock->addListener(eventRecorder);
+    }
+
+    eventRecorder->setObserver(observer, flushCycles);
+
+    // Where the components are now, so the first events have the right old values
+    const Snapshot current = snapshot();
+    const RandomAccessMemory::State &memory = current.randomAccessMemory;
+    eventRecorder->setValue(Event::Component::BUS, current.bus.value);
+    eventRecorder->setValue(Event::Component::A_REGISTER, current.aRegister.value);
+    eventRecorder->setValue(Event::Component::B_REGISTER, current.bRegister.value);
+    eventRecorder->setValue(Event::Component::ARITHMETIC_LOGIC_UNIT,
+                            Event::pack(current.arithmeticLogicUnit.value, current.arithmeticLogicUnit.carry,
+                                        current.arithmeticLogicUnit.zero));
+    eventRecorder->setValue(Event::Component::MEMORY_ADDRESS_REGISTER, current.memoryAddressRegister.value);
+    eventRecorder->setValue(Event::Component::PROGRAM_COUNTER, current.programCounter.value);
+    eventRecorder->setValue(Event::Component::RANDOM_ACCESS_MEMORY,
+                            Event::packMemory(memory.address, memory.memory[memory.address]));
+    eventRecorder->setValue(Event::Component::INSTRUCTION_REGISTER, current.instructionRegister.value);
+    eventRecorder->setValue(Event::Component::OUTPUT_REGISTER, current.outputRegister.value);
+    eventRecorder->setValue(Event::Component::STEP_COUNTER, current.stepCounter.counter);
+    eventRecorder->setValue(Event::Component::FLAGS_REGISTER,
+                            Event::pack(current.flagsRegister.carryFlag, current.flagsRegister.zeroFlag));
+
+    connectObservers();
+}
+
+void Core::Emulator::flushEvents() {
+    if (eventRecorder != nullptr) {
+        eventRecorder->flush();
+    }
+}
+
+void Core::Emulator::setOutputSink(const std::shared_ptr<OutputSink> &sink, const OutputStream::Overflow overflow) {
+    // Only added once, and only counts cycles while there is no sink
+    if (outputStream == nullptr) {
+        outputStream = std::make_shared<OutputStream>();
+        clock->addListener(outputStream);
+    }
+
+    outputStream->setSink(sink, overflow);
+    outputRegister->setOutputStream(outputStream->isStreaming() ? outputStream : nullptr);
+}
+
+void Core::Emulator::flushOutputs() {
+    if (outputStream != nullptr) {
+        outputStream->flush();
+    }
+}
+
+unsigned long Core::Emulator::getDroppedOutputs() const {
+    return outputStream == nullptr ? 0 : outputStream->getDropped();
+}
+
+void Core::Emulator::connectObservers() {
+    if (eventRecorder == nullptr || !eventRecorder->isRecording()) {
+        bus->setObserver(observers->getValueObserver(Event::Component::BUS));
+        aRegister->setObserver(observers->getValueObserver(Event::Component::A_REGISTER));
+        bRegister->setObserver(observers->getValueObserver(Event::Component::B_REGISTER));
+        arithmeticLogicUnit->setObserver(observers->getArithmeticLogicUnitObserver());
+        memoryAddressRegister->setObserver(observers->getValueObserver(Event::Component::MEMORY_ADDRESS_REGISTER));
+        programCounter->setObserver(observers->getValueObserver(Event::Component::PROGRAM_COUNTER));
+        randomAccessMemory->setObserver(observers->getRandomAccessMemoryObserver());
+        instructionRegister->setObserver(observers->getValueObserver(Event::Component::INSTRUCTION_REGISTER));
+        outputRegister->setObserver(observers->getValueObserver(Event::Component::OUTPUT_REGISTER));
+        stepCounter->setObserver(observers->getValueObserver(Event::Component::STEP_COUNTER));
+        instructionDecoder->setObserver(observers->getInstructionDecoderObserver());
+        flagsRegister->setObserver(observers->getFlagsRegisterObserver());
+        return;
+    }
+
+    // The taps record the changes for the event observer, and pass them on to the observers of the components
+    const auto tap = [this](const Event::Component component) {
+        return eventRecorder->tapValue(component, observers->getValueObserver(component));
+    };
+
+    bus->setObserver(tap(Event::Component::BUS));
+    aRegister->setObserver(tap(Event::Component::A_REGISTER));
+    bRegister->setObserver(tap(Event::Component::B_REGISTER));
+    arithmeticLogicUnit->setObserver(eventRecorder->tapArithmeticLogicUnit(observers->getArithmeticLogicUnitObserver()));
+    memoryAddressRegister->setObserver(tap(Event::Component::MEMORY_ADDRESS_REGISTER));
+    programCounter->setObserver(tap(Event::Component::PROGRAM_COUNTER));
+    randomAccessMemory->setObserver(eventRecorder->tapRandomAccessMemory(observers->getRandomAccessMemoryObserver()));
+    instructionRegister->setObserver(tap(Event::Component::INSTRUCTION_REGISTER));
+    outputRegister->setObserver(tap(Event::Component::OUTPUT_REGISTER));
+    stepCounter->setObserver(tap(Event::Component::STEP_COUNTER));
+    instructionDecoder->setObserver(eventRecorder->tapInstructionDecoder(observers->getInstructionDecoderObserver()));
+    flagsRegister->setObserver(eventRecorder->tapFlagsRegister(observers->getFlagsRegisterObserver()));
 }
@@ -1,19 +1,31 @@
 #ifndef INC_8_BIT_COMPUTER_EMULATOR_H
 #define INC_8_BIT_COMPUTER_EMULATOR_H
 
+#include <atomic>
+#include <chrono>
 #include <memory>
+#include <mutex>
+#include <string_view>
 
 #include "ArithmeticLogicUnit.h"
+#include "Assembler.h"
 #include "Bus.h"
+#include "ChangeFilter.h"
+#include "EventRecorder.h"
 #include "Clock.h"
 #include "FlagsRegister.h"
+#include "FileWatcher.h"
+#include "Fork.h"
 #include "GenericRegister.h"
 #include "InstructionDecoder.h"
 #include "InstructionRegister.h"
+#include "MachineImage.h"
 #include "MemoryAddressRegister.h"
 #include "OutputRegister.h"
+#include "OutputStream.h"
 #include "ProgramCounter.h"
 #include "RandomAccessMemory.h"
+#include "Snapshot.h"
 #include "StepCounter.h"
 
 namespace Core {
@@ -24,24 +36,108 @@ namespace Core {
     class Emulator {
 
     public:
+        /** When a program that changes on disk while watched is swapped in. */
+        enum class HotReload {
+            OFF,
+            /** At the next instruction boundary, keeping the registers, so it continues running the new code. */
+            INSTRUCTION,
+            /** At the next reload(). */
+            RESET
+        };
+
         Emulator();
         ~Emulator();
 
-        /** Initialize the emulator with the program from the specified file. */
+        /**
+         * Initialize the emulator with the program from the specified file.
+         * Files of type .8bim are loaded as machine images, and other files are assembled.
+         */
         void load(const std::string &newFileName);
 
-        /** Resets state of the computer to the state where it was after load() and before run(). */
+        /**
+         * Initialize the emulator with instructions that are already assembled, without reading any files.
+         * Meant for batch runs of the same program, so the current values are not printed afterwards.
+         * Stops watching the file of an earlier program for hot reload.
+         */
+        void load(const std::vector<Assembler::Instruction> &newInstructions);
+
+        /**
+         * Initialize the emulator with a full image of the memory, like one from Assembler::toImage().
+         * Copies the image into memory in one go, without converting or allocating anything.
+         * Stops watching the file of an earlier program for hot reload.
+         */
+        void load(const MemoryImage &image);
+
+        /**
+         * Initialize the emulator with assembly source code that is already in memory, without reading any files.
+         * Invalid code throws a runtime_error with the line and column of the first problem.
+         */
+        void loadSource(std::string_view source);
+
+        /**
+         * Resets state of the computer to the state where it was after load() and before run().
+         * Restores the state cached by load(), without reading or assembling the file again.
+         */
         void reload();
 
+        /** Same as reload(), but reads and assembles the file again first, to pick up changes to it. */
+        void reloadFile();
+
+        /**
+         * Watch the file from load(string), and assemble it again in the background when it changes, without
+         * stopping the clock. The new program replaces the memory as chosen by the mode. Must not be running.
+         */
+        void setHotReload(HotReload mode);
+
+        /** Whether a changed program is assembled and waiting to be swapped in. */
+        [[nodiscard]] bool isHotReloadPending() const;
+
+        /** Time from noticing the last change of the file until the new program was in memory. 0 if none yet. */
+        [[nodiscard]] std::chrono::microseconds getHotReloadLatency() const;
+
+        /** Copy the complete state of the computer. Must not be running. */
+        [[nodiscard]] Snapshot snapshot() const;
+
+        /**
+         * Put the computer back in the state of the snapshot. Must not be running.
+         * Observers are notified of the restored values and control lines, but nothing is executed.
+         */
+        void restore(const Snapshot &snapshot);
+
+        /** Fork the current state into children that share it until they are changed. Must not be running. */
+        [[nodiscard]] std::vector<Fork> fork(size_t children) const;
+
+        /** The current state as a sibling of the fork, storing only what changed since the parent. */
+        [[nodiscard]] Fork fork(const Fork &sibling) const;
+
+        /** Put the computer in the state of the fork. Same as restore() of a snapshot. */
+        void restore(const Fork &fork);
+
+        /** Write the complete state of the computer to a checkpoint file. */
+        void saveCheckpoint(const std::string &checkpointFileName) const;
+
+        /** Restore the computer from a checkpoint file, to continue running from where it was saved. */
+        void loadCheckpoint(const std::string &checkpointFileName);
+
         /** Start running the loaded program. Asynchronous. */
         void startAsynchronous();
 
         /** Start running the loaded program. Synchronous. */
         void startSynchronous();
 
+        /**
+         * Run the loaded program synchronously in the calling thread, as fast as possible, until it halts or
+         * maxCycles clock cycles have passed. Returns the number of clock cycles that were run.
+         * The frequency is ignored, and does not need to be set.
+         */
+        unsigned long runSynchronous(unsigned long maxCycles);
+
         /** Whether the emulator is currently running a program. */
         bool isRunning();
 
+        /** Whether the loaded program has halted, and needs a reload() to run again. */
+        bool isHalted();
+
         /** Run one microinstruction synchronously and then stop. */
         void singleStep();
 
@@ -60,6 +156,12 @@ namespace Core {
         /** Set an optional external observer of the clock. */
         void setClockObserver(const std::shared_ptr<ClockObserver> &observer);
 
+        /**
+         * Add a listener that is ticked after all the components on both edges of the clock, so it sees the whole
+         * result of each edge. Can't be removed again.
+         */
+        void addClockListener(const std::shared_ptr<ClockListener> &listener);
+
         /** Set an optional external observer of the bus. */
         void setBusObserver(const std::shared_ptr<ValueObserver> &observer);
 
@@ -72,6 +174,12 @@ namespace Core {
         /** Set an optional external observer of the arithmetic logic unit. */
         void setArithmeticLogicUnitObserver(const std::shared_ptr<ArithmeticLogicUnitObserver> &observer);
 
+        /**
+         * Calculate the sum in the arithmetic logic unit every time the A or B register changes, so the observer
+         * sees every change, and not just when the sum is used. Off by default, since it's slower.
+         */
+        void setArithmeticLogicUnitEager(bool eager);
+
         /** Set an optional external observer of the memory address register. */
         void setMemoryAddressRegisterObserver(const std::shared_ptr<ValueObserver> &observer);
 
@@ -79,7 +187,7 @@ namespace Core {
         void setProgramCounterObserver(const std::shared_ptr<ValueObserver> &observer);
 
         /** Set an optional external observer of the random access memory. */
-        void setRandomAccessMemoryObserver(const std::shared_ptr<ValueObserver> &observer);
+        void setRandomAccessMemoryObserver(const std::shared_ptr<RandomAccessMemoryObserver> &observer);
 
         /** Set an optional external observer of the instruction register. */
         void setInstructionRegisterObserver(const std::shared_ptr<ValueObserver> &observer);
@@ -96,7 +204,45 @@ namespace Core {
         /** Set an optional external observer of the flags register. */
         void setFlagsRegisterObserver(const std::shared_ptr<FlagsRegisterObserver> &observer);
 
+        /**
+         * The value, flags and arithmetic logic unit observers are only notified when the values change.
+         * Turn this on to notify them of every write instead, like when counting outputs of the same value.
+         */
+        void setNotifyEveryWrite(bool everyWrite);
+
+        /** How many notifications to the value, flags and arithmetic logic unit observers were passed on or skipped. */
+        [[nodiscard]] ChangeFilter::Statistics getNotificationStatistics() const;
+
+        /**
+         * Set an optional external observer of all the components at once, that gets the changes in batches
+         * every flushCycles clock cycles, or at every instruction boundary with 0. The observers of the single
+         * components still get their changes right away.
+         */
+        void setEventObserver(const std::shared_ptr<EventObserver> &observer, unsigned long flushCycles = 0);
+
+        /**
+         * Deliver the events recorded so far to the event observer. Done after every synchronous run and when
+         * the program halts, but needed after stopping an asynchronous run, once it's no longer running.
+         */
+        void flushEvents();
+
+        /**
+         * Set an optional sink for every value the program outputs, with the clock cycle, counted from now.
+         * The sink gets them in batches from a thread of its own. With WAIT the clock waits when the sink falls
+         * too far behind, and with DROP the outputs that don't fit are dropped instead.
+         */
+        void setOutputSink(const std::shared_ptr<OutputSink> &sink,
+                           OutputStream::Overflow overflow = OutputStream::Overflow::WAIT);
+
+        /** Wait until the output sink has every value output so far. */
+        void flushOutputs();
+
+        /** The number of outputs the output sink didn't get, because it was too far behind. */
+        [[nodiscard]] unsigned long getDroppedOutputs() const;
+
     private:
+        class HotReloadListener;
+
         std::shared_ptr<TimeSource> timeSource;
         std::shared_ptr<Clock> clock;
         std::shared_ptr<Bus> bus;
@@ -112,11 +258,36 @@ namespace Core {
         std::shared_ptr<InstructionDecoder> instructionDecoder;
         std::shared_ptr<FlagsRegister> flagsRegister;
         std::string fileName;
+        std::vector<Assembler::Instruction> instructions;
+        Snapshot loadedSnapshot;
+        std::shared_ptr<EventDispatcher> observers;
+        std::shared_ptr<EventRecorder> eventRecorder;
+        std::shared_ptr<OutputStream> outputStream;
+        bool loaded;
+        bool notifyEveryWrite;
+        std::atomic<HotReload> hotReload;
+        std::string watchedFileName;
+        std::shared_ptr<HotReloadListener> hotReloadListener;
+        std::unique_ptr<FileWatcher> fileWatcher;
+        std::mutex hotReloadMutex;
+        MemoryImage hotReloadImage;
+        std::chrono::steady_clock::time_point hotReloadChangeTime;
+        std::atomic<bool> hotReloadPending;
+        std::atomic<long> hotReloadLatency;
 
         void printValues();
         void reset();
         void initializeProgram();
+        void assembleFile();
+        void programImage(const MachineImage::Program &program);
         [[nodiscard]] bool programMemory();
+        void assembleChangedFile();
+        void swapAtInstructionBoundary();
+
+        /** Stop watching the file and forget any program waiting to be swapped in, but keep the mode. */
+        void stopHotReload();
+        void applyHotReload(bool programMemory);
+        void connectObservers();
     };
 }
 
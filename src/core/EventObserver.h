@@ -0,0 +1,61 @@
+#ifndef INC_8_BIT_COMPUTER_EMULATOR_EVENTOBSERVER_H
+#define INC_8_BIT_COMPUTER_EMULATOR_EVENTOBSERVER_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Core {
+
+    /**
+     * A change to one of the components of the computer, as a small plain record.
+     * The flags, the arithmetic logic unit, the memory and the control word are packed into one number, see pack().
+     */
+    struct Event {
+        enum class Component : uint8_t {
+            BUS, A_REGISTER, B_REGISTER, ARITHMETIC_LOGIC_UNIT, MEMORY_ADDRESS_REGISTER, PROGRAM_COUNTER,
+            RANDOM_ACCESS_MEMORY, INSTRUCTION_REGISTER, OUTPUT_REGISTER, STEP_COUNTER, INSTRUCTION_DECODER,
+            FLAGS_REGISTER
+        };
+
+        /** The number of components. */
+        static constexpr size_t COMPONENTS = 12;
+
+        /** The clock cycle the change happened in, counted from when the event observer was set. */
+        unsigned long cycle;
+        uint32_t oldValue;
+        uint32_t newValue;
+        Component component;
+
+        /** The value with the carry bit at bit 8 and the zero bit at bit 9. */
+        static constexpr uint32_t pack(const uint8_t value, const bool carry, const bool zero) {
+            return value | carry << 8 | zero << 9;
+        }
+
+        /** The carry flag at bit 0 and the zero flag at bit 1. */
+        static constexpr uint32_t pack(const bool carry, const bool zero) {
+            return carry | zero << 1;
+        }
+
+        /** The value at the current address of the memory in bits 0-7, and the address in bits 8-11. */
+        static constexpr uint32_t packMemory(const uint8_t address, const uint8_t value) {
+            return value | address << 8;
+        }
+    };
+
+    /**
+     * Interface for external observation of all the components of the computer at once.
+     *
+     * Instead of a call for every change, the changes are collected and delivered together, so observers that
+     * look at everything, like loggers, only pay for one virtual call per batch.
+     * The changes are still collected from the observers of each component, so the clock thread makes
+     * one virtual call per change to record them before the batch is delivered.
+     */
+    class EventObserver {
+
+    public:
+        /** The following changes happened, in order. The events are only valid until the call returns. */
+        virtual void eventsUpdated(const Event *events, size_t count) = 0;
+    };
+}
+
+#endif //INC_8_BIT_COMPUTER_EMULATOR_EVENTOBSERVER_H
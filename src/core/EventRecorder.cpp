@@ -0,0 +1,321 @@
+#include <iostream>
+
+#include "Utils.h"
+
+#include "EventRecorder.h"
+
+class Core::EventRecorder::ValueTap: public ValueObserver {
+
+public:
+    ValueTap(EventRecorder *recorder, const Event::Component component, const std::shared_ptr<ValueObserver> &next) {
+        this->recorder = recorder;
+        this->component = component;
+        this->next = next;
+    }
+
+    void valueUpdated(const uint8_t newValue) override {
+        recorder->record(component, newValue);
+
+        if (next != nullptr) {
+            next->valueUpdated(newValue);
+        }
+    }
+
+private:
+    EventRecorder *recorder;
+    Event::Component component;
+    std::shared_ptr<ValueObserver> next;
+};
+
+class Core::EventRecorder::ArithmeticLogicUnitTap: public ArithmeticLogicUnitObserver {
+
+public:
+    ArithmeticLogicUnitTap(EventRecorder *recorder, const std::shared_ptr<ArithmeticLogicUnitObserver> &next) {
+        this->recorder = recorder;
+        this->next = next;
+    }
+
+    void resultUpdated(const uint8_t newValue, const bool newCarryBit, const bool newZeroBit) override {
+        recorder->record(Event::Component::ARITHMETIC_LOGIC_UNIT, Event::pack(newValue, newCarryBit, newZeroBit));
+
+        if (next != nullptr) {
+            next->resultUpdated(newValue, newCarryBit, newZeroBit);
+        }
+    }
+
+private:
+    EventRecorder *recorder;
+    std::shared_ptr<ArithmeticLogicUnitObserver> next;
+};
+
+class Core::EventRecorder::FlagsRegisterTap: public FlagsRegisterObserver {
+
+public:
+    FlagsRegisterTap(EventRecorder *recorder, const std::shared_ptr<FlagsRegisterObserver> &next) {
+        this->recorder = recorder;
+        this->next = next;
+    }
+
+    void flagsUpdated(const bool newCarryFlag, const bool newZeroFlag) override {
+        recorder->record(Event::Component::FLAGS_REGISTER, Event::pack(newCarryFlag, newZeroFlag));
+
+        if (next != nullptr) {
+            next->flagsUpdated(newCarryFlag, newZeroFlag);
+        }
+    }
+
+private:
+    EventRecorder *recorder;
+    std::shared_ptr<FlagsRegisterObserver> next;
+};
+
+class Core::EventRecorder::RandomAccessMemoryTap: public RandomAccessMemoryObserver {
+
+public:
+    RandomAccessMemoryTap(EventRecorder *recorder, const std::shared_ptr<RandomAccessMemoryObserver> &next) {
+        this->recorder = recorder;
+        this->next = next;
+    }
+
+    void valueUpdated(const uint8_t address, const uint8_t newValue) override {
+        recorder->record(Event::Component::RANDOM_ACCESS_MEMORY, Event::packMemory(address, newValue));
+
+        if (next != nullptr) {
+            next->valueUpdated(address, newValue);
+        }
+    }
+
+    void memoryUpdated(const MemoryImage &newMemory) override {
+        // One event per address, since the events only have room for one value
+        for (size_t i = 0; i < newMemory.size(); i++) {
+            recorder->record(Event::Component::RANDOM_ACCESS_MEMORY, Event::packMemory(i, newMemory[i]));
+        }
+
+        if (next != nullptr) {
+            next->memoryUpdated(newMemory);
+        }
+    }
+
+private:
+    EventRecorder *recorder;
+    std::shared_ptr<RandomAccessMemoryObserver> next;
+};
+
+class Core::EventRecorder::InstructionDecoderTap: public InstructionDecoderObserver {
+
+public:
+    InstructionDecoderTap(EventRecorder *recorder, const std::shared_ptr<InstructionDecoderObserver> &next) {
+        this->recorder = recorder;
+        this->next = next;
+    }
+
+    void controlWordUpdated(const ControlWord newWord) override {
+        recorder->record(Event::Component::INSTRUCTION_DECODER, newWord.bits());
+
+        if (next != nullptr) {
+            next->controlWordUpdated(newWord);
+        }
+    }
+
+private:
+    EventRecorder *recorder;
+    std::shared_ptr<InstructionDecoderObserver> next;
+};
+
+Core::EventRecorder::EventRecorder(const std::shared_ptr<Clock> &clock) {
+    if (Utils::debugL2()) {
+        std::cout << "EventRecorder construct" << std::endl;
+    }
+
+    this->clock = clock;
+    this->everyWrite = false;
+    this->flushCycles = 0;
+    this->cycle = 0;
+    this->flushedCycle = 0;
+    this->values = {};
+}
+
+Core::EventRecorder::~EventRecorder() {
+    if (Utils::debugL2()) {
+        std::cout << "EventRecorder destruct" << std::endl;
+    }
+}
+
+void Core::EventRecorder::setObserver(const std::shared_ptr<EventObserver> &newObserver,
+                                      const unsigned long newFlushCycles) {
+    flush();
+
+    observer = newObserver;
+    flushCycles = newFlushCycles;
+    cycle = 0;
+    flushedCycle = 0;
+}
+
+bool Core::EventRecorder::isRecording() const {
+    return observer != nullptr;
+}
+
+void Core::EventRecorder::setValue(const Event::Component component, const uint32_t value) {
+    values[static_cast<size_t>(component)] = value;
+}
+
+void Core::EventRecorder::setEveryWrite(const bool newEveryWrite) {
+    everyWrite = newEveryWrite;
+}
+
+void Core::EventRecorder::record(const Event::Component component, const uint32_t newValue) {
+    uint32_t &value = values[static_cast<size_t>(component)];
+
+    if (newValue == value && !everyWrite) {
+        return;
+    }
+
+    events.push_back({cycle, value, newValue, component});
+    value = newValue;
+}
+
+void Core::EventRecorder::flush() {
+    flushedCycle = cycle;
+
+    if (events.empty() || observer == nullptr) {
+        events.clear();
+        return;
+    }
+
+    observer->eventsUpdated(events.data(), events.size());
+
+    // Keeps the memory for the next batch
+    events.clear();
+}
+
+void Core::EventRecorder::invertedClockTicked() {
+    if (observer == nullptr) {
+        return;
+    }
+
+    // The last listener on the clock, so the cycle is over
+    cycle++;
+
+    // The step counter was just set to fetch the next instruction
+    const bool boundary = values[static_cast<size_t>(Event::Component::STEP_COUNTER)] == 0;
+
+    if (clock->isHalted() || (flushCycles == 0 ? boundary : cycle - flushedCycle >= flushCycles)) {
+        flush();
+    }
+}
+
+std::shared_ptr<Core::ValueObserver> Core::EventRecorder::tapValue(const Event::Component component,
+                                                                   const std::shared_ptr<ValueObserver> &next) {
+    return std::make_shared<ValueTap>(this, component, next);
+}
+
+std::shared_ptr<Core::ArithmeticLogicUnitObserver> Core::EventRecorder::tapArithmeticLogicUnit(
+        const std::shared_ptr<ArithmeticLogicUnitObserver> &next) {
+    return std::make_shared<ArithmeticLogicUnitTap>(this, next);
+}
+
+std::shared_ptr<Core::FlagsRegisterObserver> Core::EventRecorder::tapFlagsRegister(
+        const std::shared_ptr<FlagsRegisterObserver> &next) {
+    return std::make_shared<FlagsRegisterTap>(this, next);
+}
+
+std::shared_ptr<Core::RandomAccessMemoryObserver> Core::EventRecorder::tapRandomAccessMemory(
+        const std::shared_ptr<RandomAccessMemoryObserver> &next) {
+    return std::make_shared<RandomAccessMemoryTap>(this, next);
+}
+
+std::shared_ptr<Core::InstructionDecoderObserver> Core::EventRecorder::tapInstructionDecoder(
+        const std::shared_ptr<InstructionDecoderObserver> &next) {
+    return std::make_shared<InstructionDecoderTap>(this, next);
+}
+
+Core::EventDispatcher::EventDispatcher() {
+    if (Utils::debugL2()) {
+        std::cout << "EventDispatcher construct" << std::endl;
+    }
+}
+
+Core::EventDispatcher::~EventDispatcher() {
+    if (Utils::debugL2()) {
+        std::cout << "EventDispatcher destruct" << std::endl;
+    }
+}
+
+void Core::EventDispatcher::setValueObserver(const Event::Component component,
+                                             const std::shared_ptr<ValueObserver> &observer) {
+    valueObservers[static_cast<size_t>(component)] = observer;
+}
+
+void Core::EventDispatcher::setArithmeticLogicUnitObserver(const std::shared_ptr<ArithmeticLogicUnitObserver> &observer) {
+    arithmeticLogicUnitObserver = observer;
+}
+
+void Core::EventDispatcher::setFlagsRegisterObserver(const std::shared_ptr<FlagsRegisterObserver> &observer) {
+    flagsRegisterObserver = observer;
+}
+
+void Core::EventDispatcher::setRandomAccessMemoryObserver(const std::shared_ptr<RandomAccessMemoryObserver> &observer) {
+    randomAccessMemoryObserver = observer;
+}
+
+void Core::EventDispatcher::setInstructionDecoderObserver(const std::shared_ptr<InstructionDecoderObserver> &observer) {
+    instructionDecoderObserver = observer;
+}
+
+std::shared_ptr<Core::ValueObserver> Core::EventDispatcher::getValueObserver(const Event::Component component) const {
+    return valueObservers[static_cast<size_t>(component)];
+}
+
+std::shared_ptr<Core::ArithmeticLogicUnitObserver> Core::EventDispatcher::getArithmeticLogicUnitObserver() const {
+    return arithmeticLogicUnitObserver;
+}
+
+std::shared_ptr<Core::FlagsRegisterObserver> Core::EventDispatcher::getFlagsRegisterObserver() const {
+    return flagsRegisterObserver;
+}
+
+std::shared_ptr<Core::RandomAccessMemoryObserver> Core::EventDispatcher::getRandomAccessMemoryObserver() const {
+    return randomAccessMemoryObserver;
+}
+
+std::shared_ptr<Core::InstructionDecoderObserver> Core::EventDispatcher::getInstructionDecoderObserver() const {
+    return instructionDecoderObserver;
+}
+
+void Core::EventDispatcher::eventsUpdated(const Event *events, const size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        const Event &event = events[i];
+
+        switch (event.component) {
+            case Event::Component::ARITHMETIC_LOGIC_UNIT:
+                if (arithmeticLogicUnitObserver != nullptr) {
+                    arithmeticLogicUnitObserver->resultUpdated(event.newValue & 0xFF, event.newValue >> 8 & 1,
+                                                               event.newValue >> 9 & 1);
+                }
+                break;
+            case Event::Component::FLAGS_REGISTER:
+                if (flagsRegisterObserver != nullptr) {
+                    flagsRegisterObserver->flagsUpdated(event.newValue & 1, event.newValue >> 1 & 1);
+                }
+                break;
+            case Event::Component::RANDOM_ACCESS_MEMORY:
+                if (randomAccessMemoryObserver != nullptr) {
+                    randomAccessMemoryObserver->valueUpdated(event.newValue >> 8 & 0x0F, event.newValue & 0xFF);
+                }
+                break;
+            case Event::Component::INSTRUCTION_DECODER:
+                if (instructionDecoderObserver != nullptr) {
+                    instructionDecoderObserver->controlWordUpdated(ControlWord::fromBits(event.newValue));
+                }
+                break;
+            default: {
+                const std::shared_ptr<ValueObserver> &observer = valueObservers[static_cast<size_t>(event.component)];
+
+                if (observer != nullptr) {
+                    observer->valueUpdated(event.newValue);
+                }
+                break;
+            }
+        }
+    }
+}
@@ -0,0 +1,118 @@
+#ifndef INC_8_BIT_COMPUTER_EMULATOR_EVENTRECORDER_H
+#define INC_8_BIT_COMPUTER_EMULATOR_EVENTRECORDER_H
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "ArithmeticLogicUnitObserver.h"
+#include "Clock.h"
+#include "ClockListener.h"
+#include "EventObserver.h"
+#include "FlagsRegisterObserver.h"
+#include "InstructionDecoderObserver.h"
+#include "RandomAccessMemoryObserver.h"
+#include "ValueObserver.h"
+
+namespace Core {
+
+    /**
+     * Collects the changes from all the components as events, and delivers them to an event observer in batches.
+     *
+     * The recorder is put between the components and their observers, with one tap for each component,
+     * which records the change and passes it on to the observer of the component right away, if there is one.
+     * The batch is delivered every number of clock cycles, or at every instruction boundary, and when the
+     * clock halts. Only used from the thread the emulator runs on.
+     */
+    class EventRecorder: public ClockListener {
+
+    public:
+        explicit EventRecorder(const std::shared_ptr<Clock> &clock);
+        ~EventRecorder();
+
+        /**
+         * Set the observer of the events, or nullptr to stop recording. Delivers the events for the last observer
+         * first. A flushCycles of 0 delivers the events at every instruction boundary.
+         */
+        void setObserver(const std::shared_ptr<EventObserver> &newObserver, unsigned long flushCycles);
+
+        /** Whether there is an observer to record events for. */
+        [[nodiscard]] bool isRecording() const;
+
+        /** The value a component starts with, so the first event has the right old value. */
+        void setValue(Event::Component component, uint32_t value);
+
+        /** Record every write, even when the value is the same. Off by default. */
+        void setEveryWrite(bool newEveryWrite);
+
+        /** Record a change, unless the value is the same and only changes are recorded. */
+        void record(Event::Component component, uint32_t newValue);
+
+        /** Deliver the events recorded so far. */
+        void flush();
+
+        /** A value observer that records changes to the component before passing them on to the next observer. */
+        std::shared_ptr<ValueObserver> tapValue(Event::Component component,
+                                                const std::shared_ptr<ValueObserver> &next);
+        std::shared_ptr<ArithmeticLogicUnitObserver> tapArithmeticLogicUnit(
+                const std::shared_ptr<ArithmeticLogicUnitObserver> &next);
+        std::shared_ptr<FlagsRegisterObserver> tapFlagsRegister(const std::shared_ptr<FlagsRegisterObserver> &next);
+        std::shared_ptr<RandomAccessMemoryObserver> tapRandomAccessMemory(
+                const std::shared_ptr<RandomAccessMemoryObserver> &next);
+        std::shared_ptr<InstructionDecoderObserver> tapInstructionDecoder(
+                const std::shared_ptr<InstructionDecoderObserver> &next);
+
+        void clockTicked() override {} // Not implemented
+        void invertedClockTicked() override;
+
+    private:
+        class ValueTap;
+        class ArithmeticLogicUnitTap;
+        class FlagsRegisterTap;
+        class RandomAccessMemoryTap;
+        class InstructionDecoderTap;
+
+        std::shared_ptr<Clock> clock;
+        std::shared_ptr<EventObserver> observer;
+        bool everyWrite;
+        unsigned long flushCycles;
+        unsigned long cycle;
+        unsigned long flushedCycle;
+        std::vector<Event> events;
+        std::array<uint32_t, Event::COMPONENTS> values;
+    };
+
+    /**
+     * Adapter from events to the observers of the single components, so they can be used with batches too.
+     * Each event becomes a call to the observer of the component it belongs to, if there is one.
+     */
+    class EventDispatcher: public EventObserver {
+
+    public:
+        EventDispatcher();
+        ~EventDispatcher();
+
+        void setValueObserver(Event::Component component, const std::shared_ptr<ValueObserver> &observer);
+        void setArithmeticLogicUnitObserver(const std::shared_ptr<ArithmeticLogicUnitObserver> &observer);
+        void setFlagsRegisterObserver(const std::shared_ptr<FlagsRegisterObserver> &observer);
+        void setRandomAccessMemoryObserver(const std::shared_ptr<RandomAccessMemoryObserver> &observer);
+        void setInstructionDecoderObserver(const std::shared_ptr<InstructionDecoderObserver> &observer);
+
+        [[nodiscard]] std::shared_ptr<ValueObserver> getValueObserver(Event::Component component) const;
+        [[nodiscard]] std::shared_ptr<ArithmeticLogicUnitObserver> getArithmeticLogicUnitObserver() const;
+        [[nodiscard]] std::shared_ptr<FlagsRegisterObserver> getFlagsRegisterObserver() const;
+        [[nodiscard]] std::shared_ptr<RandomAccessMemoryObserver> getRandomAccessMemoryObserver() const;
+        [[nodiscard]] std::shared_ptr<InstructionDecoderObserver> getInstructionDecoderObserver() const;
+
+        void eventsUpdated(const Event *events, size_t count) override;
+
+    private:
+        std::array<std::shared_ptr<ValueObserver>, Event::COMPONENTS> valueObservers;
+        std::shared_ptr<ArithmeticLogicUnitObserver> arithmeticLogicUnitObserver;
+        std::shared_ptr<FlagsRegisterObserver> flagsRegisterObserver;
+        std::shared_ptr<RandomAccessMemoryObserver> randomAccessMemoryObserver;
+        std::shared_ptr<InstructionDecoderObserver> instructionDecoderObserver;
+    };
+}
+
+#endif //INC_8_BIT_COMPUTER_EMULATOR_EVENTRECORDER_H
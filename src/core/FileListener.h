@@ -0,0 +1,17 @@
+#ifndef INC_8_BIT_COMPUTER_EMULATOR_FILELISTENER_H
+#define INC_8_BIT_COMPUTER_EMULATOR_FILELISTENER_H
+
+namespace Core {
+
+    /**
+     * Interface to be implemented by those who want to be notified when a watched file has changed.
+     */
+    class FileListener {
+
+    public:
+        /** The file was written to, or replaced. Called from the thread of the watcher. */
+        virtual void fileChanged() = 0;
+    };
+}
+
+#endif //INC_8_BIT_COMPUTER_EMULATOR_FILELISTENER_H
@@ -0,0 +1,77 @@
+#include <iostream>
+
+#include "Utils.h"
+
+#include "FileOutputSink.h"
+
+namespace {
+    FILE *openFile(const std::string &fileName) {
+        FILE *file = fopen(fileName.c_str(), "w");
+
+        if (file == nullptr) {
+            throw std::runtime_error("FileOutputSink: failed to open file: " + fileName);
+        }
+
+        return file;
+    }
+
+    FILE *startCommand(const std::string &command) {
+        FILE *file = popen(command.c_str(), "w");
+
+        if (file == nullptr) {
+            throw std::runtime_error("PipeOutputSink: failed to start command: " + command);
+        }
+
+        return file;
+    }
+}
+
+Core::FileOutputSink::FileOutputSink(const std::string &fileName) : FileOutputSink(openFile(fileName)) {
+}
+
+Core::FileOutputSink::FileOutputSink(FILE *file) {
+    if (Utils::debugL2()) {
+        std::cout << "FileOutputSink construct" << std::endl;
+    }
+
+    this->file = file;
+}
+
+Core::FileOutputSink::~FileOutputSink() {
+    if (Utils::debugL2()) {
+        std::cout << "FileOutputSink destruct" << std::endl;
+    }
+
+    if (file != nullptr) {
+        fclose(file);
+    }
+}
+
+void Core::FileOutputSink::outputsWritten(const Output *outputs, const size_t count) {
+    // "18446744073709551615 255\n" is the longest line
+    char line[32];
+    text.clear();
+
+    for (size_t i = 0; i < count; i++) {
+        const int length = snprintf(line, sizeof(line), "%lu %d\n", outputs[i].cycle, outputs[i].value);
+        text.append(line, length);
+    }
+
+    fwrite(text.data(), 1, text.size(), file);
+    fflush(file);
+}
+
+Core::PipeOutputSink::PipeOutputSink(const std::string &command) : FileOutputSink(startCommand(command)) {
+    if (Utils::debugL2()) {
+        std::cout << "PipeOutputSink construct" << std::endl;
+    }
+}
+
+Core::PipeOutputSink::~PipeOutputSink() {
+    if (Utils::debugL2()) {
+        std::cout << "PipeOutputSink destruct" << std::endl;
+    }
+
+    pclose(file);
+    file = nullptr;
+}
@@ -0,0 +1,46 @@
+#ifndef INC_8_BIT_COMPUTER_EMULATOR_FILEOUTPUTSINK_H
+#define INC_8_BIT_COMPUTER_EMULATOR_FILEOUTPUTSINK_H
+
+#include <cstdio>
+#include <string>
+
+#include "OutputSink.h"
+
+namespace Core {
+
+    /**
+     * Writes the outputs to a file as text, one line of "cycle value" for each. Each batch is formatted
+     * in memory first, and written in one go.
+     */
+    class FileOutputSink: public OutputSink {
+
+    public:
+        /** Creates the file, or empties it if it already exists. */
+        explicit FileOutputSink(const std::string &fileName);
+        ~FileOutputSink() override;
+
+        void outputsWritten(const Output *outputs, size_t count) override;
+
+    protected:
+        /** For subclasses that open the file some other way. Takes over closing it. */
+        explicit FileOutputSink(FILE *file);
+
+        FILE *file;
+
+    private:
+        std::string text;
+    };
+
+    /** Writes the outputs to the standard in of another process, the same way as to a file. */
+    class PipeOutputSink: public FileOutputSink {
+
+    public:
+        /** Starts the command with the shell. */
+        explicit PipeOutputSink(const std::string &command);
+
+        /** Waits for the command to finish. */
+        ~PipeOutputSink() override;
+    };
+}
+
+#endif //INC_8_BIT_COMPUTER_EMULATOR_FILEOUTPUTSINK_H
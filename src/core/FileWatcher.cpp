@@ -0,0 +1,135 @@
+#include <chrono>
+#include <iostream>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include "Utils.h"
+
+#include "FileWatcher.h"
+
+Core::FileWatcher::FileWatcher(const std::string &fileName, const std::shared_ptr<FileListener> &listener) {
+    if (Utils::debugL2()) {
+        std::cout << "FileWatcher construct" << std::endl;
+    }
+
+    this->path = std::filesystem::absolute(fileName);
+    this->listener = listener;
+    this->watching = false;
+    this->descriptor = -1;
+    this->lastWriteTime = {};
+}
+
+Core::FileWatcher::~FileWatcher() {
+    if (Utils::debugL2()) {
+        std::cout << "FileWatcher destruct" << std::endl;
+    }
+
+    stop();
+}
+
+void Core::FileWatcher::start() {
+    if (watching) {
+        return;
+    }
+
+#ifdef __linux__
+    descriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+    if (descriptor < 0) {
+        throw std::runtime_error("FileWatcher: failed to initialize inotify");
+    }
+
+    // The directory, to also see the file being replaced
+    if (inotify_add_watch(descriptor, path.parent_path().c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        close(descriptor);
+        descriptor = -1;
+        throw std::runtime_error("FileWatcher: failed to watch file: " + path.string());
+    }
+#else
+    std::error_code error;
+    lastWriteTime = std::filesystem::last_write_time(path, error);
+
+    if (error) {
+        throw std::runtime_error("FileWatcher: failed to watch file: " + path.string());
+    }
+#endif
+
+    if (Utils::debugL1()) {
+        std::cout << "FileWatcher: watching " << path.string() << std::endl;
+    }
+
+    watching = true;
+    watchThread = std::thread(&FileWatcher::watchLoop, this);
+}
+
+void Core::FileWatcher::stop() {
+    watching = false;
+
+    if (watchThread.joinable()) {
+        watchThread.join();
+    }
+
+#ifdef __linux__
+    if (descriptor >= 0) {
+        close(descriptor);
+        descriptor = -1;
+    }
+#endif
+}
+
+bool Core::FileWatcher::isWatching() const {
+    return watching;
+}
+
+void Core::FileWatcher::watchLoop() {
+#ifdef __linux__
+    // Room for many events at once, which are all handled as one change
+    alignas(inotify_event) char buffer[4096];
+    pollfd pollDescriptor = {descriptor, POLLIN, 0};
+
+    while (watching) {
+        // With a timeout, to notice stop()
+        if (poll(&pollDescriptor, 1, POLL_MILLISECONDS) <= 0) {
+            continue;
+        }
+
+        const ssize_t length = read(descriptor, buffer, sizeof(buffer));
+        bool changed = false;
+
+        for (ssize_t offset = 0; offset < length;) {
+            const auto *event = reinterpret_cast<const inotify_event *>(buffer + offset);
+
+            if (event->len > 0 && path.filename() == event->name) {
+                changed = true;
+            }
+
+            offset += sizeof(inotify_event) + event->len;
+        }
+
+        if (changed) {
+            if (Utils::debugL1()) {
+                std::cout << "FileWatcher: changed " << path.string() << std::endl;
+            }
+
+            listener->fileChanged();
+        }
+    }
+#else
+    while (watching) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(POLL_MILLISECONDS));
+
+        std::error_code error;
+        const std::filesystem::file_time_type writeTime = std::filesystem::last_write_time(path, error);
+
+        // Missing for a moment while being replaced
+        if (!error && writeTime != lastWriteTime) {
+            lastWriteTime = writeTime;
+            listener->fileChanged();
+        }
+    }
+#endif
+}
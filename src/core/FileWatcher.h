@@ -0,0 +1,52 @@
+#ifndef INC_8_BIT_COMPUTER_EMULATOR_FILEWATCHER_H
+#define INC_8_BIT_COMPUTER_EMULATOR_FILEWATCHER_H
+
+#include <atomic>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "FileListener.h"
+
+namespace Core {
+
+    /**
+     * Watches a file in a background thread, and notifies the listener when it's written to or replaced.
+     *
+     * Uses inotify on Linux, on the directory of the file, since many editors save by writing a new file
+     * and renaming it over the old one. Other systems check the modification time of the file a few times a second.
+     */
+    class FileWatcher {
+
+    public:
+        FileWatcher(const std::string &fileName, const std::shared_ptr<FileListener> &listener);
+        ~FileWatcher();
+
+        FileWatcher(const FileWatcher &) = delete;
+        FileWatcher &operator=(const FileWatcher &) = delete;
+
+        /** Start watching the file in the background. */
+        void start();
+
+        /** Stop watching the file, and wait for the background thread to finish. */
+        void stop();
+
+        /** Whether the file is being watched. */
+        [[nodiscard]] bool isWatching() const;
+
+    private:
+        static const int POLL_MILLISECONDS = 100;
+
+        std::filesystem::path path;
+        std::shared_ptr<FileListener> listener;
+        std::atomic<bool> watching;
+        std::thread watchThread;
+        int descriptor; // inotify, Linux only
+        std::filesystem::file_time_type lastWriteTime; // Other systems only
+
+        void watchLoop();
+    };
+}
+
+#endif //INC_8_BIT_COMPUTER_EMULATOR_FILEWATCHER_H
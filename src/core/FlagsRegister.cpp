@@ -1,5 +1,7 @@
 #include <iostream>
 
+#include "EventObserver.h"
+#include "Log.h"
 #include "Utils.h"
 
 #include "FlagsRegister.h"
@@ -22,7 +24,7 @@ Core::FlagsRegister::~FlagsRegister() {
 }
 
 void Core::FlagsRegister::print() const {
-    std::cout << "FlagsRegister: CF=" << carryFlag << ", ZF=" << zeroFlag << std::endl;
+    Log::printf("FlagsRegister: CF=%d, ZF=%d\n", carryFlag, zeroFlag);
 }
 
 void Core::FlagsRegister::reset() {
@@ -74,12 +76,32 @@ bool Core::FlagsRegister::isZeroFlag() const {
     return zeroFlag;
 }
 
-void Core::FlagsRegister::notifyObserver() const {
-    if (observer != nullptr) {
+void Core::FlagsRegister::notifyObserver() {
+    if (Utils::OBSERVED && observer != nullptr && changeFilter.shouldPass(Event::pack(carryFlag, zeroFlag))) {
         observer->flagsUpdated(carryFlag, zeroFlag);
     }
 }
 
+Core::FlagsRegister::State Core::FlagsRegister::getState() const {
+    return {carryFlag, zeroFlag, readOnClock};
+}
+
+void Core::FlagsRegister::setState(const State &state) {
+    carryFlag = state.carryFlag;
+    zeroFlag = state.zeroFlag;
+    readOnClock = state.readOnClock;
+
+    notifyObserver();
+}
+
 void Core::FlagsRegister::setObserver(const std::shared_ptr<FlagsRegisterObserver> &newObserver) {
     observer = newObserver;
 }
+
+void Core::FlagsRegister::setNotifyEveryWrite(const bool everyWrite) {
+    changeFilter.setEveryWrite(everyWrite);
+}
+
+Core::ChangeFilter::Statistics Core::FlagsRegister::getNotificationStatistics() const {
+    return changeFilter.getStatistics();
+}
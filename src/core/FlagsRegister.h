@@ -2,6 +2,7 @@
 #define INC_8_BIT_COMPUTER_EMULATOR_FLAGSREGISTER_H
 
 #include "ArithmeticLogicUnit.h"
+#include "ChangeFilter.h"
 #include "ClockListener.h"
 #include "FlagsRegisterObserver.h"
 
@@ -19,6 +20,13 @@ namespace Core {
     class FlagsRegister: public ClockListener {
 
     public:
+        /** Everything needed to put this flags register back the way it was, including pending reads from the clock. */
+        struct State {
+            bool carryFlag;
+            bool zeroFlag;
+            bool readOnClock;
+        };
+
         explicit FlagsRegister(const std::shared_ptr<ArithmeticLogicUnit> &arithmeticLogicUnit);
         ~FlagsRegister();
 
@@ -37,18 +45,31 @@ namespace Core {
         /** Is the zero flag set. */
         [[nodiscard]] virtual bool isZeroFlag() const;
 
+        /** Get a copy of the current state. */
+        [[nodiscard]] State getState() const;
+
+        /** Put back a state from getState(), and notify the observer. */
+        void setState(const State &state);
+
         /** Set an optional external observer of this register. */
         void setObserver(const std::shared_ptr<FlagsRegisterObserver> &newObserver);
 
+        /** Notify the observer of every write, instead of only when the flags change. Off by default. */
+        void setNotifyEveryWrite(bool everyWrite);
+
+        /** How many notifications to the observer were passed on or skipped. */
+        [[nodiscard]] ChangeFilter::Statistics getNotificationStatistics() const;
+
     private:
         std::shared_ptr<ArithmeticLogicUnit> arithmeticLogicUnit;
         std::shared_ptr<FlagsRegisterObserver> observer;
+        ChangeFilter changeFilter;
         bool readOnClock;
         bool carryFlag;
         bool zeroFlag;
 
         void readFromAlu();
-        void notifyObserver() const;
+        void notifyObserver();
 
         void clockTicked() override;
         void invertedClockTicked() override {}; // Not implemented
@@ -0,0 +1,98 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+
+#include "Utils.h"
+
+#include "Fork.h"
+
+// Every byte of a Snapshot is state, so the changes can be found and applied byte by byte
+static_assert(alignof(Core::Snapshot) == 1, "Snapshot must not have padding");
+static_assert(sizeof(Core::Snapshot) <= 256, "Snapshot offsets must fit in a byte");
+
+Core::Fork::Fork(const Snapshot &snapshot) {
+    if (Utils::debugL2()) {
+        std::cout << "Fork construct" << std::endl;
+    }
+
+    this->parent = std::make_shared<const Snapshot>(snapshot);
+}
+
+Core::Fork::~Fork() {
+    if (Utils::debugL2()) {
+        std::cout << "Fork destruct" << std::endl;
+    }
+}
+
+Core::Fork Core::Fork::withState(const Snapshot &snapshot) const {
+    Fork sibling = *this;
+    sibling.changes.clear();
+
+    const auto *parentBytes = reinterpret_cast<const uint8_t *>(parent.get());
+    const auto *bytes = reinterpret_cast<const uint8_t *>(&snapshot);
+
+    for (size_t offset = 0; offset < sizeof(Snapshot); offset++) {
+        if (bytes[offset] != parentBytes[offset]) {
+            sibling.changes.push_back({static_cast<uint8_t>(offset), bytes[offset]});
+        }
+    }
+
+    return sibling;
+}
+
+void Core::Fork::writeMemory(const uint8_t address, const uint8_t value) {
+    if (address >= RandomAccessMemory::MEMORY_SIZE) {
+        throw std::runtime_error("Fork: memory address out of bounds " + std::to_string(address));
+    }
+
+    write(offsetof(Snapshot, randomAccessMemory) + offsetof(RandomAccessMemory::State, memory) + address, value);
+}
+
+void Core::Fork::setFlags(const bool carryFlag, const bool zeroFlag) {
+    write(offsetof(Snapshot, flagsRegister) + offsetof(FlagsRegister::State, carryFlag), carryFlag);
+    write(offsetof(Snapshot, flagsRegister) + offsetof(FlagsRegister::State, zeroFlag), zeroFlag);
+}
+
+Core::Snapshot Core::Fork::toSnapshot() const {
+    Snapshot snapshot = *parent;
+    auto *bytes = reinterpret_cast<uint8_t *>(&snapshot);
+
+    for (const Change &change : changes) {
+        bytes[change.offset] = change.value;
+    }
+
+    return snapshot;
+}
+
+const Core::Snapshot &Core::Fork::getParent() const {
+    return *parent;
+}
+
+size_t Core::Fork::getChangedBytes() const {
+    return changes.size();
+}
+
+bool Core::Fork::isSiblingOf(const Fork &other) const {
+    return parent == other.parent;
+}
+
+void Core::Fork::write(const size_t offset, const uint8_t value) {
+    const uint8_t parentValue = reinterpret_cast<const uint8_t *>(parent.get())[offset];
+    auto change = std::lower_bound(changes.begin(), changes.end(), offset,
+                                   [](const Change &existing, const size_t target) {
+                                       return existing.offset < target;
+                                   });
+    const bool exists = change != changes.end() && change->offset == offset;
+
+    // Only keep what differs, so writing back the value of the parent removes the change
+    if (value == parentValue) {
+        if (exists) {
+            changes.erase(change);
+        }
+    } else if (exists) {
+        change->value = value;
+    } else {
+        changes.insert(change, {static_cast<uint8_t>(offset), value});
+    }
+}
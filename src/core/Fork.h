@@ -0,0 +1,60 @@
+#ifndef INC_8_BIT_COMPUTER_EMULATOR_FORK_H
+#define INC_8_BIT_COMPUTER_EMULATOR_FORK_H
+
+#include <memory>
+#include <vector>
+
+#include "Snapshot.h"
+
+namespace Core {
+
+    /**
+     * A copy-on-write state of the computer, for trying out different paths from the same point in a run.
+     *
+     * All the forks of a parent share one read only copy of its Snapshot, and each fork only stores the bytes
+     * where it differs from it. Copying a fork gives a sibling. Use Emulator::fork() to create forks,
+     * and Emulator::restore() to run one.
+     */
+    class Fork {
+
+    public:
+        /** Start a new parent from the snapshot. The snapshot is copied once, and shared by all copies of the fork. */
+        explicit Fork(const Snapshot &snapshot);
+        ~Fork();
+
+        /** A sibling of this fork, with the state of the snapshot stored as changes from the shared parent. */
+        [[nodiscard]] Fork withState(const Snapshot &snapshot) const;
+
+        /** Change a value in memory, like patching a DB before continuing. */
+        void writeMemory(uint8_t address, uint8_t value);
+
+        /** Change the flags, like forcing a JC or JZ to go the other way. */
+        void setFlags(bool carryFlag, bool zeroFlag);
+
+        /** The complete state, with the changes applied to the parent. */
+        [[nodiscard]] Snapshot toSnapshot() const;
+
+        /** The state of the parent shared by all the siblings. */
+        [[nodiscard]] const Snapshot &getParent() const;
+
+        /** Number of bytes that differ from the parent. */
+        [[nodiscard]] size_t getChangedBytes() const;
+
+        /** Whether this fork shares the parent with the other fork, so they are siblings. */
+        [[nodiscard]] bool isSiblingOf(const Fork &other) const;
+
+    private:
+        /** One byte of the Snapshot that differs from the parent. */
+        struct Change {
+            uint8_t offset;
+            uint8_t value;
+        };
+
+        std::shared_ptr<const Snapshot> parent;
+        std::vector<Change> changes; // Sorted by offset
+
+        void write(size_t offset, uint8_t value);
+    };
+}
+
+#endif //INC_8_BIT_COMPUTER_EMULATOR_FORK_H
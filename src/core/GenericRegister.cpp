@@ -1,5 +1,6 @@
 #include <iostream>
 
+#include "Log.h"
 #include "Utils.h"
 
 #include "GenericRegister.h"
@@ -43,7 +44,7 @@ uint8_t Core::GenericRegister::readValue() const {
 }
 
 void Core::GenericRegister::print() {
-    printf("%s register: %d / 0x%02X / " BYTE_PATTERN " \n", name.c_str(), value, value, BYTE_TO_BINARY(value));
+    Log::printf("%s register: %d / 0x%02X / " BYTE_PATTERN " \n", name.c_str(), value, value, BYTE_TO_BINARY(value));
 }
 
 void Core::GenericRegister::reset() {
@@ -80,8 +81,8 @@ void Core::GenericRegister::clockTicked() {
     }
 }
 
-void Core::GenericRegister::notifyObserver() const {
-    if (observer != nullptr) {
+void Core::GenericRegister::notifyObserver() {
+    if (Utils::OBSERVED && observer != nullptr && changeFilter.shouldPass(value)) {
         observer->valueUpdated(value);
     }
 }
@@ -96,6 +97,25 @@ void Core::GenericRegister::setRegisterListener(const std::shared_ptr<RegisterLi
     registerListener = newRegisterListener;
 }
 
+Core::GenericRegister::State Core::GenericRegister::getState() const {
+    return {value, readOnClock};
+}
+
+void Core::GenericRegister::setState(const State &state) {
+    value = state.value;
+    readOnClock = state.readOnClock;
+
+    notifyObserver();
+}
+
 void Core::GenericRegister::setObserver(const std::shared_ptr<ValueObserver> &newObserver) {
     observer = newObserver;
 }
+
+void Core::GenericRegister::setNotifyEveryWrite(const bool everyWrite) {
+    changeFilter.setEveryWrite(everyWrite);
+}
+
+Core::ChangeFilter::Statistics Core::GenericRegister::getNotificationStatistics() const {
+    return changeFilter.getStatistics();
+}
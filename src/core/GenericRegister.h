@@ -5,6 +5,7 @@
 #include <string>
 
 #include "Bus.h"
+#include "ChangeFilter.h"
 #include "ClockListener.h"
 #include "RegisterListener.h"
 #include "ValueObserver.h"
@@ -19,6 +20,12 @@ namespace Core {
     class GenericRegister: public ClockListener {
 
     public:
+        /** Everything needed to put this register back the way it was, including pending reads from the clock. */
+        struct State {
+            uint8_t value;
+            bool readOnClock;
+        };
+
         GenericRegister(const std::string& name, const std::shared_ptr<Bus> &bus);
         ~GenericRegister();
 
@@ -40,20 +47,33 @@ namespace Core {
         /** Set a listener that will be notified when the value changes. */
         void setRegisterListener(const std::shared_ptr<RegisterListener> &newRegisterListener);
 
+        /** Get a copy of the current state. */
+        [[nodiscard]] State getState() const;
+
+        /** Put back a state from getState(). Notifies the observer, but not the listener. */
+        void setState(const State &state);
+
         /** Set an optional external observer of this register. */
         void setObserver(const std::shared_ptr<ValueObserver> &newObserver);
 
+        /** Notify the observer of every write, instead of only when the value changes. Off by default. */
+        void setNotifyEveryWrite(bool everyWrite);
+
+        /** How many notifications to the observer were passed on or skipped. */
+        [[nodiscard]] ChangeFilter::Statistics getNotificationStatistics() const;
+
     private:
         std::string name;
         std::shared_ptr<RegisterListener> registerListener;
         std::shared_ptr<ValueObserver> observer;
+        ChangeFilter changeFilter;
         std::shared_ptr<Bus> bus;
         uint8_t value;
         bool readOnClock;
 
         void readFromBus();
         void writeToBus();
-        void notifyObserver() const;
+        void notifyObserver();
         void notifyListener() const;
 
         void clockTicked() override;
@@ -371,8 +371,8 @@ void Core::InstructionDecoder::handleStep4() const {
     }
 }
 
-void Core::InstructionDecoder::notifyObserver(const std::vector<ControlLine> &lines) const {
-    if (observer != nullptr) {
+void Core::InstructionDecoder::notifyObserver(const ControlWord lines) const {
+    if (Utils::OBSERVED && observer != nullptr) {
         observer->controlWordUpdated(lines);
     }
 }
@@ -83,7 +83,7 @@ namespace Core {
         void handleStep3() const;
         void handleStep4() const;
 
-        void notifyObserver(const std::vector<ControlLine> &lines = {}) const;
+        void notifyObserver(ControlWord lines = {}) const;
 
         void stepReady(uint8_t step) override;
     };
@@ -3,13 +3,9 @@
 
 #include <vector>
 
-namespace Core {
+#include "ControlWord.h"
 
-    /** The short name of all the different control lines. */
-    enum class ControlLine {
-        //                                       S-          O-
-        HLT, MI, RI, RO, II, IO, AI, AO, BI, BO, SM, SO, OI, OM, CE, CO, CJ, FI
-    };
+namespace Core {
 
     /**
      * Interface for external observation of the instruction decoder of the computer.
@@ -18,7 +14,22 @@ namespace Core {
 
     public:
         /** The control word is updated to have the following lines enabled. */
-        virtual void controlWordUpdated(const std::vector<ControlLine> &newLines) = 0;
+        virtual void controlWordUpdated(ControlWord newWord) = 0;
+    };
+
+    /**
+     * Adapter for observers that want the enabled lines as a list, like the interface used to give them.
+     * Builds a new list on every update, so prefer the control word where speed matters.
+     */
+    class InstructionDecoderLinesObserver: public InstructionDecoderObserver {
+
+    public:
+        /** The control word is updated to have the following lines enabled. */
+        virtual void controlLinesUpdated(const std::vector<ControlLine> &newLines) = 0;
+
+        void controlWordUpdated(const ControlWord newWord) override {
+            controlLinesUpdated(newWord.toLines());
+        }
     };
 }
 
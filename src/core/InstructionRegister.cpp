@@ -1,5 +1,6 @@
 #include <iostream>
 
+#include "Log.h"
 #include "Utils.h"
 
 #include "InstructionRegister.h"
@@ -39,7 +40,7 @@ void Core::InstructionRegister::writeToBus() {
 }
 
 void Core::InstructionRegister::print() const {
-    printf("InstructionRegister: %d / 0x%02X / " BYTE_PATTERN " \n", value, value, BYTE_TO_BINARY(value));
+    Log::printf("InstructionRegister: %d / 0x%02X / " BYTE_PATTERN " \n", value, value, BYTE_TO_BINARY(value));
 }
 
 void Core::InstructionRegister::reset() {
@@ -79,12 +80,31 @@ uint8_t Core::InstructionRegister::getOpcode() const {
     return value >> 4; // Extract the first 4 bits;
 }
 
-void Core::InstructionRegister::notifyObserver() const {
-    if (observer != nullptr) {
+void Core::InstructionRegister::notifyObserver() {
+    if (Utils::OBSERVED && observer != nullptr && changeFilter.shouldPass(value)) {
         observer->valueUpdated(value);
     }
 }
 
+Core::InstructionRegister::State Core::InstructionRegister::getState() const {
+    return {value, readOnClock};
+}
+
+void Core::InstructionRegister::setState(const State &state) {
+    value = state.value;
+    readOnClock = state.readOnClock;
+
+    notifyObserver();
+}
+
 void Core::InstructionRegister::setObserver(const std::shared_ptr<ValueObserver> &newObserver) {
     observer = newObserver;
 }
+
+void Core::InstructionRegister::setNotifyEveryWrite(const bool everyWrite) {
+    changeFilter.setEveryWrite(everyWrite);
+}
+
+Core::ChangeFilter::Statistics Core::InstructionRegister::getNotificationStatistics() const {
+    return changeFilter.getStatistics();
+}
@@ -4,6 +4,7 @@
 #include <memory>
 
 #include "Bus.h"
+#include "ChangeFilter.h"
 #include "ClockListener.h"
 #include "ValueObserver.h"
 
@@ -20,6 +21,12 @@ namespace Core {
     class InstructionRegister: public ClockListener {
 
     public:
+        /** Everything needed to put this register back the way it was, including pending reads from the clock. */
+        struct State {
+            uint8_t value;
+            bool readOnClock;
+        };
+
         explicit InstructionRegister(const std::shared_ptr<Bus> &bus);
         ~InstructionRegister();
 
@@ -38,18 +45,31 @@ namespace Core {
         /** Get the 4-bit opcode from the instruction.  */
         [[nodiscard]] virtual uint8_t getOpcode() const;
 
+        /** Get a copy of the current state. */
+        [[nodiscard]] State getState() const;
+
+        /** Put back a state from getState(), and notify the observer. */
+        void setState(const State &state);
+
         /** Set an optional external observer of this register. */
         void setObserver(const std::shared_ptr<ValueObserver> &newObserver);
 
+        /** Notify the observer of every write, instead of only when the value changes. Off by default. */
+        void setNotifyEveryWrite(bool everyWrite);
+
+        /** How many notifications to the observer were passed on or skipped. */
+        [[nodiscard]] ChangeFilter::Statistics getNotificationStatistics() const;
+
     private:
         std::shared_ptr<Bus> bus;
         std::shared_ptr<ValueObserver> observer;
+        ChangeFilter changeFilter;
         uint8_t value;
         bool readOnClock;
 
         void readFromBus();
         void writeToBus();
-        void notifyObserver() const;
+        void notifyObserver();
 
         void clockTicked() override;
         void invertedClockTicked() override {}; // Not implemented
@@ -2,14 +2,17 @@
 
 #include "Instructions.h"
 
-Core::Instructions::Instruction Core::Instructions::find(const std::string& mnemonic) {
-    for (Instruction candidate : Instructions::ALL) {
-        if (mnemonic == candidate.mnemonic) {
-            return candidate;
-        }
+constexpr std::array<Core::Instructions::Instruction, Core::Instructions::HASH_TABLE_SIZE>
+        Core::Instructions::HASH_TABLE = Core::Instructions::buildHashTable();
+
+Core::Instructions::Instruction Core::Instructions::find(const std::string_view mnemonic) {
+    if (mnemonic.empty()) {
+        return UNKNOWN;
     }
 
-    return UNKNOWN;
+    const Instruction candidate = HASH_TABLE[hash(mnemonic)];
+
+    return candidate.mnemonic == mnemonic ? candidate : UNKNOWN;
 }
 
 std::bitset<4> Core::Instructions::noOperand() {
@@ -3,8 +3,8 @@
 
 #include <array>
 #include <bitset>
-#include <map>
-#include <string>
+#include <stdexcept>
+#include <string_view>
 
 namespace Core {
 
@@ -24,7 +24,7 @@ namespace Core {
             }
 
             constexpr bool operator==(Instruction id) const { return opcode == id.opcode && mnemonic == id.mnemonic; }
-            constexpr bool operator!=(Instruction id) const { return opcode == id.opcode && mnemonic == id.mnemonic; }
+            constexpr bool operator!=(Instruction id) const { return !(*this == id); }
         };
 
         /** No operation */
@@ -52,11 +52,44 @@ namespace Core {
         /** Unknown instruction */
         static constexpr Instruction UNKNOWN = {"UNKNOWN", 0, false};
 
-        static Instruction find(const std::string& mnemonic);
+        /** Find the instruction with the mnemonic, or UNKNOWN. A single lookup in a perfect hash table. */
+        static Instruction find(std::string_view mnemonic);
         static std::bitset<4> noOperand();
 
     private:
         static constexpr std::array<Instruction, 11> ALL = {NOP, LDA, ADD, SUB, STA, LDI, JMP, JC, JZ, OUT, HLT};
+
+        static constexpr size_t HASH_TABLE_SIZE = 16;
+
+        /** Gives a different slot for each of the mnemonics in ALL. Must not be empty. */
+        static constexpr size_t hash(const std::string_view mnemonic) {
+            return ((unsigned char) mnemonic.front() * 5 + (unsigned char) mnemonic.back() + mnemonic.size()) %
+                   HASH_TABLE_SIZE;
+        }
+
+        /** All the instructions in the slot from hash(), and UNKNOWN in the rest. */
+        static constexpr std::array<Instruction, HASH_TABLE_SIZE> buildHashTable() {
+            std::array<Instruction, HASH_TABLE_SIZE> table = {};
+
+            for (auto &slot : table) {
+                slot = UNKNOWN;
+            }
+
+            for (const auto &instruction : ALL) {
+                Instruction &slot = table[hash(instruction.mnemonic)];
+
+                // Fails to compile if two mnemonics end up in the same slot
+                if (slot != UNKNOWN) {
+                    throw std::logic_error("Instructions: hash is not perfect");
+                }
+
+                slot = instruction;
+            }
+
+            return table;
+        }
+
+        static const std::array<Instruction, HASH_TABLE_SIZE> HASH_TABLE;
     };
 }
 
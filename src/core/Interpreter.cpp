@@ -0,0 +1,95 @@
+#include "Instructions.h"
+
+#include "Interpreter.h"
+
+bool Core::Interpreter::State::operator==(const State &other) const {
+    return memory == other.memory &&
+           aRegister == other.aRegister &&
+           bRegister == other.bRegister &&
+           programCounter == other.programCounter &&
+           outputRegister == other.outputRegister &&
+           carryFlag == other.carryFlag &&
+           zeroFlag == other.zeroFlag &&
+           halted == other.halted &&
+           failed == other.failed;
+}
+
+bool Core::Interpreter::State::operator!=(const State &other) const {
+    return !(*this == other);
+}
+
+Core::Interpreter::State Core::Interpreter::initialState(const MemoryImage &memory) {
+    State state;
+    state.memory = memory;
+
+    return state;
+}
+
+int Core::Interpreter::step(State &state) {
+    if (state.halted || state.failed) {
+        return 0;
+    }
+
+    const uint8_t instruction = state.memory[state.programCounter];
+    const uint8_t opcode = instruction >> 4; // First 4 bits
+    const uint8_t operand = instruction & 0x0F; // Last 4 bits
+
+    // Fetch
+    state.programCounter = (state.programCounter + 1) % 16;
+
+    // Execute
+    switch (opcode) {
+        case Instructions::NOP.opcode:
+            break;
+        case Instructions::LDA.opcode:
+            state.aRegister = state.memory[operand];
+            break;
+        case Instructions::ADD.opcode: {
+            state.bRegister = state.memory[operand];
+            const uint16_t result = state.aRegister + state.bRegister;
+            state.aRegister = result;
+            state.carryFlag = result > 255;
+            state.zeroFlag = state.aRegister == 0;
+            break;
+        }
+        case Instructions::SUB.opcode: {
+            // Two's complement, the same way as the ArithmeticLogicUnit
+            state.bRegister = state.memory[operand];
+            const uint16_t result = state.aRegister + (uint8_t) -(unsigned int) state.bRegister;
+            state.aRegister = result;
+            state.carryFlag = result > 255;
+            state.zeroFlag = state.aRegister == 0;
+            break;
+        }
+        case Instructions::STA.opcode:
+            state.memory[operand] = state.aRegister;
+            break;
+        case Instructions::LDI.opcode:
+            state.aRegister = operand;
+            break;
+        case Instructions::JMP.opcode:
+            state.programCounter = operand;
+            break;
+        case Instructions::JC.opcode:
+            if (state.carryFlag) {
+                state.programCounter = operand;
+            }
+            break;
+        case Instructions::JZ.opcode:
+            if (state.zeroFlag) {
+                state.programCounter = operand;
+            }
+            break;
+        case Instructions::OUT.opcode:
+            state.outputRegister = state.aRegister;
+            break;
+        case Instructions::HLT.opcode:
+            state.halted = true;
+            return HALT_CYCLES;
+        default:
+            state.failed = true;
+            return HALT_CYCLES;
+    }
+
+    return INSTRUCTION_CYCLES;
+}
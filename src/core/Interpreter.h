@@ -0,0 +1,58 @@
+#ifndef INC_8_BIT_COMPUTER_EMULATOR_INTERPRETER_H
+#define INC_8_BIT_COMPUTER_EMULATOR_INTERPRETER_H
+
+#include "MemoryImage.h"
+
+namespace Core {
+
+    /**
+     * Static class with an instruction level model of the computer.
+     *
+     * Where the Emulator replicates the communication between the parts on every clock cycle, this executes
+     * a whole instruction at a time directly on a small state, without any bus, control lines or clock.
+     * The result after each instruction is the same as in the Emulator, and the clock cycles are counted
+     * the same way. This makes it a lot faster, and useful for searching through large numbers of programs.
+     *
+     * The state only includes what is visible between instructions. The bus, the ALU and the step counter
+     * can be derived from the rest at that point.
+     */
+    class Interpreter {
+
+    public:
+        /** Every instruction takes 5 clock cycles, one for each step in the InstructionDecoder. */
+        static const int INSTRUCTION_CYCLES = 5;
+
+        /** The clock stops during the third step of HLT, after 2 clock cycles. Unknown opcodes fail there too. */
+        static const int HALT_CYCLES = 2;
+
+        struct State {
+            MemoryImage memory{};
+            uint8_t aRegister = 0;
+            uint8_t bRegister = 0;
+            uint8_t programCounter = 0;
+            uint8_t outputRegister = 0;
+            bool carryFlag = false;
+            bool zeroFlag = false;
+            bool halted = false;
+            bool failed = false;
+
+            bool operator==(const State &other) const;
+            bool operator!=(const State &other) const;
+        };
+
+        Interpreter() = delete;
+        ~Interpreter() = delete;
+
+        /** The state of the computer right after loading a program with the specified memory. */
+        static State initialState(const MemoryImage &memory);
+
+        /**
+         * Execute the instruction at the program counter, and return the number of clock cycles it took.
+         * Does nothing if the computer is halted or has failed. An unknown opcode sets the failed flag,
+         * like the InstructionDecoder throws an exception.
+         */
+        static int step(State &state);
+    };
+}
+
+#endif //INC_8_BIT_COMPUTER_EMULATOR_INTERPRETER_H
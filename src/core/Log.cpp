@@ -0,0 +1,196 @@
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+
+#include "Utils.h"
+
+#include "Log.h"
+
+namespace {
+
+    /** How long the background thread sleeps when there is nothing to write. */
+    const std::chrono::milliseconds IDLE_TIME(1);
+
+    /**
+     * The slots go round in order. Each has a sequence number that tells whose turn it is: the position
+     * of the next message to write into it, or that position + 1 when the message is ready to be written out.
+     */
+    struct Slot {
+        std::atomic<size_t> sequence;
+        size_t length;
+        char text[Core::Log::MESSAGE_SIZE];
+    };
+
+    class Sink {
+
+    public:
+        Sink() {
+            for (size_t i = 0; i < slots.size(); i++) {
+                slots[i].sequence.store(i, std::memory_order_relaxed);
+            }
+
+            // Never stopped, but everything still queued at exit is written first
+            std::thread(&Sink::writeLoop, this).detach();
+            std::atexit(Core::Log::flush);
+        }
+
+        /** A slot for the message, or nullptr when the buffer is full. */
+        Slot *claim(size_t &position) {
+            position = enqueuePosition.load(std::memory_order_relaxed);
+
+            while (true) {
+                Slot &slot = slots[position & MASK];
+                const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+                const auto difference = (std::ptrdiff_t) (sequence - position);
+
+                if (difference == 0) {
+                    if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                        pending.fetch_add(1, std::memory_order_relaxed);
+                        return &slot;
+                    }
+                } else if (difference < 0) {
+                    dropped.fetch_add(1, std::memory_order_relaxed);
+                    return nullptr;
+                } else {
+                    position = enqueuePosition.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        static void publish(Slot *slot, const size_t position) {
+            slot->sequence.store(position + 1, std::memory_order_release);
+        }
+
+        std::atomic<unsigned long> pending{0};
+        std::atomic<unsigned long> dropped{0};
+
+    private:
+        static const size_t MASK = Core::Log::CAPACITY - 1;
+
+        std::array<Slot, Core::Log::CAPACITY> slots;
+        std::atomic<size_t> enqueuePosition{0};
+        size_t dequeuePosition = 0;
+        unsigned long droppedReported = 0;
+
+        void writeLoop() {
+            while (true) {
+                bool written = false;
+
+                while (true) {
+                    Slot &slot = slots[dequeuePosition & MASK];
+
+                    if (slot.sequence.load(std::memory_order_acquire) != dequeuePosition + 1) {
+                        break;
+                    }
+
+                    fwrite(slot.text, 1, slot.length, stdout);
+                    slot.sequence.store(dequeuePosition + Core::Log::CAPACITY, std::memory_order_release);
+                    dequeuePosition++;
+                    pending.fetch_sub(1, std::memory_order_release);
+                    written = true;
+                }
+
+                const unsigned long droppedNow = dropped.load(std::memory_order_relaxed);
+
+                if (droppedNow != droppedReported) {
+                    fprintf(stdout, "Log: dropped %lu messages\n", droppedNow - droppedReported);
+                    droppedReported = droppedNow;
+                    written = true;
+                }
+
+                if (written) {
+                    fflush(stdout);
+                } else {
+                    std::this_thread::sleep_for(IDLE_TIME);
+                }
+            }
+        }
+    };
+
+    std::atomic<bool> quietMode{false};
+    std::atomic<Sink *> sinkInstance{nullptr};
+    std::once_flag sinkStarted;
+
+    Sink &sink() {
+        Sink *instance = sinkInstance.load(std::memory_order_acquire);
+
+        if (instance == nullptr) {
+            // Lives until the process exits, since messages can come from any thread at any time
+            std::call_once(sinkStarted, [] { sinkInstance.store(new Sink(), std::memory_order_release); });
+            instance = sinkInstance.load(std::memory_order_acquire);
+        }
+
+        return *instance;
+    }
+}
+
+void Core::Log::printf(const char *format, ...) {
+    if (quietMode.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    va_list arguments;
+    va_start(arguments, format);
+
+    if (Utils::debugL1()) {
+        vprintf(format, arguments);
+        va_end(arguments);
+        return;
+    }
+
+    Sink &messages = sink();
+    size_t position;
+    Slot *slot = messages.claim(position);
+
+    if (slot != nullptr) {
+        const int length = vsnprintf(slot->text, MESSAGE_SIZE, format, arguments);
+
+        if (length < 0) {
+            slot->length = 0;
+        } else if ((size_t) length >= MESSAGE_SIZE) {
+            slot->length = MESSAGE_SIZE - 1;
+            slot->text[MESSAGE_SIZE - 2] = '\n';
+        } else {
+            slot->length = length;
+        }
+
+        Sink::publish(slot, position);
+    }
+
+    va_end(arguments);
+}
+
+void Core::Log::println(const std::string &message) {
+    printf("%s\n", message.c_str());
+}
+
+void Core::Log::setQuiet(const bool quiet) {
+    quietMode.store(quiet, std::memory_order_relaxed);
+}
+
+bool Core::Log::isQuiet() {
+    return quietMode.load(std::memory_order_relaxed);
+}
+
+void Core::Log::flush() {
+    Sink *instance = sinkInstance.load(std::memory_order_acquire);
+
+    if (instance != nullptr) {
+        while (instance->pending.load(std::memory_order_acquire) > 0) {
+            std::this_thread::sleep_for(IDLE_TIME);
+        }
+    }
+
+    fflush(stdout);
+}
+
+unsigned long Core::Log::getDropped() {
+    Sink *instance = sinkInstance.load(std::memory_order_acquire);
+
+    return instance == nullptr ? 0 : instance->dropped.load(std::memory_order_relaxed);
+}
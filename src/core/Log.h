@@ -0,0 +1,48 @@
+#ifndef INC_8_BIT_COMPUTER_EMULATOR_LOG_H
+#define INC_8_BIT_COMPUTER_EMULATOR_LOG_H
+
+#include <cstddef>
+#include <string>
+
+namespace Core {
+
+    /**
+     * Messages from the emulator while it runs, like the display and the values of the components.
+     *
+     * A message is formatted straight into a slot in a fixed size ring buffer, claimed with a compare and swap,
+     * and a background thread writes the slots to standard out. The clock thread never waits for the terminal,
+     * or for a lock. When the buffer is full the message is dropped, and the number dropped is written
+     * when there is room again.
+     *
+     * In quiet mode nothing is formatted or queued at all. With debug logs enabled the messages are written
+     * right away instead, to keep them in order with the debug logs.
+     */
+    class Log {
+
+    public:
+        /** Number of messages that can wait for the background thread. Must be a power of 2. */
+        static const size_t CAPACITY = 4096;
+
+        /** Longer messages are cut off. */
+        static const size_t MESSAGE_SIZE = 128;
+
+        /** Format the message like printf, and queue it. Safe to call from any number of threads. */
+        static void printf(const char *format, ...) __attribute__((format(printf, 1, 2)));
+
+        /** Queue the message, with a newline. */
+        static void println(const std::string &message);
+
+        /** Stop logging altogether, for runs where the output would only slow things down. */
+        static void setQuiet(bool quiet);
+
+        [[nodiscard]] static bool isQuiet();
+
+        /** Wait until every message queued so far is written. */
+        static void flush();
+
+        /** Number of messages dropped because the buffer was full. */
+        [[nodiscard]] static unsigned long getDropped();
+    };
+}
+
+#endif //INC_8_BIT_COMPUTER_EMULATOR_LOG_H
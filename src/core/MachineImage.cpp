@@ -0,0 +1,175 @@
+#include <fstream>
+#include <iterator>
+
+#include "Utils.h"
+
+#include "MachineImage.h"
+
+namespace {
+    const char MAGIC[] = {'8', 'B', 'I', 'M'};
+    const char EXTENSION[] = ".8bim";
+}
+
+bool Core::MachineImage::Symbol::operator==(const Symbol &other) const {
+    return name == other.name && address == other.address;
+}
+
+std::vector<uint8_t> Core::MachineImage::toBytes(const Program &program) {
+    if (program.entry.programCounter > Utils::FOUR_BITS_MAX) {
+        throw std::runtime_error("MachineImage: entry address out of bounds " +
+                                 std::to_string(program.entry.programCounter));
+    }
+
+    if (program.symbols.size() > 255) {
+        throw std::runtime_error("MachineImage: too many symbols " + std::to_string(program.symbols.size()));
+    }
+
+    std::vector<uint8_t> body(program.memory.begin(), program.memory.end());
+    body.push_back(program.entry.programCounter);
+    body.push_back(program.entry.aRegister);
+    body.push_back(program.entry.bRegister);
+    body.push_back(program.symbols.size());
+
+    for (const Symbol &symbol : program.symbols) {
+        if (symbol.name.empty() || symbol.name.length() > MAX_SYMBOL_LENGTH) {
+            throw std::runtime_error("MachineImage: invalid symbol name length " +
+                                     std::to_string(symbol.name.length()));
+        }
+
+        if (symbol.address > Utils::FOUR_BITS_MAX) {
+            throw std::runtime_error("MachineImage: symbol address out of bounds " +
+                                     std::to_string(symbol.address));
+        }
+
+        body.push_back(symbol.address);
+        body.push_back(symbol.name.length());
+        body.insert(body.end(), symbol.name.begin(), symbol.name.end());
+    }
+
+    if (body.size() > 0xFFFF) {
+        throw std::runtime_error("MachineImage: too large " + std::to_string(body.size()));
+    }
+
+    const uint32_t checksum = Utils::crc32(body.data(), body.size());
+
+    std::vector<uint8_t> bytes(MAGIC, MAGIC + sizeof(MAGIC));
+    bytes.push_back(VERSION);
+    bytes.push_back(program.memory.size());
+    bytes.push_back(body.size() & 0xFF);
+    bytes.push_back(body.size() >> 8);
+
+    for (int i = 0; i < 4; i++) {
+        bytes.push_back(checksum >> (i * 8));
+    }
+
+    bytes.insert(bytes.end(), body.begin(), body.end());
+
+    return bytes;
+}
+
+Core::MachineImage::Program Core::MachineImage::fromBytes(const std::vector<uint8_t> &bytes) {
+    if (bytes.size() < HEADER_SIZE || !std::equal(MAGIC, MAGIC + sizeof(MAGIC), bytes.begin())) {
+        throw std::runtime_error("MachineImage: not a machine image");
+    }
+
+    if (bytes[4] != VERSION) {
+        throw std::runtime_error("MachineImage: unsupported version " + std::to_string(bytes[4]));
+    }
+
+    Program program{};
+
+    if (bytes[5] != program.memory.size()) {
+        throw std::runtime_error("MachineImage: unsupported memory size " + std::to_string(bytes[5]));
+    }
+
+    const size_t bodySize = bytes[6] | bytes[7] << 8;
+    const uint32_t checksum = bytes[8] | bytes[9] << 8 | bytes[10] << 16 | (uint32_t) bytes[11] << 24;
+
+    if (bytes.size() != HEADER_SIZE + bodySize) {
+        throw std::runtime_error("MachineImage: wrong size");
+    }
+
+    const uint8_t *body = bytes.data() + HEADER_SIZE;
+
+    if (Utils::crc32(body, bodySize) != checksum) {
+        throw std::runtime_error("MachineImage: checksum mismatch");
+    }
+
+    // Everything is checked against the body size before it's read, so a bad image can't read past the end
+    const size_t fixedSize = program.memory.size() + 4;
+
+    if (bodySize < fixedSize) {
+        throw std::runtime_error("MachineImage: wrong size");
+    }
+
+    std::copy(body, body + program.memory.size(), program.memory.begin());
+    size_t position = program.memory.size();
+
+    program.entry.programCounter = body[position++];
+    program.entry.aRegister = body[position++];
+    program.entry.bRegister = body[position++];
+
+    if (program.entry.programCounter > Utils::FOUR_BITS_MAX) {
+        throw std::runtime_error("MachineImage: entry address out of bounds " +
+                                 std::to_string(program.entry.programCounter));
+    }
+
+    const uint8_t symbolCount = body[position++];
+
+    for (int i = 0; i < symbolCount; i++) {
+        if (position + 2 > bodySize) {
+            throw std::runtime_error("MachineImage: wrong size");
+        }
+
+        const uint8_t address = body[position++];
+        const uint8_t length = body[position++];
+
+        if (position + length > bodySize) {
+            throw std::runtime_error("MachineImage: wrong size");
+        }
+
+        if (address > Utils::FOUR_BITS_MAX) {
+            throw std::runtime_error("MachineImage: symbol address out of bounds " + std::to_string(address));
+        }
+
+        program.symbols.push_back({std::string(body + position, body + position + length), address});
+        position += length;
+    }
+
+    if (position != bodySize) {
+        throw std::runtime_error("MachineImage: wrong size");
+    }
+
+    return program;
+}
+
+void Core::MachineImage::save(const std::string &fileName, const Program &program) {
+    const std::vector<uint8_t> bytes = toBytes(program);
+    std::ofstream file(fileName, std::ios::binary);
+
+    if (!file.is_open()) {
+        throw std::runtime_error("MachineImage: failed to open file: " + fileName);
+    }
+
+    file.write(reinterpret_cast<const char *>(bytes.data()), bytes.size());
+
+    if (!file) {
+        throw std::runtime_error("MachineImage: failed to write file: " + fileName);
+    }
+}
+
+Core::MachineImage::Program Core::MachineImage::load(const std::string &fileName) {
+    std::ifstream file(fileName, std::ios::binary);
+
+    if (!file.is_open()) {
+        throw std::runtime_error("MachineImage: failed to open file: " + fileName);
+    }
+
+    const std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    return fromBytes(bytes);
+}
+
+bool Core::MachineImage::isImageFile(const std::string &fileName) {
+    return Utils::endsWith(fileName, EXTENSION);
+}
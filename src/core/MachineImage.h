@@ -0,0 +1,78 @@
+#ifndef INC_8_BIT_COMPUTER_EMULATOR_MACHINEIMAGE_H
+#define INC_8_BIT_COMPUTER_EMULATOR_MACHINEIMAGE_H
+
+#include <string>
+#include <vector>
+
+#include "MemoryImage.h"
+
+namespace Core {
+
+    /**
+     * Static class for reading and writing programs that are already assembled, as files of type .8bim.
+     * Loading one is a validated copy of the memory, without any assembling.
+     *
+     * The format, with numbers in little endian:
+     *
+     * - 4 bytes: magic "8BIM"
+     * - 1 byte: format version
+     * - 1 byte: size of the memory image
+     * - 2 bytes: size of the body, which is everything after the header
+     * - 4 bytes: CRC-32 of the body
+     * - Body:
+     *   - 16 bytes: the memory image
+     *   - 3 bytes: entry values of the program counter, A-register and B-register
+     *   - 1 byte: number of symbols, followed by each symbol as 1 byte address, 1 byte length and the name
+     */
+    class MachineImage {
+
+    public:
+        static constexpr uint8_t VERSION = 1;
+
+        /** A name for an address, like the variable stored there. */
+        struct Symbol {
+            std::string name;
+            uint8_t address;
+
+            bool operator==(const Symbol &other) const;
+        };
+
+        /** The values of the registers when the program starts, instead of 0. */
+        struct Entry {
+            uint8_t programCounter;
+            uint8_t aRegister;
+            uint8_t bRegister;
+        };
+
+        /** A program ready to put in memory. */
+        struct Program {
+            MemoryImage memory;
+            Entry entry;
+            std::vector<Symbol> symbols;
+        };
+
+        MachineImage() = delete;
+        ~MachineImage() = delete;
+
+        /** Convert the program to bytes in the image format. */
+        static std::vector<uint8_t> toBytes(const Program &program);
+
+        /** Convert bytes in the image format back to a program. Throws exception if the format is wrong. */
+        static Program fromBytes(const std::vector<uint8_t> &bytes);
+
+        /** Write the program to an image file. */
+        static void save(const std::string &fileName, const Program &program);
+
+        /** Read a program from an image file. */
+        static Program load(const std::string &fileName);
+
+        /** Whether the file name has the extension of image files. */
+        static bool isImageFile(const std::string &fileName);
+
+    private:
+        static const int HEADER_SIZE = 12;
+        static const int MAX_SYMBOL_LENGTH = 255;
+    };
+}
+
+#endif //INC_8_BIT_COMPUTER_EMULATOR_MACHINEIMAGE_H
@@ -1,6 +1,7 @@
 #include <iostream>
 #include <string>
 
+#include "Log.h"
 #include "Utils.h"
 
 #include "MemoryAddressRegister.h"
@@ -42,7 +43,7 @@ void Core::MemoryAddressRegister::readFromBus() {
 }
 
 void Core::MemoryAddressRegister::print() const {
-    printf("MemoryAddressRegister: %d / 0x%02X / " BIT_4_PATTERN " \n", value, value, BIT_4_TO_BINARY(value));
+    Log::printf("MemoryAddressRegister: %d / 0x%02X / " BIT_4_PATTERN " \n", value, value, BIT_4_TO_BINARY(value));
 }
 
 void Core::MemoryAddressRegister::reset() {
@@ -79,8 +80,8 @@ void Core::MemoryAddressRegister::clockTicked() {
     }
 }
 
-void Core::MemoryAddressRegister::notifyObserver() const {
-    if (observer != nullptr) {
+void Core::MemoryAddressRegister::notifyObserver() {
+    if (Utils::OBSERVED && observer != nullptr && changeFilter.shouldPass(value)) {
         observer->valueUpdated(value);
     }
 }
@@ -89,6 +90,25 @@ void Core::MemoryAddressRegister::notifyListener() const {
     registerListener->registerValueChanged(value);
 }
 
+Core::MemoryAddressRegister::State Core::MemoryAddressRegister::getState() const {
+    return {value, readOnClock};
+}
+
+void Core::MemoryAddressRegister::setState(const State &state) {
+    value = state.value;
+    readOnClock = state.readOnClock;
+
+    notifyObserver();
+}
+
 void Core::MemoryAddressRegister::setObserver(const std::shared_ptr<ValueObserver> &newObserver) {
     observer = newObserver;
 }
+
+void Core::MemoryAddressRegister::setNotifyEveryWrite(const bool everyWrite) {
+    changeFilter.setEveryWrite(everyWrite);
+}
+
+Core::ChangeFilter::Statistics Core::MemoryAddressRegister::getNotificationStatistics() const {
+    return changeFilter.getStatistics();
+}
@@ -5,6 +5,7 @@
 #include <memory>
 
 #include "Bus.h"
+#include "ChangeFilter.h"
 #include "ClockListener.h"
 #include "RegisterListener.h"
 
@@ -20,6 +21,12 @@ namespace Core {
     class MemoryAddressRegister: public ClockListener {
 
     public:
+        /** Everything needed to put this register back the way it was, including pending reads from the clock. */
+        struct State {
+            uint8_t value;
+            bool readOnClock;
+        };
+
         MemoryAddressRegister(const std::shared_ptr<RegisterListener> &registerListener,
                               const std::shared_ptr<Bus> &bus);
         ~MemoryAddressRegister();
@@ -36,18 +43,31 @@ namespace Core {
         /** Take a 4-bit value from the bus on next clock tick. */
         virtual void in();
 
+        /** Get a copy of the current state. */
+        [[nodiscard]] State getState() const;
+
+        /** Put back a state from getState(). Notifies the observer, but not the listener. */
+        void setState(const State &state);
+
         /** Set an optional external observer of this register. */
         void setObserver(const std::shared_ptr<ValueObserver> &newObserver);
 
+        /** Notify the observer of every write, instead of only when the value changes. Off by default. */
+        void setNotifyEveryWrite(bool everyWrite);
+
+        /** How many notifications to the observer were passed on or skipped. */
+        [[nodiscard]] ChangeFilter::Statistics getNotificationStatistics() const;
+
     private:
         std::shared_ptr<RegisterListener> registerListener;
         std::shared_ptr<Bus> bus;
         std::shared_ptr<ValueObserver> observer;
+        ChangeFilter changeFilter;
         uint8_t value;
         bool readOnClock;
 
         void readFromBus();
-        void notifyObserver() const;
+        void notifyObserver();
         void notifyListener() const;
 
         void clockTicked() override;
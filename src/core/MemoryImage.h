@@ -0,0 +1,13 @@
+#ifndef INC_8_BIT_COMPUTER_EMULATOR_MEMORYIMAGE_H
+#define INC_8_BIT_COMPUTER_EMULATOR_MEMORYIMAGE_H
+
+#include <array>
+#include <cstdint>
+
+namespace Core {
+
+    /** The contents of all the 16 bytes of memory, with the address as index. */
+    using MemoryImage = std::array<uint8_t, 16>;
+}
+
+#endif //INC_8_BIT_COMPUTER_EMULATOR_MEMORYIMAGE_H
@@ -0,0 +1,60 @@
+#include <iostream>
+
+#include "Utils.h"
+
+#include "MemoryOutputSink.h"
+
+Core::MemoryOutputSink::MemoryOutputSink(const size_t capacity) {
+    if (Utils::debugL2()) {
+        std::cout << "MemoryOutputSink construct" << std::endl;
+    }
+
+    if (capacity == 0) {
+        throw std::runtime_error("MemoryOutputSink: capacity must be at least 1");
+    }
+
+    this->capacity = capacity;
+    this->count = 0;
+}
+
+Core::MemoryOutputSink::~MemoryOutputSink() {
+    if (Utils::debugL2()) {
+        std::cout << "MemoryOutputSink destruct" << std::endl;
+    }
+}
+
+void Core::MemoryOutputSink::outputsWritten(const Output *newOutputs, const size_t newCount) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (size_t i = 0; i < newCount; i++) {
+        if (outputs.size() < capacity) {
+            outputs.push_back(newOutputs[i]);
+        } else {
+            outputs[count % capacity] = newOutputs[i];
+        }
+
+        count++;
+    }
+}
+
+std::vector<Core::Output> Core::MemoryOutputSink::getOutputs() const {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (outputs.size() < capacity) {
+        return outputs;
+    }
+
+    // The oldest is the next one to be overwritten
+    std::vector<Output> ordered;
+    ordered.reserve(capacity);
+    ordered.insert(ordered.end(), outputs.begin() + count % capacity, outputs.end());
+    ordered.insert(ordered.end(), outputs.begin(), outputs.begin() + count % capacity);
+
+    return ordered;
+}
+
+unsigned long Core::MemoryOutputSink::getCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    return count;
+}
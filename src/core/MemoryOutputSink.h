@@ -0,0 +1,39 @@
+#ifndef INC_8_BIT_COMPUTER_EMULATOR_MEMORYOUTPUTSINK_H
+#define INC_8_BIT_COMPUTER_EMULATOR_MEMORYOUTPUTSINK_H
+
+#include <mutex>
+#include <vector>
+
+#include "OutputSink.h"
+
+namespace Core {
+
+    /**
+     * Keeps the latest outputs in memory, in a ring of fixed size, so a program that never stops
+     * outputting doesn't use more and more memory. Older outputs are overwritten, but still counted.
+     * Safe to read from any thread while the outputs are coming in.
+     */
+    class MemoryOutputSink: public OutputSink {
+
+    public:
+        /** Keep at most capacity outputs. */
+        explicit MemoryOutputSink(size_t capacity);
+        ~MemoryOutputSink() override;
+
+        void outputsWritten(const Output *outputs, size_t count) override;
+
+        /** The outputs kept, oldest first. */
+        [[nodiscard]] std::vector<Output> getOutputs() const;
+
+        /** The number of outputs written, including those no longer kept. */
+        [[nodiscard]] unsigned long getCount() const;
+
+    private:
+        mutable std::mutex mutex;
+        std::vector<Output> outputs;
+        size_t capacity;
+        unsigned long count;
+    };
+}
+
+#endif //INC_8_BIT_COMPUTER_EMULATOR_MEMORYOUTPUTSINK_H
@@ -0,0 +1,23 @@
+#ifndef INC_8_BIT_COMPUTER_EMULATOR_OUTPUTCOLLECTOR_H
+#define INC_8_BIT_COMPUTER_EMULATOR_OUTPUTCOLLECTOR_H
+
+#include <cstdint>
+#include <vector>
+
+#include "ValueObserver.h"
+
+namespace Core {
+
+    /** Collects the values written to the output register during a run. */
+    class OutputCollector: public ValueObserver {
+
+    public:
+        std::vector<uint8_t> values;
+
+        void valueUpdated(const uint8_t newValue) override {
+            values.push_back(newValue);
+        }
+    };
+}
+
+#endif //INC_8_BIT_COMPUTER_EMULATOR_OUTPUTCOLLECTOR_H
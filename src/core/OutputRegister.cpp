@@ -1,5 +1,6 @@
 #include <iostream>
 
+#include "Log.h"
 #include "Utils.h"
 
 #include "OutputRegister.h"
@@ -30,13 +31,17 @@ void Core::OutputRegister::readFromBus() {
 
     value = busValue;
 
-    std::cout << "*** Display: " << (int) value << std::endl;
+    Log::printf("*** Display: %d\n", value);
+
+    if (outputStream != nullptr) {
+        outputStream->write(value);
+    }
 
     notifyObserver();
 }
 
 void Core::OutputRegister::print() const {
-    printf("OutputRegister: %d / 0x%02X / " BYTE_PATTERN " \n", value, value, BYTE_TO_BINARY(value));
+    Log::printf("OutputRegister: %d / 0x%02X / " BYTE_PATTERN " \n", value, value, BYTE_TO_BINARY(value));
 }
 
 void Core::OutputRegister::reset() {
@@ -64,12 +69,35 @@ void Core::OutputRegister::clockTicked() {
     }
 }
 
-void Core::OutputRegister::notifyObserver() const {
-    if (observer != nullptr) {
+void Core::OutputRegister::notifyObserver() {
+    if (Utils::OBSERVED && observer != nullptr && changeFilter.shouldPass(value)) {
         observer->valueUpdated(value);
     }
 }
 
+Core::OutputRegister::State Core::OutputRegister::getState() const {
+    return {value, readOnClock};
+}
+
+void Core::OutputRegister::setState(const State &state) {
+    value = state.value;
+    readOnClock = state.readOnClock;
+
+    notifyObserver();
+}
+
 void Core::OutputRegister::setObserver(const std::shared_ptr<ValueObserver> &newObserver) {
     observer = newObserver;
 }
+
+void Core::OutputRegister::setNotifyEveryWrite(const bool everyWrite) {
+    changeFilter.setEveryWrite(everyWrite);
+}
+
+Core::ChangeFilter::Statistics Core::OutputRegister::getNotificationStatistics() const {
+    return changeFilter.getStatistics();
+}
+
+void Core::OutputRegister::setOutputStream(const std::shared_ptr<OutputStream> &newOutputStream) {
+    outputStream = newOutputStream;
+}
@@ -4,7 +4,9 @@
 #include <memory>
 
 #include "Bus.h"
+#include "ChangeFilter.h"
 #include "ClockListener.h"
+#include "OutputStream.h"
 #include "ValueObserver.h"
 
 namespace Core {
@@ -31,6 +33,12 @@ namespace Core {
     class OutputRegister: public ClockListener {
 
     public:
+        /** Everything needed to put this register back the way it was, including pending reads from the clock. */
+        struct State {
+            uint8_t value;
+            bool readOnClock;
+        };
+
         explicit OutputRegister(const std::shared_ptr<Bus> &bus);
         ~OutputRegister();
 
@@ -43,17 +51,34 @@ namespace Core {
         /** Take value from the bus on next clock tick. */
         virtual void in();
 
+        /** Get a copy of the current state. */
+        [[nodiscard]] State getState() const;
+
+        /** Put back a state from getState(), and notify the observer. */
+        void setState(const State &state);
+
         /** Set an optional external observer of this register. */
         void setObserver(const std::shared_ptr<ValueObserver> &newObserver);
 
+        /** Notify the observer of every write, instead of only when the value changes. Off by default. */
+        void setNotifyEveryWrite(bool everyWrite);
+
+        /** How many notifications to the observer were passed on or skipped. */
+        [[nodiscard]] ChangeFilter::Statistics getNotificationStatistics() const;
+
+        /** Set an optional stream for every value read from the bus, also when the observers are off. */
+        void setOutputStream(const std::shared_ptr<OutputStream> &newOutputStream);
+
     private:
         std::shared_ptr<Bus> bus;
         std::shared_ptr<ValueObserver> observer;
+        ChangeFilter changeFilter;
+        std::shared_ptr<OutputStream> outputStream;
         uint8_t value;
         bool readOnClock;
 
         void readFromBus();
-        void notifyObserver() const;
+        void notifyObserver();
 
         void clockTicked() override;
         void invertedClockTicked() override {}; // Not implemented
@@ -0,0 +1,30 @@
+#ifndef INC_8_BIT_COMPUTER_EMULATOR_OUTPUTSINK_H
+#define INC_8_BIT_COMPUTER_EMULATOR_OUTPUTSINK_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Core {
+
+    /** A value from the output register, as a small plain record. */
+    struct Output {
+        /** The clock cycle of the OUT, counted from when the sink was set. */
+        unsigned long cycle;
+        uint8_t value;
+    };
+
+    /**
+     * Interface for keeping everything the program outputs, like in memory, in a file, or in another process.
+     * Gets the outputs in batches from a thread of its own, so it's fine to be slow now and then.
+     */
+    class OutputSink {
+
+    public:
+        virtual ~OutputSink() = default;
+
+        /** The next outputs, in the order of the OUT instructions. */
+        virtual void outputsWritten(const Output *outputs, size_t count) = 0;
+    };
+}
+
+#endif //INC_8_BIT_COMPUTER_EMULATOR_OUTPUTSINK_H
@@ -0,0 +1,115 @@
+#include <array>
+#include <chrono>
+#include <iostream>
+
+#include "Utils.h"
+
+#include "OutputStream.h"
+
+namespace {
+    /** How long the drain thread sleeps when there is nothing in the queue. */
+    const std::chrono::milliseconds IDLE_TIME(1);
+}
+
+Core::OutputStream::OutputStream() : queue(CAPACITY) {
+    if (Utils::debugL2()) {
+        std::cout << "OutputStream construct" << std::endl;
+    }
+
+    this->overflow = Overflow::WAIT;
+    this->cycle = 0;
+    this->written = 0;
+    this->delivered = 0;
+    this->dropped = 0;
+    this->running = false;
+}
+
+Core::OutputStream::~OutputStream() {
+    if (Utils::debugL2()) {
+        std::cout << "OutputStream destruct" << std::endl;
+    }
+
+    stop();
+}
+
+void Core::OutputStream::setSink(const std::shared_ptr<OutputSink> &newSink, const Overflow newOverflow) {
+    stop();
+
+    sink = newSink;
+    overflow = newOverflow;
+    cycle = 0;
+    written = 0;
+    delivered = 0;
+    dropped = 0;
+
+    if (sink != nullptr) {
+        running = true;
+        drainThread = std::thread(&OutputStream::drainLoop, this);
+    }
+}
+
+bool Core::OutputStream::isStreaming() const {
+    return sink != nullptr;
+}
+
+void Core::OutputStream::write(const uint8_t value) {
+    if (sink == nullptr) {
+        return;
+    }
+
+    const Output output = {cycle, value};
+
+    if (overflow == Overflow::DROP) {
+        if (!queue.push(output)) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    } else {
+        while (!queue.push(output)) {
+            std::this_thread::yield();
+        }
+    }
+
+    written++;
+}
+
+void Core::OutputStream::flush() {
+    while (delivered.load(std::memory_order_acquire) != written) {
+        std::this_thread::sleep_for(IDLE_TIME);
+    }
+}
+
+unsigned long Core::OutputStream::getDropped() const {
+    return dropped.load(std::memory_order_relaxed);
+}
+
+void Core::OutputStream::invertedClockTicked() {
+    cycle++;
+}
+
+void Core::OutputStream::drainLoop() {
+    std::array<Output, BATCH_SIZE> batch{};
+
+    while (true) {
+        // Checked before taking from the queue, so everything written before stop() is still delivered
+        const bool stopping = !running.load(std::memory_order_acquire);
+        const size_t count = queue.pop(batch.data(), batch.size());
+
+        if (count > 0) {
+            sink->outputsWritten(batch.data(), count);
+            delivered.fetch_add(count, std::memory_order_release);
+        } else if (stopping) {
+            break;
+        } else {
+            std::this_thread::sleep_for(IDLE_TIME);
+        }
+    }
+}
+
+void Core::OutputStream::stop() {
+    running = false;
+
+    if (drainThread.joinable()) {
+        drainThread.join();
+    }
+}
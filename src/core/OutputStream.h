@@ -0,0 +1,78 @@
+#ifndef INC_8_BIT_COMPUTER_EMULATOR_OUTPUTSTREAM_H
+#define INC_8_BIT_COMPUTER_EMULATOR_OUTPUTSTREAM_H
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+#include "ClockListener.h"
+#include "OutputSink.h"
+#include "SpscQueue.h"
+
+namespace Core {
+
+    /**
+     * Takes the values from the output register to an output sink, with the clock cycle of each.
+     *
+     * The thread the emulator runs on only puts the output in a fixed size queue, and a thread of its own
+     * takes everything in the queue in one go and gives it to the sink. A slow sink, like a file or another
+     * process, then only holds up the clock when the queue is full, or not at all when dropping.
+     */
+    class OutputStream: public ClockListener {
+
+    public:
+        /** What to do with an output when the queue is full. */
+        enum class Overflow {
+            /** Wait for room, so no outputs are lost. */
+            WAIT,
+            /** Drop the output and count it, so the clock never waits. */
+            DROP
+        };
+
+        /** The number of outputs that can wait for the sink. */
+        static const size_t CAPACITY = 65536;
+
+        OutputStream();
+        ~OutputStream();
+
+        /**
+         * Set the sink, or nullptr to stop streaming. Everything for the last sink is delivered to it first.
+         * The cycles and the dropped outputs are counted from 0 again.
+         */
+        void setSink(const std::shared_ptr<OutputSink> &newSink, Overflow newOverflow);
+
+        /** Whether there is a sink to stream to. */
+        [[nodiscard]] bool isStreaming() const;
+
+        /** Queue an output at the current clock cycle. Only for the thread the emulator runs on. */
+        void write(uint8_t value);
+
+        /** Wait until the sink has everything written so far. */
+        void flush();
+
+        /** The number of outputs dropped because the queue was full. */
+        [[nodiscard]] unsigned long getDropped() const;
+
+        void clockTicked() override {} // Not implemented
+        void invertedClockTicked() override;
+
+    private:
+        /** The most outputs the sink gets at once. */
+        static const size_t BATCH_SIZE = 1024;
+
+        SpscQueue<Output> queue;
+        std::shared_ptr<OutputSink> sink;
+        Overflow overflow;
+        unsigned long cycle;
+        unsigned long written;
+        std::atomic<unsigned long> delivered;
+        std::atomic<unsigned long> dropped;
+        std::atomic<bool> running;
+        std::thread drainThread;
+
+        void drainLoop();
+        void stop();
+    };
+}
+
+#endif //INC_8_BIT_COMPUTER_EMULATOR_OUTPUTSTREAM_H
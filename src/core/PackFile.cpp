@@ -0,0 +1,178 @@
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Utils.h"
+
+#include "PackFile.h"
+
+namespace {
+    const char MAGIC[] = {'8', 'B', 'P', 'K'};
+
+    uint32_t readNumber(const uint8_t *bytes) {
+        return bytes[0] | bytes[1] << 8 | bytes[2] << 16 | (uint32_t) bytes[3] << 24;
+    }
+
+    void writeNumber(std::vector<uint8_t> &bytes, const uint32_t value) {
+        for (int i = 0; i < 4; i++) {
+            bytes.push_back(value >> (i * 8));
+        }
+    }
+}
+
+// The images are used in place, as an array in the mapped file
+static_assert(sizeof(Core::MemoryImage) == 16 && alignof(Core::MemoryImage) == 1,
+              "MemoryImage must be a plain block of 16 bytes");
+
+Core::PackFile::PackFile(const std::string &fileName) {
+    if (Utils::debugL2()) {
+        std::cout << "PackFile construct" << std::endl;
+    }
+
+    const int file = open(fileName.c_str(), O_RDONLY);
+
+    if (file < 0) {
+        throw std::runtime_error("PackFile: failed to open file: " + fileName);
+    }
+
+    struct stat status{};
+
+    if (fstat(file, &status) != 0 || status.st_size < HEADER_SIZE) {
+        close(file);
+        throw std::runtime_error("PackFile: not a pack file");
+    }
+
+    void *mapping = mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file); // The mapping keeps the file open
+
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("PackFile: failed to map file: " + fileName);
+    }
+
+    this->data = static_cast<const uint8_t *>(mapping);
+    this->fileSize = status.st_size;
+    this->count = readNumber(data + 8);
+    this->checksum = readNumber(data + 12);
+
+    // The destructor doesn't run if the constructor throws
+    auto fail = [this](const std::string &message) {
+        munmap(const_cast<uint8_t *>(data), fileSize);
+        throw std::runtime_error("PackFile: " + message);
+    };
+
+    if (!std::equal(MAGIC, MAGIC + sizeof(MAGIC), data)) {
+        fail("not a pack file");
+    }
+
+    if (data[4] != VERSION) {
+        fail("unsupported version " + std::to_string(data[4]));
+    }
+
+    if (data[5] != sizeof(MemoryImage)) {
+        fail("unsupported image size " + std::to_string(data[5]));
+    }
+
+    if (fileSize < HEADER_SIZE + count * (sizeof(MemoryImage) + INDEX_ENTRY_SIZE)) {
+        fail("wrong size");
+    }
+
+    // Advise the kernel that the images are read from start to end
+    madvise(mapping, fileSize, MADV_SEQUENTIAL);
+}
+
+Core::PackFile::~PackFile() {
+    if (Utils::debugL2()) {
+        std::cout << "PackFile destruct" << std::endl;
+    }
+
+    munmap(const_cast<uint8_t *>(data), fileSize);
+}
+
+void Core::PackFile::write(const std::string &fileName, const std::vector<Entry> &entries) {
+    std::vector<uint8_t> images;
+    std::vector<uint8_t> index;
+    std::vector<uint8_t> nameBytes;
+
+    images.reserve(entries.size() * sizeof(MemoryImage));
+
+    for (const Entry &entry : entries) {
+        if (entry.name.length() > 255) {
+            throw std::runtime_error("PackFile: name too long: " + entry.name);
+        }
+
+        images.insert(images.end(), entry.image.begin(), entry.image.end());
+        writeNumber(index, nameBytes.size());
+        nameBytes.push_back(entry.name.length());
+        nameBytes.insert(nameBytes.end(), entry.name.begin(), entry.name.end());
+    }
+
+    std::vector<uint8_t> header(MAGIC, MAGIC + sizeof(MAGIC));
+    header.push_back(VERSION);
+    header.push_back(sizeof(MemoryImage));
+    header.push_back(0);
+    header.push_back(0);
+    writeNumber(header, entries.size());
+    writeNumber(header, Utils::crc32(images.data(), images.size()));
+
+    std::ofstream file(fileName, std::ios::binary);
+
+    if (!file.is_open()) {
+        throw std::runtime_error("PackFile: failed to open file: " + fileName);
+    }
+
+    for (const std::vector<uint8_t> *part : {&header, &images, &index, &nameBytes}) {
+        file.write(reinterpret_cast<const char *>(part->data()), part->size());
+    }
+
+    if (!file) {
+        throw std::runtime_error("PackFile: failed to write file: " + fileName);
+    }
+}
+
+size_t Core::PackFile::size() const {
+    return count;
+}
+
+const Core::MemoryImage &Core::PackFile::image(const size_t index) const {
+    if (index >= count) {
+        throw std::runtime_error("PackFile: index out of bounds " + std::to_string(index));
+    }
+
+    return begin()[index];
+}
+
+std::string_view Core::PackFile::name(const size_t index) const {
+    if (index >= count) {
+        throw std::runtime_error("PackFile: index out of bounds " + std::to_string(index));
+    }
+
+    const size_t namesSize = data + fileSize - names();
+    const size_t offset = readNumber(data + HEADER_SIZE + count * sizeof(MemoryImage) + index * INDEX_ENTRY_SIZE);
+
+    if (offset >= namesSize || offset + 1 + names()[offset] > namesSize) {
+        throw std::runtime_error("PackFile: wrong size");
+    }
+
+    return {reinterpret_cast<const char *>(names() + offset + 1), names()[offset]};
+}
+
+const Core::MemoryImage *Core::PackFile::begin() const {
+    return reinterpret_cast<const MemoryImage *>(data + HEADER_SIZE);
+}
+
+const Core::MemoryImage *Core::PackFile::end() const {
+    return begin() + count;
+}
+
+void Core::PackFile::verifyChecksum() const {
+    if (Utils::crc32(data + HEADER_SIZE, count * sizeof(MemoryImage)) != checksum) {
+        throw std::runtime_error("PackFile: checksum mismatch");
+    }
+}
+
+const uint8_t *Core::PackFile::names() const {
+    return data + HEADER_SIZE + count * (sizeof(MemoryImage) + INDEX_ENTRY_SIZE);
+}
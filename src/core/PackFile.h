@@ -0,0 +1,76 @@
+#ifndef INC_8_BIT_COMPUTER_EMULATOR_PACKFILE_H
+#define INC_8_BIT_COMPUTER_EMULATOR_PACKFILE_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "MemoryImage.h"
+
+namespace Core {
+
+    /**
+     * A read only collection of many programs in one file of type .8bpk, for corpora that are too large for one
+     * file per program. The file is mapped into memory, and the images are read in place without any copying.
+     *
+     * The format, with numbers in little endian:
+     *
+     * - 16 bytes header: magic "8BPK", 1 byte version, 1 byte image size, 2 bytes reserved,
+     *   4 bytes number of images, and 4 bytes CRC-32 of the images
+     * - The images, 16 bytes each, packed after each other so they can be iterated like an array
+     * - The index, with 4 bytes for each image giving where its name starts in the names
+     * - The names, each with 1 byte length followed by the name
+     */
+    class PackFile {
+
+    public:
+        static constexpr uint8_t VERSION = 1;
+
+        /** A program to write to a pack file. */
+        struct Entry {
+            std::string name;
+            MemoryImage image;
+        };
+
+        /** Map the pack file into memory. Only the header and sizes are checked, see verifyChecksum(). */
+        explicit PackFile(const std::string &fileName);
+        ~PackFile();
+
+        PackFile(const PackFile &) = delete;
+        PackFile &operator=(const PackFile &) = delete;
+
+        /** Write the programs to a pack file, in the same order. */
+        static void write(const std::string &fileName, const std::vector<Entry> &entries);
+
+        /** Number of images in the pack. */
+        [[nodiscard]] size_t size() const;
+
+        /** The image at the index, read directly from the mapped file. */
+        [[nodiscard]] const MemoryImage &image(size_t index) const;
+
+        /** The name of the image at the index, read directly from the mapped file. */
+        [[nodiscard]] std::string_view name(size_t index) const;
+
+        /** First image, for iterating all the images as an array. */
+        [[nodiscard]] const MemoryImage *begin() const;
+
+        /** One past the last image. */
+        [[nodiscard]] const MemoryImage *end() const;
+
+        /** Reads all the images to check that they match the checksum in the header. Throws exception if not. */
+        void verifyChecksum() const;
+
+    private:
+        static const int HEADER_SIZE = 16;
+        static const int INDEX_ENTRY_SIZE = 4;
+
+        const uint8_t *data;
+        size_t fileSize;
+        size_t count;
+        uint32_t checksum;
+
+        [[nodiscard]] const uint8_t *names() const;
+    };
+}
+
+#endif //INC_8_BIT_COMPUTER_EMULATOR_PACKFILE_H
@@ -0,0 +1,207 @@
+#include <algorithm>
+
+#include "Disassembler.h"
+#include "Instructions.h"
+
+#include "PeepholeOptimizer.h"
+
+namespace {
+    uint8_t encode(const Core::Instructions::Instruction &instruction, const uint8_t operand) {
+        return instruction.opcode << 4 | (operand & 0x0F);
+    }
+
+    bool isJump(const uint8_t opcode) {
+        return opcode == Core::Instructions::JMP.opcode || opcode == Core::Instructions::JC.opcode ||
+               opcode == Core::Instructions::JZ.opcode;
+    }
+}
+
+Core::PeepholeOptimizer::Result Core::PeepholeOptimizer::optimize(const MemoryImage &image) {
+    Result result = {image, {}};
+    const Analysis analysis = analyze(image);
+
+    for (int address = 0; address < 16; address++) {
+        if (analysis.written[address] && analysis.executed[address]) {
+            return result;
+        }
+    }
+
+    // Skipping first, so the jumps it adds are threaded too
+    skipRedundant(result, analysis);
+    threadJumps(result, analysis);
+    loadConstants(result, analysis);
+
+    std::sort(result.rewrites.begin(), result.rewrites.end(), [](const Rewrite &first, const Rewrite &second) {
+        return first.address < second.address;
+    });
+
+    return result;
+}
+
+std::string Core::PeepholeOptimizer::describe(const Rewrite &rewrite) {
+    return std::to_string(rewrite.address) + ": " + Disassembler::disassemble(rewrite.before) + " -> " +
+           Disassembler::disassemble(rewrite.after) + " (saves " + std::to_string(rewrite.savedCycles) +
+           " cycles, " + rewrite.reason + ")";
+}
+
+Core::PeepholeOptimizer::Analysis Core::PeepholeOptimizer::analyze(const MemoryImage &image) {
+    Analysis analysis{};
+    std::vector<uint8_t> pending = {0};
+
+    // The start of the program counts as a jump target, since nothing runs before it
+    analysis.jumpTarget[0] = true;
+
+    while (!pending.empty()) {
+        const uint8_t address = pending.back();
+        pending.pop_back();
+
+        if (analysis.executed[address]) {
+            continue;
+        }
+
+        analysis.executed[address] = true;
+
+        const uint8_t opcode = image[address] >> 4;
+        const uint8_t operand = image[address] & 0x0F;
+        const uint8_t next = (address + 1) % 16;
+
+        switch (opcode) {
+            case Instructions::LDA.opcode:
+            case Instructions::ADD.opcode:
+            case Instructions::SUB.opcode:
+                analysis.read[operand] = true;
+                pending.push_back(next);
+                break;
+            case Instructions::STA.opcode:
+                analysis.written[operand] = true;
+                pending.push_back(next);
+                break;
+            case Instructions::NOP.opcode:
+            case Instructions::LDI.opcode:
+            case Instructions::OUT.opcode:
+                pending.push_back(next);
+                break;
+            case Instructions::JC.opcode:
+            case Instructions::JZ.opcode:
+                pending.push_back(next);
+                [[fallthrough]];
+            case Instructions::JMP.opcode:
+                analysis.jumpTarget[operand] = true;
+                pending.push_back(operand);
+                break;
+            default:
+                break; // HLT, and unknown instructions that stop the computer
+        }
+    }
+
+    return analysis;
+}
+
+bool Core::PeepholeOptimizer::isRedundant(const MemoryImage &image, const Analysis &analysis, const uint8_t address) {
+    if (!analysis.executed[address] || analysis.read[address]) {
+        return false;
+    }
+
+    const uint8_t opcode = image[address] >> 4;
+    const uint8_t operand = image[address] & 0x0F;
+
+    if (opcode == Instructions::NOP.opcode) {
+        return true;
+    }
+
+    // Jumps don't change the flags, so a jump to the next address does nothing whether it's taken or not
+    if (isJump(opcode)) {
+        return operand == (address + 1) % 16;
+    }
+
+    // The A-register already has the value, but only when coming from the previous address
+    if (opcode == Instructions::LDA.opcode && !analysis.jumpTarget[address]) {
+        const uint8_t previous = image[address - 1];
+
+        return previous == encode(Instructions::STA, operand) || previous == encode(Instructions::LDA, operand);
+    }
+
+    return false;
+}
+
+void Core::PeepholeOptimizer::skipRedundant(Result &result, const Analysis &analysis) {
+    uint8_t address = 0;
+
+    while (address < 16) {
+        uint8_t end = address;
+
+        while (end < 16 && isRedundant(result.image, analysis, end)) {
+            end++;
+        }
+
+        // One jump instead of one redundant instruction would save nothing
+        const int skipped = end - address;
+
+        if (skipped >= 2) {
+            rewrite(result, address, encode(Instructions::JMP, end % 16), (skipped - 1) * CYCLES_PER_INSTRUCTION,
+                    "skips " + std::to_string(skipped) + " instructions that do nothing");
+        }
+
+        address = std::max<uint8_t>(end, address + 1);
+    }
+}
+
+void Core::PeepholeOptimizer::threadJumps(Result &result, const Analysis &analysis) {
+    for (uint8_t address = 0; address < 16; address++) {
+        const uint8_t opcode = result.image[address] >> 4;
+
+        if (!analysis.executed[address] || analysis.read[address] || !isJump(opcode)) {
+            continue;
+        }
+
+        uint8_t target = result.image[address] & 0x0F;
+        int hops = 0;
+
+        // Bounded, since a loop of jumps never ends
+        while (hops < 16 && analysis.executed[target] && !analysis.read[target] &&
+               result.image[target] >> 4 == Instructions::JMP.opcode && (result.image[target] & 0x0F) != target) {
+            target = result.image[target] & 0x0F;
+            hops++;
+        }
+
+        if (hops > 0 && target != (result.image[address] & 0x0F)) {
+            rewrite(result, address, (opcode << 4) | target, hops * CYCLES_PER_INSTRUCTION,
+                    "jumps straight past " + std::to_string(hops) + " JMP");
+        }
+    }
+}
+
+void Core::PeepholeOptimizer::loadConstants(Result &result, const Analysis &analysis) {
+    for (uint8_t address = 0; address < 16; address++) {
+        const uint8_t instruction = result.image[address];
+        const uint8_t operand = instruction & 0x0F;
+
+        if (!analysis.executed[address] || analysis.read[address] ||
+            instruction >> 4 != Instructions::LDA.opcode || analysis.written[operand]) {
+            continue;
+        }
+
+        const uint8_t value = result.image[operand];
+
+        if (value <= 0x0F) {
+            rewrite(result, address, encode(Instructions::LDI, value), 0, "constant fits in the instruction");
+        }
+    }
+}
+
+void Core::PeepholeOptimizer::rewrite(Result &result, const uint8_t address, const uint8_t value,
+                                      const unsigned long savedCycles, const std::string &reason) {
+    const uint8_t before = result.image[address];
+    result.image[address] = value;
+
+    for (Rewrite &existing : result.rewrites) {
+        if (existing.address == address) {
+            existing.after = value;
+            existing.savedCycles += savedCycles;
+            existing.reason += ", " + reason;
+            return;
+        }
+    }
+
+    result.rewrites.push_back({address, before, value, savedCycles, reason});
+}
@@ -0,0 +1,72 @@
+#ifndef INC_8_BIT_COMPUTER_EMULATOR_PEEPHOLEOPTIMIZER_H
+#define INC_8_BIT_COMPUTER_EMULATOR_PEEPHOLEOPTIMIZER_H
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "MemoryImage.h"
+
+namespace Core {
+
+    /**
+     * Static class for rewriting wasteful patterns in programs into faster ones. Every instruction takes
+     * the same 5 clock cycles, so cycles are only saved by executing fewer instructions:
+     *
+     * - A run of 2 or more instructions that do nothing becomes a jump past them. That is NOP, jumps to the
+     *   next address, and LDA x right after STA x or LDA x, when nothing jumps to it
+     * - A jump to a JMP goes straight to where that JMP goes
+     * - LDA x of a constant that fits in 4 bits becomes LDI, which saves no cycles, but no longer reads memory
+     *
+     * Every address stays where it is. Only instructions that are executed are changed, never bytes that are
+     * read as data. Programs that store into their own code are left alone, since the code is not known up front.
+     */
+    class PeepholeOptimizer {
+
+    public:
+        PeepholeOptimizer() = delete;
+        ~PeepholeOptimizer() = delete;
+
+        /** One instruction that was changed. */
+        struct Rewrite {
+            uint8_t address;
+            uint8_t before;
+            uint8_t after;
+            /** Clock cycles saved each time the program gets here. */
+            unsigned long savedCycles;
+            std::string reason;
+        };
+
+        struct Result {
+            MemoryImage image;
+            std::vector<Rewrite> rewrites;
+        };
+
+        /** Rewrite the program starting at address 0. */
+        static Result optimize(const MemoryImage &image);
+
+        /** Describe a rewrite on one line, like "1: NOP -> JMP 4 (saves 10 cycles, skips 3 instructions)". */
+        static std::string describe(const Rewrite &rewrite);
+
+    private:
+        static const int CYCLES_PER_INSTRUCTION = 5;
+
+        /** What is known about each address before anything is changed. */
+        struct Analysis {
+            std::array<bool, 16> executed;
+            std::array<bool, 16> read;
+            std::array<bool, 16> written;
+            std::array<bool, 16> jumpTarget;
+        };
+
+        [[nodiscard]] static Analysis analyze(const MemoryImage &image);
+        [[nodiscard]] static bool isRedundant(const MemoryImage &image, const Analysis &analysis, uint8_t address);
+        static void loadConstants(Result &result, const Analysis &analysis);
+        static void threadJumps(Result &result, const Analysis &analysis);
+        static void skipRedundant(Result &result, const Analysis &analysis);
+        static void rewrite(Result &result, uint8_t address, uint8_t value, unsigned long savedCycles,
+                            const std::string &reason);
+    };
+}
+
+#endif //INC_8_BIT_COMPUTER_EMULATOR_PEEPHOLEOPTIMIZER_H
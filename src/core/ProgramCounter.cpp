@@ -1,6 +1,7 @@
 #include <iostream>
 #include <string>
 
+#include "Log.h"
 #include "Utils.h"
 
 #include "ProgramCounter.h"
@@ -57,7 +58,7 @@ void Core::ProgramCounter::writeToBus() {
 }
 
 void Core::ProgramCounter::print() const {
-    printf("ProgramCounter: %d / 0x%02X / " BIT_4_PATTERN " \n", value, value, BIT_4_TO_BINARY(value));
+    Log::printf("ProgramCounter: %d / 0x%02X / " BIT_4_PATTERN " \n", value, value, BIT_4_TO_BINARY(value));
 }
 
 void Core::ProgramCounter::reset() {
@@ -106,12 +107,32 @@ void Core::ProgramCounter::clockTicked() {
     }
 }
 
-void Core::ProgramCounter::notifyObserver() const {
-    if (observer != nullptr) {
+void Core::ProgramCounter::notifyObserver() {
+    if (Utils::OBSERVED && observer != nullptr && changeFilter.shouldPass(value)) {
         observer->valueUpdated(value);
     }
 }
 
+Core::ProgramCounter::State Core::ProgramCounter::getState() const {
+    return {value, incrementOnClock, readOnClock};
+}
+
+void Core::ProgramCounter::setState(const State &state) {
+    value = state.value;
+    incrementOnClock = state.incrementOnClock;
+    readOnClock = state.readOnClock;
+
+    notifyObserver();
+}
+
 void Core::ProgramCounter::setObserver(const std::shared_ptr<ValueObserver> &newObserver) {
     observer = newObserver;
 }
+
+void Core::ProgramCounter::setNotifyEveryWrite(const bool everyWrite) {
+    changeFilter.setEveryWrite(everyWrite);
+}
+
+Core::ChangeFilter::Statistics Core::ProgramCounter::getNotificationStatistics() const {
+    return changeFilter.getStatistics();
+}
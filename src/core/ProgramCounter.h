@@ -4,6 +4,7 @@
 #include <memory>
 
 #include "Bus.h"
+#include "ChangeFilter.h"
 #include "ClockListener.h"
 
 namespace Core {
@@ -17,6 +18,13 @@ namespace Core {
     class ProgramCounter: public ClockListener {
 
     public:
+        /** Everything needed to put this program counter back the way it was, including pending reads from the clock. */
+        struct State {
+            uint8_t value;
+            bool incrementOnClock;
+            bool readOnClock;
+        };
+
         explicit ProgramCounter(const std::shared_ptr<Bus> &bus);
         ~ProgramCounter();
 
@@ -35,12 +43,25 @@ namespace Core {
         /** Use value from bus as new counter value on next clock tick. */
         virtual void jump();
 
+        /** Get a copy of the current state. */
+        [[nodiscard]] State getState() const;
+
+        /** Put back a state from getState(), and notify the observer. */
+        void setState(const State &state);
+
         /** Set an optional external observer of this program counter. */
         void setObserver(const std::shared_ptr<ValueObserver> &newObserver);
 
+        /** Notify the observer of every write, instead of only when the value changes. Off by default. */
+        void setNotifyEveryWrite(bool everyWrite);
+
+        /** How many notifications to the observer were passed on or skipped. */
+        [[nodiscard]] ChangeFilter::Statistics getNotificationStatistics() const;
+
     private:
         std::shared_ptr<Bus> bus;
         std::shared_ptr<ValueObserver> observer;
+        ChangeFilter changeFilter;
         uint8_t value;
         bool incrementOnClock;
         bool readOnClock;
@@ -48,7 +69,7 @@ namespace Core {
         void increment();
         void readFromBus();
         void writeToBus();
-        void notifyObserver() const;
+        void notifyObserver();
 
         void clockTicked() override;
         void invertedClockTicked() override {}; // Not implemented
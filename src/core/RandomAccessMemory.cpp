@@ -1,6 +1,8 @@
 #include <iostream>
 #include <string>
 
+#include "EventObserver.h"
+#include "Log.h"
 #include "Utils.h"
 
 #include "RandomAccessMemory.h"
@@ -44,11 +46,11 @@ void Core::RandomAccessMemory::writeToBus() {
 }
 
 void Core::RandomAccessMemory::print() {
-    printf("RandomAccessMemory: current address - %d / 0x%02X / " BIT_4_PATTERN " \n", address, address, BIT_4_TO_BINARY(address));
-    printf("RandomAccessMemory: current value - %d / 0x%02X / " BYTE_PATTERN " \n", memory[address], memory[address], BYTE_TO_BINARY(memory[address]));
+    Log::printf("RandomAccessMemory: current address - %d / 0x%02X / " BIT_4_PATTERN " \n", address, address, BIT_4_TO_BINARY(address));
+    Log::printf("RandomAccessMemory: current value - %d / 0x%02X / " BYTE_PATTERN " \n", memory[address], memory[address], BYTE_TO_BINARY(memory[address]));
 
     for (int i = 0; i < MEMORY_SIZE; i++) {
-        printf("RandomAccessMemory: value at %d - %d / 0x%02X / " BYTE_PATTERN " \n", i, memory[i], memory[i], BYTE_TO_BINARY(memory[i]));
+        Log::printf("RandomAccessMemory: value at %d - %d / 0x%02X / " BYTE_PATTERN " \n", i, memory[i], memory[i], BYTE_TO_BINARY(memory[i]));
     }
 }
 
@@ -62,12 +64,21 @@ void Core::RandomAccessMemory::program(const std::bitset<4> &opcode, const std::
                   << " and operand " << operand << std::endl;
     }
 
-    std::bitset<8> newValue(opcode.to_string() + operand.to_string());
-    memory[address] = newValue.to_ulong();
+    memory[address] = opcode.to_ulong() << 4 | operand.to_ulong();
 
     notifyObserver();
 }
 
+void Core::RandomAccessMemory::program(const MemoryImage &image) {
+    if (Utils::debugL2()) {
+        std::cout << "RandomAccessMemory: programming all addresses" << std::endl;
+    }
+
+    memory = image;
+
+    notifyMemoryObserver();
+}
+
 void Core::RandomAccessMemory::in() {
     if (Utils::debugL2()) {
         std::cout << "RandomAccessMemory: in - will read from bus on clock tick" << std::endl;
@@ -110,12 +121,41 @@ void Core::RandomAccessMemory::registerValueChanged(const uint8_t newValue) {
     notifyObserver();
 }
 
-void Core::RandomAccessMemory::notifyObserver() const {
-    if (observer != nullptr) {
-        observer->valueUpdated(memory[address]);
+void Core::RandomAccessMemory::notifyObserver() {
+    if (Utils::OBSERVED && observer != nullptr && changeFilter.shouldPass(Event::packMemory(address, memory[address]))) {
+        observer->valueUpdated(address, memory[address]);
     }
 }
 
-void Core::RandomAccessMemory::setObserver(const std::shared_ptr<ValueObserver> &newObserver) {
+void Core::RandomAccessMemory::notifyMemoryObserver() {
+    if (Utils::OBSERVED && observer != nullptr) {
+        observer->memoryUpdated(memory);
+    }
+
+    // The value at the current address as well, for observers that only look at that
+    notifyObserver();
+}
+
+Core::RandomAccessMemory::State Core::RandomAccessMemory::getState() const {
+    return {memory, address, readOnClock};
+}
+
+void Core::RandomAccessMemory::setState(const State &state) {
+    memory = state.memory;
+    address = state.address;
+    readOnClock = state.readOnClock;
+
+    notifyMemoryObserver();
+}
+
+void Core::RandomAccessMemory::setObserver(const std::shared_ptr<RandomAccessMemoryObserver> &newObserver) {
     observer = newObserver;
 }
+
+void Core::RandomAccessMemory::setNotifyEveryWrite(const bool everyWrite) {
+    changeFilter.setEveryWrite(everyWrite);
+}
+
+Core::ChangeFilter::Statistics Core::RandomAccessMemory::getNotificationStatistics() const {
+    return changeFilter.getStatistics();
+}
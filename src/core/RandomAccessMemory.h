@@ -6,7 +6,10 @@
 #include <memory>
 
 #include "Bus.h"
+#include "ChangeFilter.h"
 #include "ClockListener.h"
+#include "MemoryImage.h"
+#include "RandomAccessMemoryObserver.h"
 #include "RegisterListener.h"
 
 namespace Core {
@@ -27,6 +30,13 @@ namespace Core {
     public:
         static const int MEMORY_SIZE = 16; // 16 bytes / 16 x 8 bits
 
+        /** Everything needed to put this memory back the way it was, including pending reads from the clock. */
+        struct State {
+            std::array<uint8_t, MEMORY_SIZE> memory;
+            uint8_t address;
+            bool readOnClock;
+        };
+
         explicit RandomAccessMemory(const std::shared_ptr<Bus> &bus);
         ~RandomAccessMemory();
 
@@ -39,25 +49,43 @@ namespace Core {
         /** Puts the specified opcode and operand into memory at the current address in manual mode. */
         void program(const std::bitset<4> &opcode, const std::bitset<4> &operand);
 
+        /** Puts a full image into memory in one go, and notifies the observer of all of it. The address is not changed. */
+        void program(const MemoryImage &image);
+
         /** Take the value from the bus on next clock tick and insert into the current address in memory. */
         virtual void in();
 
         /** Output the value at the current address in memory to the bus. */
         virtual void out();
 
+        /** Get a copy of the current state. */
+        [[nodiscard]] State getState() const;
+
+        /** Put back a state from getState(), and notify the observer of all of memory. */
+        void setState(const State &state);
+
         /** Set an optional external observer of this random access memory. */
-        void setObserver(const std::shared_ptr<ValueObserver> &newObserver);
+        void setObserver(const std::shared_ptr<RandomAccessMemoryObserver> &newObserver);
+
+        /** Notify the observer of every write, instead of only when the value changes. Off by default. */
+        void setNotifyEveryWrite(bool everyWrite);
+
+        /** How many notifications to the observer were passed on or skipped. */
+        [[nodiscard]] ChangeFilter::Statistics getNotificationStatistics() const;
 
     private:
         std::shared_ptr<Bus> bus;
-        std::shared_ptr<ValueObserver> observer;
+        std::shared_ptr<RandomAccessMemoryObserver> observer;
+        /** Filters on the address and the value, since the same value can be at different addresses. */
+        ChangeFilter changeFilter;
         std::array<uint8_t, MEMORY_SIZE> memory{};
         uint8_t address;
         bool readOnClock;
 
         void readFromBus();
         void writeToBus();
-        void notifyObserver() const;
+        void notifyObserver();
+        void notifyMemoryObserver();
 
         void clockTicked() override;
         void invertedClockTicked() override {}; // Not implemented
@@ -0,0 +1,24 @@
+#ifndef INC_8_BIT_COMPUTER_EMULATOR_RANDOMACCESSMEMORYOBSERVER_H
+#define INC_8_BIT_COMPUTER_EMULATOR_RANDOMACCESSMEMORYOBSERVER_H
+
+#include <cstdint>
+
+#include "MemoryImage.h"
+
+namespace Core {
+
+    /**
+     * Interface for external observation of the random access memory of the computer.
+     */
+    class RandomAccessMemoryObserver {
+
+    public:
+        /** The value at the current address has changed, or the current address has changed. */
+        virtual void valueUpdated(uint8_t address, uint8_t newValue) = 0;
+
+        /** All of memory was replaced at once, like when loading a program or restoring a snapshot. */
+        virtual void memoryUpdated(const MemoryImage &newMemory) = 0;
+    };
+}
+
+#endif //INC_8_BIT_COMPUTER_EMULATOR_RANDOMACCESSMEMORYOBSERVER_H
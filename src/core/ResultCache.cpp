@@ -0,0 +1,287 @@
+#include <algorithm>
+#include <cerrno>
+#include <fcntl.h>
+#include <iostream>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Utils.h"
+
+#include "ResultCache.h"
+
+namespace {
+    const char MAGIC[] = {'8', 'B', 'R', 'C'};
+
+    // Everything in a record before the outputs
+    const size_t FIXED_BODY_SIZE = sizeof(Core::MemoryImage) + 8 + 1 + 8 + 1 + 1 + 4;
+
+    uint64_t readNumber(const uint8_t *bytes, const int size) {
+        uint64_t value = 0;
+
+        for (int i = 0; i < size; i++) {
+            value |= (uint64_t) bytes[i] << (i * 8);
+        }
+
+        return value;
+    }
+
+    void writeNumber(std::vector<uint8_t> &bytes, const uint64_t value, const int size) {
+        for (int i = 0; i < size; i++) {
+            bytes.push_back(value >> (i * 8));
+        }
+    }
+
+    bool writeAll(const int file, const std::vector<uint8_t> &bytes, const off_t offset) {
+        size_t written = 0;
+
+        while (written < bytes.size()) {
+            const ssize_t result = pwrite(file, bytes.data() + written, bytes.size() - written, offset + written);
+
+            if (result <= 0) {
+                return false;
+            }
+
+            written += result;
+        }
+
+        return true;
+    }
+}
+
+Core::ResultCache::ResultCache(const std::string &fileName) {
+    if (Utils::debugL2()) {
+        std::cout << "ResultCache construct" << std::endl;
+    }
+
+    this->fileName = fileName;
+    this->file = open(fileName.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    this->validSize = HEADER_SIZE;
+    this->hits = 0;
+    this->misses = 0;
+    this->stored = 0;
+
+    if (file < 0) {
+        throw std::runtime_error("ResultCache: failed to open file: " + fileName);
+    }
+
+    // The destructor doesn't run if the constructor throws
+    auto fail = [this](const std::string &message) {
+        close(file);
+        throw std::runtime_error("ResultCache: " + message);
+    };
+
+    // Exclusive, since the first runner to open a new file writes the header
+    lock(LOCK_EX);
+
+    struct stat status{};
+    fstat(file, &status);
+
+    if (status.st_size == 0) {
+        std::vector<uint8_t> header(MAGIC, MAGIC + sizeof(MAGIC));
+        header.push_back(VERSION);
+        header.resize(HEADER_SIZE);
+
+        if (!writeAll(file, header, 0)) {
+            fail("failed to write file: " + fileName);
+        }
+    } else {
+        uint8_t header[HEADER_SIZE] = {};
+
+        if (pread(file, header, HEADER_SIZE, 0) != HEADER_SIZE || !std::equal(MAGIC, MAGIC + sizeof(MAGIC), header)) {
+            fail("not a result cache");
+        }
+
+        if (header[4] != VERSION) {
+            fail("unsupported version " + std::to_string(header[4]));
+        }
+
+        readRecords();
+    }
+
+    lock(LOCK_UN);
+}
+
+Core::ResultCache::~ResultCache() {
+    if (Utils::debugL2()) {
+        std::cout << "ResultCache destruct" << std::endl;
+    }
+
+    try {
+        flush();
+    } catch (const std::runtime_error &e) {
+        std::cerr << e.what() << std::endl;
+    }
+
+    close(file);
+}
+
+bool Core::ResultCache::find(const Key &key, Run &run) {
+    std::lock_guard<std::mutex> guard(mutex);
+
+    const auto existing = runs.find(key);
+
+    if (existing == runs.end()) {
+        misses++;
+        return false;
+    }
+
+    hits++;
+    run = existing->second;
+
+    return true;
+}
+
+void Core::ResultCache::store(const Key &key, const Run &run) {
+    std::lock_guard<std::mutex> guard(mutex);
+
+    // Another thread may have done the same run at the same time
+    if (runs.emplace(key, run).second) {
+        pending.emplace_back(key, run);
+        stored++;
+    }
+}
+
+void Core::ResultCache::flush() {
+    std::lock_guard<std::mutex> guard(mutex);
+
+    if (pending.empty()) {
+        return;
+    }
+
+    lock(LOCK_EX);
+
+    // The others may have appended since last time, and the end could be a record cut short by a crash
+    readRecords();
+
+    std::vector<uint8_t> bytes;
+
+    for (const auto &[key, run] : pending) {
+        std::vector<uint8_t> body(key.image.begin(), key.image.end());
+        writeNumber(body, key.maxCycles, 8);
+        body.push_back((uint8_t) key.engine);
+        writeNumber(body, run.cycles, 8);
+        body.push_back(run.halted);
+        body.push_back(run.failed);
+        writeNumber(body, run.outputs.size(), 4);
+        body.insert(body.end(), run.outputs.begin(), run.outputs.end());
+
+        writeNumber(bytes, body.size(), 4);
+        writeNumber(bytes, Utils::crc32(body.data(), body.size()), 4);
+        bytes.insert(bytes.end(), body.begin(), body.end());
+    }
+
+    const bool written = ftruncate(file, validSize) == 0 && writeAll(file, bytes, validSize);
+
+    if (written) {
+        validSize += bytes.size();
+        pending.clear();
+    }
+
+    lock(LOCK_UN);
+
+    if (!written) {
+        throw std::runtime_error("ResultCache: failed to write file: " + fileName);
+    }
+}
+
+size_t Core::ResultCache::size() const {
+    std::lock_guard<std::mutex> guard(mutex);
+
+    return runs.size();
+}
+
+Core::ResultCache::Statistics Core::ResultCache::getStatistics() const {
+    return {hits, misses, stored};
+}
+
+void Core::ResultCache::readRecords() {
+    struct stat status{};
+    fstat(file, &status);
+
+    if (status.st_size <= validSize) {
+        return;
+    }
+
+    // One read of everything that is new
+    std::vector<uint8_t> bytes(status.st_size - validSize);
+
+    if (pread(file, bytes.data(), bytes.size(), validSize) != (ssize_t) bytes.size()) {
+        return;
+    }
+
+    size_t offset = 0;
+
+    while (offset + RECORD_HEADER_SIZE <= bytes.size()) {
+        const size_t bodySize = readNumber(&bytes[offset], 4);
+        const uint32_t checksum = readNumber(&bytes[offset + 4], 4);
+        const uint8_t *body = &bytes[offset + RECORD_HEADER_SIZE];
+
+        if (bodySize < FIXED_BODY_SIZE || bodySize > bytes.size() - offset - RECORD_HEADER_SIZE ||
+            Utils::crc32(body, bodySize) != checksum) {
+            break;
+        }
+
+        Key key{};
+        std::copy(body, body + sizeof(MemoryImage), key.image.begin());
+        const uint8_t *values = body + sizeof(MemoryImage);
+        key.maxCycles = readNumber(values, 8);
+        key.engine = (Engine) values[8];
+
+        Run run{};
+        run.cycles = readNumber(values + 9, 8);
+        run.halted = values[17];
+        run.failed = values[18];
+        const size_t outputCount = readNumber(values + 19, 4);
+
+        if (FIXED_BODY_SIZE + outputCount != bodySize) {
+            break;
+        }
+
+        run.outputs.assign(body + FIXED_BODY_SIZE, body + bodySize);
+        runs.emplace(key, std::move(run));
+
+        offset += RECORD_HEADER_SIZE + bodySize;
+    }
+
+    validSize += offset;
+}
+
+void Core::ResultCache::lock(const int operation) const {
+    // Try again when interrupted by a signal
+    while (flock(file, operation) != 0) {
+        if (errno != EINTR) {
+            throw std::runtime_error("ResultCache: failed to lock file: " + fileName);
+        }
+    }
+}
+
+bool Core::ResultCache::Key::operator==(const Key &other) const {
+    return image == other.image && maxCycles == other.maxCycles && engine == other.engine;
+}
+
+size_t Core::ResultCache::KeyHash::operator()(const Key &key) const {
+    // FNV-1a
+    size_t hash = 14695981039346656037ULL;
+
+    auto add = [&hash](const uint8_t value) {
+        hash ^= value;
+        hash *= 1099511628211ULL;
+    };
+
+    for (const uint8_t value : key.image) {
+        add(value);
+    }
+
+    for (int i = 0; i < 8; i++) {
+        add(key.maxCycles >> (i * 8));
+    }
+
+    add((uint8_t) key.engine);
+
+    return hash;
+}
+
+double Core::ResultCache::Statistics::hitRate() const {
+    return hits + misses == 0 ? 0 : (double) hits / (hits + misses);
+}
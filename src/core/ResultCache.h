@@ -0,0 +1,115 @@
+#ifndef INC_8_BIT_COMPUTER_EMULATOR_RESULTCACHE_H
+#define INC_8_BIT_COMPUTER_EMULATOR_RESULTCACHE_H
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <sys/types.h>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "MemoryImage.h"
+
+namespace Core {
+
+    /**
+     * A persistent cache of the results of running programs. A run only depends on the memory image, the cycle
+     * budget and the engine that runs it, so the same key always gives the same result, and it never goes stale.
+     *
+     * The results are kept in one file of type .8brc, that any number of runners can share at the same time.
+     * It's read when opened, and new results are appended by flush() while holding an exclusive lock on the file.
+     * Results appended by the others since are read at the same time.
+     *
+     * The format, with numbers in little endian:
+     *
+     * - 8 bytes header: magic "8BRC", 1 byte version, 3 bytes reserved
+     * - The records, each with 4 bytes size and 4 bytes CRC-32 of the rest: 16 bytes memory, 8 bytes max cycles,
+     *   1 byte engine, 8 bytes cycles, 1 byte halted, 1 byte failed, 4 bytes number of outputs, and the outputs
+     *
+     * A record that is cut short or corrupt ends the file, and is overwritten by the next flush().
+     */
+    class ResultCache {
+
+    public:
+        static constexpr uint8_t VERSION = 1;
+
+        /** What the program was run on, since they are not required to agree on programs that fail. */
+        enum class Engine : uint8_t {
+            EMULATOR = 1,
+            INTERPRETER = 2
+        };
+
+        /** Everything the result of a run depends on. */
+        struct Key {
+            MemoryImage image;
+            unsigned long maxCycles;
+            Engine engine;
+
+            bool operator==(const Key &other) const;
+        };
+
+        /** The result of a run. */
+        struct Run {
+            std::vector<uint8_t> outputs;
+            unsigned long cycles;
+            bool halted;
+            bool failed;
+        };
+
+        struct Statistics {
+            unsigned long hits;
+            unsigned long misses;
+            unsigned long stored;
+
+            /** Hits out of all lookups, from 0 to 1. */
+            [[nodiscard]] double hitRate() const;
+        };
+
+        /** Open the cache file, or create it if it doesn't exist, and read the results in it. */
+        explicit ResultCache(const std::string &fileName);
+
+        /** Flushes the results that are not written yet. */
+        ~ResultCache();
+
+        ResultCache(const ResultCache &) = delete;
+        ResultCache &operator=(const ResultCache &) = delete;
+
+        /** Look up the result of a run. Returns false if it's not in the cache. Safe to use from many threads. */
+        bool find(const Key &key, Run &run);
+
+        /** Add the result of a run. It's available right away, but only written to the file by flush(). */
+        void store(const Key &key, const Run &run);
+
+        /** Append the new results to the file, and read the results that the other runners have appended. */
+        void flush();
+
+        /** Number of results in the cache. */
+        [[nodiscard]] size_t size() const;
+
+        [[nodiscard]] Statistics getStatistics() const;
+
+    private:
+        static const int HEADER_SIZE = 8;
+        static const int RECORD_HEADER_SIZE = 8;
+
+        struct KeyHash {
+            size_t operator()(const Key &key) const;
+        };
+
+        std::string fileName;
+        int file;
+        off_t validSize;
+        std::unordered_map<Key, Run, KeyHash> runs;
+        std::vector<std::pair<Key, Run>> pending;
+        mutable std::mutex mutex;
+        std::atomic<unsigned long> hits;
+        std::atomic<unsigned long> misses;
+        std::atomic<unsigned long> stored;
+
+        void readRecords();
+        void lock(int operation) const;
+    };
+}
+
+#endif //INC_8_BIT_COMPUTER_EMULATOR_RESULTCACHE_H
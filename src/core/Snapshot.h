@@ -0,0 +1,45 @@
+#ifndef INC_8_BIT_COMPUTER_EMULATOR_SNAPSHOT_H
+#define INC_8_BIT_COMPUTER_EMULATOR_SNAPSHOT_H
+
+#include <type_traits>
+
+#include "ArithmeticLogicUnit.h"
+#include "Bus.h"
+#include "Clock.h"
+#include "FlagsRegister.h"
+#include "GenericRegister.h"
+#include "InstructionRegister.h"
+#include "MemoryAddressRegister.h"
+#include "OutputRegister.h"
+#include "ProgramCounter.h"
+#include "RandomAccessMemory.h"
+#include "StepCounter.h"
+
+namespace Core {
+
+    /**
+     * The complete state of the computer at one point in time, from Emulator::snapshot().
+     *
+     * Only plain values, so it can be copied around as a small block of memory, and restored any number of times.
+     * The instruction decoder has no state of its own, since it only reacts to the step counter.
+     * Use Checkpoint to store it in a file.
+     */
+    struct Snapshot {
+        Clock::State clock;
+        Bus::State bus;
+        GenericRegister::State aRegister;
+        GenericRegister::State bRegister;
+        ArithmeticLogicUnit::State arithmeticLogicUnit;
+        MemoryAddressRegister::State memoryAddressRegister;
+        ProgramCounter::State programCounter;
+        RandomAccessMemory::State randomAccessMemory;
+        InstructionRegister::State instructionRegister;
+        OutputRegister::State outputRegister;
+        StepCounter::State stepCounter;
+        FlagsRegister::State flagsRegister;
+    };
+
+    static_assert(std::is_trivially_copyable<Snapshot>::value, "Snapshot must be a plain block of memory");
+}
+
+#endif //INC_8_BIT_COMPUTER_EMULATOR_SNAPSHOT_H
@@ -0,0 +1,89 @@
+#ifndef INC_8_BIT_COMPUTER_EMULATOR_SPSCQUEUE_H
+#define INC_8_BIT_COMPUTER_EMULATOR_SPSCQUEUE_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace Core {
+
+    /**
+     * A fixed size queue from one writer thread to one reader thread, without locks.
+     *
+     * The writer only moves the head and the reader only moves the tail, so each side is a plain store after
+     * copying the values. Each side also keeps the last position it saw of the other, and only loads the real one
+     * again when the queue looks full or empty, so they don't keep taking the cache line from each other.
+     * The reader takes everything that's there in one go.
+     */
+    template<typename T>
+    class SpscQueue {
+
+    public:
+        /** Room for at least capacity values, rounded up to a power of 2. */
+        explicit SpscQueue(const size_t capacity) {
+            size_t size = 1;
+
+            while (size < capacity) {
+                size <<= 1;
+            }
+
+            this->values = std::make_unique<T[]>(size);
+            this->mask = size - 1;
+        }
+
+        /** Add the value, or return false when the queue is full. Only for the writer thread. */
+        bool push(const T &value) {
+            const size_t position = head.load(std::memory_order_relaxed);
+
+            if (position - cachedTail > mask) {
+                cachedTail = tail.load(std::memory_order_acquire);
+
+                if (position - cachedTail > mask) {
+                    return false;
+                }
+            }
+
+            values[position & mask] = value;
+            head.store(position + 1, std::memory_order_release);
+
+            return true;
+        }
+
+        /** Move up to maxCount values into the array, and return how many. Only for the reader thread. */
+        size_t pop(T *into, const size_t maxCount) {
+            const size_t position = tail.load(std::memory_order_relaxed);
+
+            if (cachedHead == position) {
+                cachedHead = head.load(std::memory_order_acquire);
+            }
+
+            const size_t count = std::min(cachedHead - position, maxCount);
+
+            for (size_t i = 0; i < count; i++) {
+                into[i] = values[(position + i) & mask];
+            }
+
+            tail.store(position + count, std::memory_order_release);
+
+            return count;
+        }
+
+        /** The number of values that can be in the queue at once. */
+        [[nodiscard]] size_t capacity() const {
+            return mask + 1;
+        }
+
+    private:
+        std::unique_ptr<T[]> values;
+        size_t mask;
+
+        // The writer side and the reader side on separate cache lines
+        alignas(64) std::atomic<size_t> head{0};
+        size_t cachedTail = 0;
+        alignas(64) std::atomic<size_t> tail{0};
+        size_t cachedHead = 0;
+    };
+}
+
+#endif //INC_8_BIT_COMPUTER_EMULATOR_SPSCQUEUE_H
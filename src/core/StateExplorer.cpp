@@ -0,0 +1,205 @@
+#include <iostream>
+#include <thread>
+
+#include "Instructions.h"
+#include "Utils.h"
+
+#include "StateExplorer.h"
+
+Core::StateExplorer::StateExplorer(const std::vector<Assembler::Instruction> &instructions,
+                                   const std::vector<uint8_t> &addresses) {
+    if (Utils::debugL2()) {
+        std::cout << "StateExplorer construct" << std::endl;
+    }
+
+    if (addresses.size() > MAX_ADDRESSES) {
+        throw std::runtime_error("StateExplorer: number of addresses must be from 0 to " + std::to_string(MAX_ADDRESSES));
+    }
+
+    for (const uint8_t address : addresses) {
+        if (address > Utils::FOUR_BITS_MAX) {
+            throw std::runtime_error("StateExplorer: address out of bounds " + std::to_string(address));
+        }
+    }
+
+    this->memory = Assembler::toImage(instructions);
+    this->addresses = addresses;
+    this->definedAddresses = 0;
+
+    for (const auto &instruction : instructions) {
+        definedAddresses |= 1 << instruction.address.to_ulong();
+    }
+
+    for (const uint8_t address : addresses) {
+        definedAddresses |= 1 << address;
+    }
+}
+
+Core::StateExplorer::~StateExplorer() {
+    if (Utils::debugL2()) {
+        std::cout << "StateExplorer destruct" << std::endl;
+    }
+}
+
+Core::StateExplorer::Report Core::StateExplorer::explore(const size_t maxStates, const unsigned int threads) const {
+    ConcurrentStateSet states(maxStates);
+    Findings findings;
+    Report report;
+    size_t levels = 0;
+
+    std::vector<Interpreter::State> level;
+
+    for (const auto &state : initialStates()) {
+        if (states.insert(encode(state)) == ConcurrentStateSet::Insert::ADDED) {
+            level.push_back(state);
+        }
+    }
+
+    while (!level.empty() && !findings.full) {
+        std::atomic<size_t> nextState(0);
+        std::vector<std::vector<Interpreter::State>> nextLevels(std::max(threads, 1u));
+        std::vector<std::thread> workers;
+
+        for (auto &nextLevel : nextLevels) {
+            workers.emplace_back(&StateExplorer::exploreLevel, this, std::cref(level), std::ref(nextState),
+                                 std::ref(states), std::ref(findings), std::ref(nextLevel));
+        }
+
+        for (auto &worker : workers) {
+            worker.join();
+        }
+
+        level.clear();
+
+        for (const auto &nextLevel : nextLevels) {
+            level.insert(level.end(), nextLevel.begin(), nextLevel.end());
+        }
+
+        levels++;
+    }
+
+    // The last level only has states without new states after them
+    report.longestRun = levels > 0 ? levels - 1 : 0;
+    report.states = states.size();
+    report.haltingStates = findings.haltingStates;
+    report.failingStates = findings.failingStates;
+    report.complete = !findings.full;
+
+    for (uint8_t address = 0; address <= Utils::FOUR_BITS_MAX; address++) {
+        const uint16_t bit = 1 << address;
+
+        if ((definedAddresses & bit) && !(findings.usedAddresses & bit)) {
+            report.deadCode.push_back(address);
+        }
+    }
+
+    for (int value = 0; value <= 255; value++) {
+        if (findings.outputs[value / 64] & ((uint64_t) 1 << (value % 64))) {
+            report.outputs.push_back(value);
+        }
+    }
+
+    return report;
+}
+
+void Core::StateExplorer::exploreLevel(const std::vector<Interpreter::State> &level, std::atomic<size_t> &nextState,
+                                       ConcurrentStateSet &states, Findings &findings,
+                                       std::vector<Interpreter::State> &nextLevel) const {
+    // Small chunks keep the threads busy until the end, without fighting over the counter all the time
+    const size_t chunkSize = 256;
+
+    // Collected locally, and shared once at the end
+    uint16_t usedAddresses = 0;
+    std::array<uint64_t, 4> outputs{};
+    size_t haltingStates = 0;
+    size_t failingStates = 0;
+
+    while (!findings.full) {
+        const size_t first = nextState.fetch_add(chunkSize);
+
+        if (first >= level.size()) {
+            break;
+        }
+
+        const size_t last = std::min(first + chunkSize, level.size());
+
+        for (size_t i = first; i < last; i++) {
+            Interpreter::State state = level[i];
+
+            if (state.halted) {
+                haltingStates++;
+                continue;
+            }
+
+            if (state.failed) {
+                failingStates++;
+                continue;
+            }
+
+            const uint8_t instruction = state.memory[state.programCounter];
+            const uint8_t opcode = instruction >> 4;
+            const uint8_t operand = instruction & 0x0F;
+
+            usedAddresses |= 1 << state.programCounter;
+
+            if (opcode == Instructions::LDA.opcode || opcode == Instructions::ADD.opcode ||
+                opcode == Instructions::SUB.opcode) {
+                usedAddresses |= 1 << operand;
+            }
+
+            Interpreter::step(state);
+
+            if (opcode == Instructions::OUT.opcode) {
+                outputs[state.outputRegister / 64] |= (uint64_t) 1 << (state.outputRegister % 64);
+            }
+
+            const ConcurrentStateSet::Insert result = states.insert(encode(state));
+
+            if (result == ConcurrentStateSet::Insert::ADDED) {
+                nextLevel.push_back(state);
+            } else if (result == ConcurrentStateSet::Insert::FULL) {
+                findings.full = true;
+                break;
+            }
+        }
+    }
+
+    findings.usedAddresses |= usedAddresses;
+    findings.haltingStates += haltingStates;
+    findings.failingStates += failingStates;
+
+    for (size_t i = 0; i < outputs.size(); i++) {
+        findings.outputs[i] |= outputs[i];
+    }
+}
+
+std::vector<Core::Interpreter::State> Core::StateExplorer::initialStates() const {
+    std::vector<Interpreter::State> initial;
+    const size_t combinations = (size_t) 1 << (8 * addresses.size());
+
+    for (size_t combination = 0; combination < combinations; combination++) {
+        MemoryImage patched = memory;
+
+        // The value at the last address counts fastest
+        for (size_t i = 0; i < addresses.size(); i++) {
+            patched[addresses[i]] = combination >> (8 * (addresses.size() - 1 - i));
+        }
+
+        initial.push_back(Interpreter::initialState(patched));
+    }
+
+    return initial;
+}
+
+Core::ConcurrentStateSet::Key Core::StateExplorer::encode(const Interpreter::State &state) {
+    ConcurrentStateSet::Key key{};
+
+    std::copy(state.memory.begin(), state.memory.end(), key.begin());
+    key[16] = state.aRegister;
+    key[17] = state.bRegister;
+    key[18] = state.programCounter | state.carryFlag << 4 | state.zeroFlag << 5 | state.halted << 6 |
+              state.failed << 7;
+    key[19] = state.outputRegister;
+
+    return key;
+}
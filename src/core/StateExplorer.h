@@ -0,0 +1,77 @@
+#ifndef INC_8_BIT_COMPUTER_EMULATOR_STATEEXPLORER_H
+#define INC_8_BIT_COMPUTER_EMULATOR_STATEEXPLORER_H
+
+#include <array>
+#include <atomic>
+#include <vector>
+
+#include "Assembler.h"
+#include "ConcurrentStateSet.h"
+#include "Interpreter.h"
+
+namespace Core {
+
+    /**
+     * Finds every state a program can reach, over all the possible values in a few chosen memory locations,
+     * typically the ones defined with DB. Useful for verifying that a program always halts,
+     * and for finding the values it can output and the parts of it that are never used.
+     *
+     * The search is a breadth first search over the states of the Interpreter, one instruction at a time,
+     * spread over several threads. All the threads work on the same level of the search at the same time,
+     * and add the states they find to a shared ConcurrentStateSet. The states that were not seen before
+     * are the next level.
+     *
+     * The states are compared between instructions, where the step counter is always 0 and the bus and the ALU
+     * are derived from the registers, so they are left out.
+     */
+    class StateExplorer {
+
+    public:
+        /** Max number of addresses, since the number of starting states grows by 256 for each address. */
+        static const int MAX_ADDRESSES = 2;
+
+        struct Report {
+            size_t states = 0;
+            size_t haltingStates = 0;
+            size_t failingStates = 0;
+            /** Number of instructions in the longest run from a starting state, until it halts or loops. */
+            size_t longestRun = 0;
+            /** False if the states did not fit, and the search stopped early. */
+            bool complete = true;
+            /** Addresses with a value in the program that are never executed or read. */
+            std::vector<uint8_t> deadCode;
+            /** Every value the program can show on the display, from low to high. */
+            std::vector<uint8_t> outputs;
+        };
+
+        StateExplorer(const std::vector<Assembler::Instruction> &instructions, const std::vector<uint8_t> &addresses);
+        ~StateExplorer();
+
+        /** Explore until there are no new states, or until there are more than maxStates states. */
+        [[nodiscard]] Report explore(size_t maxStates, unsigned int threads) const;
+
+        /** Packs a state into 20 bytes: the memory, the registers, and the flags together with the program counter. */
+        [[nodiscard]] static ConcurrentStateSet::Key encode(const Interpreter::State &state);
+
+    private:
+        MemoryImage memory;
+        std::vector<uint8_t> addresses;
+        uint16_t definedAddresses;
+
+        /** What the threads find out together. */
+        struct Findings {
+            std::atomic<size_t> haltingStates{0};
+            std::atomic<size_t> failingStates{0};
+            std::atomic<uint16_t> usedAddresses{0};
+            std::array<std::atomic<uint64_t>, 4> outputs{};
+            std::atomic<bool> full{false};
+        };
+
+        void exploreLevel(const std::vector<Interpreter::State> &level, std::atomic<size_t> &nextState,
+                          ConcurrentStateSet &states, Findings &findings,
+                          std::vector<Interpreter::State> &nextLevel) const;
+        [[nodiscard]] std::vector<Interpreter::State> initialStates() const;
+    };
+}
+
+#endif //INC_8_BIT_COMPUTER_EMULATOR_STATEEXPLORER_H
@@ -1,5 +1,6 @@
 #include <iostream>
 
+#include "Log.h"
 #include "Utils.h"
 
 #include "StepCounter.h"
@@ -20,7 +21,7 @@ Core::StepCounter::~StepCounter() {
 }
 
 void Core::StepCounter::print() const {
-    printf("StepCounter: %d / 0x%02X / " BIT_3_PATTERN " \n", counter, counter, BIT_3_TO_BINARY(counter));
+    Log::printf("StepCounter: %d / 0x%02X / " BIT_3_PATTERN " \n", counter, counter, BIT_3_TO_BINARY(counter));
 }
 
 void Core::StepCounter::reset() {
@@ -49,8 +50,8 @@ void Core::StepCounter::invertedClockTicked() {
     increment();
 }
 
-void Core::StepCounter::notifyObserver() const {
-    if (observer != nullptr) {
+void Core::StepCounter::notifyObserver() {
+    if (Utils::OBSERVED && observer != nullptr && changeFilter.shouldPass(counter)) {
         observer->valueUpdated(counter);
     }
 }
@@ -59,6 +60,24 @@ void Core::StepCounter::notifyListener() const {
     stepListener->stepReady(counter);
 }
 
+Core::StepCounter::State Core::StepCounter::getState() const {
+    return {counter};
+}
+
+void Core::StepCounter::setState(const State &state) {
+    counter = state.counter;
+
+    notifyObserver();
+}
+
 void Core::StepCounter::setObserver(const std::shared_ptr<ValueObserver> &newObserver) {
     observer = newObserver;
 }
+
+void Core::StepCounter::setNotifyEveryWrite(const bool everyWrite) {
+    changeFilter.setEveryWrite(everyWrite);
+}
+
+Core::ChangeFilter::Statistics Core::StepCounter::getNotificationStatistics() const {
+    return changeFilter.getStatistics();
+}
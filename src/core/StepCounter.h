@@ -3,6 +3,7 @@
 
 #include <memory>
 
+#include "ChangeFilter.h"
 #include "ClockListener.h"
 #include "StepListener.h"
 #include "ValueObserver.h"
@@ -18,6 +19,11 @@ namespace Core {
     class StepCounter: public ClockListener {
 
     public:
+        /** Everything needed to put this step counter back the way it was. */
+        struct State {
+            uint8_t counter;
+        };
+
         explicit StepCounter(const std::shared_ptr<StepListener> &stepListener);
         ~StepCounter();
 
@@ -27,16 +33,29 @@ namespace Core {
         /** Print the current counter value to standard out. */
         void print() const;
 
+        /** Get a copy of the current state. */
+        [[nodiscard]] State getState() const;
+
+        /** Put back a state from getState(). Notifies the observer, but not the listener, since the step is already handled. */
+        void setState(const State &state);
+
         /** Set an optional external observer of this step counter. */
         void setObserver(const std::shared_ptr<ValueObserver> &newObserver);
 
+        /** Notify the observer of every write, instead of only when the value changes. Off by default. */
+        void setNotifyEveryWrite(bool everyWrite);
+
+        /** How many notifications to the observer were passed on or skipped. */
+        [[nodiscard]] ChangeFilter::Statistics getNotificationStatistics() const;
+
     private:
         uint8_t counter;
         std::shared_ptr<StepListener> stepListener;
         std::shared_ptr<ValueObserver> observer;
+        ChangeFilter changeFilter;
 
         void increment();
-        void notifyObserver() const;
+        void notifyObserver();
         void notifyListener() const;
 
         void clockTicked() override {}; // Not implemented
@@ -0,0 +1,374 @@
+#include <iostream>
+#include <limits>
+#include <thread>
+
+#include "Disassembler.h"
+#include "Instructions.h"
+#include "Utils.h"
+
+#include "Superoptimizer.h"
+
+Core::Superoptimizer::Superoptimizer(const std::vector<uint8_t> &target, const Goal goal,
+                                     const unsigned long maxCycles) {
+    if (Utils::debugL2()) {
+        std::cout << "Superoptimizer construct" << std::endl;
+    }
+
+    if (target.size() > std::numeric_limits<uint8_t>::max()) {
+        throw std::runtime_error("Superoptimizer: too many values in target " + std::to_string(target.size()));
+    }
+
+    this->target = target;
+    this->goal = goal;
+    this->maxCycles = maxCycles;
+    this->sizeLimit = 0;
+    this->splitSize = 0;
+    this->pendingCandidates = 0;
+    this->stateCount = 0;
+    this->bestScore = std::numeric_limits<unsigned long>::max();
+    this->candidateCount = 0;
+    this->duplicateCount = 0;
+    this->stealCount = 0;
+}
+
+Core::Superoptimizer::~Superoptimizer() {
+    if (Utils::debugL2()) {
+        std::cout << "Superoptimizer destruct" << std::endl;
+    }
+}
+
+Core::Superoptimizer::Solution Core::Superoptimizer::search(const uint8_t maxSize, const unsigned int threads) {
+    if (maxSize < 1 || maxSize > 16) {
+        throw std::runtime_error("Superoptimizer: size must be from 1 to 16");
+    }
+
+    best = Solution();
+    bestScore = std::numeric_limits<unsigned long>::max();
+    candidateCount = 0;
+    duplicateCount = 0;
+    stealCount = 0;
+
+    if (goal == Goal::SIZE) {
+        // Iterative deepening. The first size with a solution is the smallest
+        for (uint8_t size = 1; size <= maxSize && !best.found; size++) {
+            searchSize(size, threads);
+        }
+    } else {
+        searchSize(maxSize, threads);
+    }
+
+    return best;
+}
+
+void Core::Superoptimizer::searchSize(const uint8_t size, const unsigned int threads) {
+    if (Utils::debugL1()) {
+        std::cout << "Superoptimizer: searching programs of up to " << (int) size << " bytes" << std::endl;
+    }
+
+    sizeLimit = size;
+    // Spreading the first couple of bytes as separate work gives plenty of work to steal
+    splitSize = std::min<uint8_t>(2, size - 1);
+
+    for (auto &shard : stateShards) {
+        shard.states.clear();
+    }
+
+    stateCount = 0;
+
+    workers.clear();
+
+    for (unsigned int i = 0; i < std::max(threads, 1u); i++) {
+        workers.push_back(std::make_unique<Worker>());
+    }
+
+    Candidate root = {MemoryImage{}, Interpreter::State(), 0, 0, 0};
+
+    if (advance(root) != Progress::NEEDS_MORE) {
+        return;
+    }
+
+    push(0, root);
+
+    std::vector<std::thread> threadPool;
+
+    for (size_t i = 0; i < workers.size(); i++) {
+        threadPool.emplace_back(&Superoptimizer::runWorker, this, i);
+    }
+
+    for (auto &thread : threadPool) {
+        thread.join();
+    }
+}
+
+void Core::Superoptimizer::runWorker(const size_t index) {
+    Candidate candidate;
+
+    // A candidate is only finished after all the candidates it pushes are counted, so 0 means there is no more work
+    while (pendingCandidates > 0) {
+        if (take(index, candidate)) {
+            explore(candidate, index);
+            pendingCandidates--;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void Core::Superoptimizer::push(const size_t workerIndex, const Candidate &candidate) {
+    pendingCandidates++;
+
+    Worker &worker = *workers[workerIndex];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    worker.candidates.push_back(candidate);
+}
+
+bool Core::Superoptimizer::take(const size_t workerIndex, Candidate &candidate) {
+    // Newest work from the own queue first, to go deep and keep the queue short
+    {
+        Worker &worker = *workers[workerIndex];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+
+        if (!worker.candidates.empty()) {
+            candidate = worker.candidates.back();
+            worker.candidates.pop_back();
+            return true;
+        }
+    }
+
+    // Then the oldest work from the others, since that is likely to be the largest
+    for (size_t i = 1; i < workers.size(); i++) {
+        Worker &victim = *workers[(workerIndex + i) % workers.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+
+        if (!victim.candidates.empty()) {
+            candidate = victim.candidates.front();
+            victim.candidates.pop_front();
+            stealCount++;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void Core::Superoptimizer::explore(const Candidate &candidate, const size_t workerIndex) {
+    for (int value = 0; value <= 255; value++) {
+        Candidate child = candidate;
+        child.program[child.size] = value;
+        child.state.memory[child.size] = value;
+        child.size++;
+
+        candidateCount++;
+
+        switch (advance(child)) {
+            case Progress::SOLVED:
+                offer(child);
+                break;
+            case Progress::NEEDS_MORE:
+                if (child.size < sizeLimit && !isDuplicate(child)) {
+                    if (child.size <= splitSize) {
+                        push(workerIndex, child);
+                    } else {
+                        explore(child, workerIndex);
+                    }
+                }
+                break;
+            case Progress::DEAD:
+                break;
+        }
+    }
+}
+
+Core::Superoptimizer::Progress Core::Superoptimizer::advance(Candidate &candidate) const {
+    Interpreter::State &state = candidate.state;
+
+    // Loop detection with Brent's algorithm. Everything the program depends on is decided while it runs,
+    // so coming back to a state it has been in before means it's stuck in that loop forever
+    Interpreter::State savedState = state;
+    unsigned long power = 1;
+    unsigned long length = 0;
+
+    while (true) {
+        // The next instruction is not decided yet. Memory past the size limit is always 0
+        if (isUndecided(candidate, state.programCounter)) {
+            return Progress::NEEDS_MORE;
+        }
+
+        const uint8_t instruction = state.memory[state.programCounter];
+        const uint8_t opcode = instruction >> 4;
+        const uint8_t operand = instruction & 0x0F;
+
+        // The instruction works on memory that is not decided yet
+        if ((opcode == Instructions::LDA.opcode || opcode == Instructions::ADD.opcode ||
+             opcode == Instructions::SUB.opcode || opcode == Instructions::STA.opcode) &&
+            isUndecided(candidate, operand)) {
+            return Progress::NEEDS_MORE;
+        }
+
+        if (opcode == Instructions::OUT.opcode) {
+            if (candidate.outputs >= target.size() || target[candidate.outputs] != state.aRegister) {
+                return Progress::DEAD;
+            }
+
+            candidate.outputs++;
+        }
+
+        candidate.cycles += Interpreter::step(state);
+
+        if (state.failed || candidate.cycles > maxCycles) {
+            return Progress::DEAD;
+        }
+
+        if (state.halted) {
+            return candidate.outputs == target.size() && canMatch(candidate.size, candidate.cycles) ?
+                   Progress::SOLVED : Progress::DEAD;
+        }
+
+        // Can not match the best solution anymore, even if the remaining values are output right away before HLT
+        const unsigned long remainingCycles = (target.size() - candidate.outputs) * Interpreter::INSTRUCTION_CYCLES +
+                                              Interpreter::HALT_CYCLES;
+
+        if (!canMatch(candidate.size, candidate.cycles + remainingCycles)) {
+            return Progress::DEAD;
+        }
+
+        if (state == savedState) {
+            return Progress::DEAD;
+        }
+
+        if (++length == power) {
+            savedState = state;
+            power *= 2;
+            length = 0;
+        }
+    }
+}
+
+bool Core::Superoptimizer::isUndecided(const Candidate &candidate, const uint8_t address) const {
+    return address >= candidate.size && address < sizeLimit;
+}
+
+bool Core::Superoptimizer::isDuplicate(const Candidate &candidate) {
+    // Memory that is not decided yet is still 0, so only the size is needed to know how much is decided
+    const Interpreter::State &state = candidate.state;
+    StateKey key{};
+
+    std::copy(state.memory.begin(), state.memory.end(), key.begin());
+    key[16] = state.aRegister;
+    key[17] = state.bRegister;
+    key[18] = state.programCounter;
+    key[19] = state.carryFlag | (state.zeroFlag << 1);
+    key[20] = candidate.outputs;
+    key[21] = candidate.size;
+
+    StateShard &shard = stateShards[StateKeyHash()(key) % STATE_SHARDS];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto existing = shard.states.find(key);
+
+    if (existing != shard.states.end()) {
+        Visit &visit = existing->second;
+
+        if (visit.cycles < candidate.cycles ||
+            (visit.cycles == candidate.cycles && visit.program <= candidate.program)) {
+            duplicateCount++;
+            return true;
+        }
+
+        // Same state, but faster this time
+        visit = {candidate.cycles, candidate.program};
+        return false;
+    }
+
+    if (stateCount < MAX_STATES) {
+        shard.states.emplace(key, Visit{candidate.cycles, candidate.program});
+        stateCount++;
+    }
+
+    return false;
+}
+
+void Core::Superoptimizer::offer(const Candidate &candidate) {
+    std::lock_guard<std::mutex> lock(solutionMutex);
+
+    const unsigned long candidateScore = score(candidate.size, candidate.cycles);
+
+    if (candidateScore < bestScore || (candidateScore == bestScore && candidate.program < best.memory)) {
+        best.found = true;
+        best.memory = candidate.program; // The program may have changed itself while running
+        best.size = candidate.size;
+        best.cycles = candidate.cycles;
+        bestScore = candidateScore;
+
+        if (Utils::debugL1()) {
+            std::cout << "Superoptimizer: found solution with " << (int) best.size << " bytes and " << best.cycles
+                      << " cycles" << std::endl;
+        }
+    }
+}
+
+bool Core::Superoptimizer::canMatch(const uint8_t size, const unsigned long cycles) const {
+    return score(size, cycles) <= bestScore;
+}
+
+unsigned long Core::Superoptimizer::score(const uint8_t size, const unsigned long cycles) const {
+    if (goal == Goal::CYCLES) {
+        return cycles * 32 + size;
+    }
+
+    // Solutions are only looked for at the smallest size, so it's just about cycles at that point
+    return cycles;
+}
+
+Core::Superoptimizer::Statistics Core::Superoptimizer::getStatistics() const {
+    return {candidateCount, duplicateCount, stealCount};
+}
+
+std::string Core::Superoptimizer::toAssembly(const Solution &solution) const {
+    Interpreter::State state = Interpreter::initialState(solution.memory);
+    std::array<bool, 16> executed{};
+    std::array<bool, 16> read{};
+    unsigned long cycles = 0;
+
+    while (!state.halted && !state.failed && cycles <= maxCycles) {
+        const uint8_t instruction = state.memory[state.programCounter];
+        const uint8_t opcode = instruction >> 4;
+
+        executed[state.programCounter] = true;
+
+        if (opcode == Instructions::LDA.opcode || opcode == Instructions::ADD.opcode ||
+            opcode == Instructions::SUB.opcode) {
+            read[instruction & 0x0F] = true;
+        }
+
+        cycles += Interpreter::step(state);
+    }
+
+    std::string source;
+
+    for (uint8_t address = 0; address < solution.size; address++) {
+        const uint8_t value = solution.memory[address];
+
+        if (executed[address] && !read[address]) {
+            source += Disassembler::disassemble(value) + "\n";
+        } else if (executed[address]) {
+            source += "DB " + std::to_string(value) + " ; " + Disassembler::disassemble(value) + "\n";
+        } else {
+            source += "DB " + std::to_string(value) + "\n";
+        }
+    }
+
+    return source;
+}
+
+size_t Core::Superoptimizer::StateKeyHash::operator()(const StateKey &key) const {
+    // FNV-1a
+    size_t hash = 14695981039346656037ULL;
+
+    for (const uint8_t value : key) {
+        hash ^= value;
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
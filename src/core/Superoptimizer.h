@@ -0,0 +1,145 @@
+#ifndef INC_8_BIT_COMPUTER_EMULATOR_SUPEROPTIMIZER_H
+#define INC_8_BIT_COMPUTER_EMULATOR_SUPEROPTIMIZER_H
+
+#include <array>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Interpreter.h"
+#include "MemoryImage.h"
+
+namespace Core {
+
+    /**
+     * Searches for the smallest or fastest program that outputs a specific sequence of values, and then halts.
+     *
+     * Programs are built one byte at a time from address 0, trying all 256 values at each address.
+     * Each candidate is executed with the Interpreter while it's built, until it needs a byte that is not
+     * decided yet. This makes it possible to prune large parts of the search:
+     *
+     * - Candidates that output a value that does not match the target, or fail, are dropped with all
+     *   the programs that start with the same bytes.
+     * - Candidates that end up in the same state as an earlier candidate are duplicates, and only explored once.
+     * - Candidates that already use more cycles than the best solution so far are dropped.
+     *
+     * The search is spread over several threads with work stealing. Each thread has its own queue of candidates
+     * to explore, and takes work from the other queues when its own queue is empty.
+     */
+    class Superoptimizer {
+
+    public:
+        /**
+         * What to optimize for. Ties are decided by the other, and then by the lowest bytes in the program,
+         * so the same solution is found no matter how the work is spread over the threads.
+         */
+        enum class Goal {
+            SIZE, CYCLES
+        };
+
+        struct Solution {
+            bool found = false;
+            MemoryImage memory{};
+            uint8_t size = 0;
+            unsigned long cycles = 0;
+        };
+
+        struct Statistics {
+            unsigned long candidates = 0;
+            unsigned long duplicates = 0;
+            unsigned long steals = 0;
+        };
+
+        Superoptimizer(const std::vector<uint8_t> &target, Goal goal, unsigned long maxCycles);
+        ~Superoptimizer();
+
+        /** Search programs of up to maxSize bytes, using the specified number of threads. */
+        Solution search(uint8_t maxSize, unsigned int threads);
+
+        /** Statistics from the last search. */
+        [[nodiscard]] Statistics getStatistics() const;
+
+        /**
+         * Turns a solution into assembly source code. Bytes that are executed are disassembled into instructions,
+         * and bytes that are only used as data become DB.
+         */
+        [[nodiscard]] std::string toAssembly(const Solution &solution) const;
+
+    private:
+        /** Only keep track of this many states for finding duplicates, to limit the memory use. */
+        static const size_t MAX_STATES = 1 << 22;
+        static const int STATE_SHARDS = 64;
+
+        /** A partially built program, with the state after running it as far as possible. */
+        struct Candidate {
+            MemoryImage program;
+            Interpreter::State state;
+            uint8_t size;
+            uint8_t outputs;
+            unsigned long cycles;
+        };
+
+        enum class Progress {
+            NEEDS_MORE, DEAD, SOLVED
+        };
+
+        using StateKey = std::array<uint8_t, 22>;
+
+        struct StateKeyHash {
+            size_t operator()(const StateKey &key) const;
+        };
+
+        /** The fastest way found to a state. Ties are decided by the program, to get the same result every time. */
+        struct Visit {
+            unsigned long cycles;
+            MemoryImage program;
+        };
+
+        struct StateShard {
+            std::mutex mutex;
+            std::unordered_map<StateKey, Visit, StateKeyHash> states;
+        };
+
+        struct Worker {
+            std::mutex mutex;
+            std::deque<Candidate> candidates;
+        };
+
+        std::vector<uint8_t> target;
+        Goal goal;
+        unsigned long maxCycles;
+
+        uint8_t sizeLimit;
+        uint8_t splitSize;
+        std::vector<std::unique_ptr<Worker>> workers;
+        std::atomic<long> pendingCandidates;
+        std::array<StateShard, STATE_SHARDS> stateShards;
+        std::atomic<size_t> stateCount;
+
+        std::mutex solutionMutex;
+        Solution best;
+        std::atomic<unsigned long> bestScore;
+
+        std::atomic<unsigned long> candidateCount;
+        std::atomic<unsigned long> duplicateCount;
+        std::atomic<unsigned long> stealCount;
+
+        void searchSize(uint8_t size, unsigned int threads);
+        void runWorker(size_t index);
+        void explore(const Candidate &candidate, size_t workerIndex);
+        void push(size_t workerIndex, const Candidate &candidate);
+        bool take(size_t workerIndex, Candidate &candidate);
+        Progress advance(Candidate &candidate) const;
+        [[nodiscard]] bool isUndecided(const Candidate &candidate, uint8_t address) const;
+        bool isDuplicate(const Candidate &candidate);
+        void offer(const Candidate &candidate);
+        [[nodiscard]] bool canMatch(uint8_t size, unsigned long cycles) const;
+        [[nodiscard]] unsigned long score(uint8_t size, unsigned long cycles) const;
+    };
+}
+
+#endif //INC_8_BIT_COMPUTER_EMULATOR_SUPEROPTIMIZER_H
@@ -0,0 +1,178 @@
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+
+#include "Emulator.h"
+#include "OutputCollector.h"
+#include "Utils.h"
+
+#include "SweepRunner.h"
+
+Core::SweepRunner::SweepRunner(const std::vector<Assembler::Instruction> &instructions,
+                               const std::vector<uint8_t> &addresses) {
+    if (Utils::debugL2()) {
+        std::cout << "SweepRunner construct" << std::endl;
+    }
+
+    // The outputs are collected with an observer, which the headless core never notifies
+    if (!Utils::OBSERVED) {
+        throw std::runtime_error("SweepRunner: not available in the headless core");
+    }
+
+    if (addresses.empty() || addresses.size() > MAX_ADDRESSES) {
+        throw std::runtime_error("SweepRunner: number of addresses must be from 1 to " + std::to_string(MAX_ADDRESSES));
+    }
+
+    this->instructions = instructions;
+    this->addresses = addresses;
+
+    for (const uint8_t address : addresses) {
+        if (address > Utils::FOUR_BITS_MAX) {
+            throw std::runtime_error("SweepRunner: address out of bounds " + std::to_string(address));
+        }
+
+        const bool defined = std::any_of(instructions.begin(), instructions.end(), [address](const auto &instruction) {
+            return instruction.address == address;
+        });
+
+        // Memory that is not defined by the program is 0, so it's fine to add it when missing.
+        // That also makes sure there is something to load
+        if (!defined) {
+            this->instructions.push_back({std::bitset<4>(address), 0, 0});
+        }
+    }
+}
+
+Core::SweepRunner::~SweepRunner() {
+    if (Utils::debugL2()) {
+        std::cout << "SweepRunner destruct" << std::endl;
+    }
+}
+
+size_t Core::SweepRunner::combinations() const {
+    return (size_t) 1 << (8 * addresses.size());
+}
+
+std::vector<Core::SweepRunner::Result> Core::SweepRunner::run(const unsigned long maxCycles,
+                                                              const unsigned int threads) const {
+    std::vector<Result> results(combinations());
+    std::atomic<size_t> nextCombination(0);
+    std::vector<std::thread> workers;
+
+    for (unsigned int i = 0; i < std::max(threads, 1u); i++) {
+        workers.emplace_back(&SweepRunner::runWorker, this, std::ref(results), std::ref(nextCombination), maxCycles);
+    }
+
+    for (auto &worker : workers) {
+        worker.join();
+    }
+
+    if (cache != nullptr) {
+        cache->flush();
+    }
+
+    return results;
+}
+
+void Core::SweepRunner::runWorker(std::vector<Result> &results, std::atomic<size_t> &nextCombination,
+                                  const unsigned long maxCycles) const {
+    // Small chunks keep the threads busy until the end, without fighting over the counter all the time
+    const size_t chunkSize = 64;
+
+    Emulator emulator;
+    auto collector = std::make_shared<OutputCollector>();
+
+    emulator.setOutputRegisterObserver(collector);
+    emulator.setNotifyEveryWrite(true); // The same value can be output more than once
+
+    // Load once, and then only restore the state after loading before each run, with the memory patched
+    emulator.load(instructions);
+    Snapshot loaded = emulator.snapshot();
+
+    while (true) {
+        const size_t first = nextCombination.fetch_add(chunkSize);
+
+        if (first >= results.size()) {
+            break;
+        }
+
+        const size_t last = std::min(first + chunkSize, results.size());
+
+        for (size_t combination = first; combination < last; combination++) {
+            Result &result = results[combination];
+            result.inputs = inputsFor(combination);
+
+            for (size_t i = 0; i < addresses.size(); i++) {
+                loaded.randomAccessMemory.memory[addresses[i]] = result.inputs[i];
+            }
+
+            const ResultCache::Key key{loaded.randomAccessMemory.memory, maxCycles, ResultCache::Engine::EMULATOR};
+            ResultCache::Run run;
+
+            if (cache != nullptr && cache->find(key, run)) {
+                result.outputs = run.outputs;
+                result.cycles = run.cycles;
+                result.halted = run.halted;
+                result.failed = run.failed;
+                continue;
+            }
+
+            emulator.restore(loaded);
+            collector->values.clear(); // Skip the value from the restore
+
+            try {
+                result.cycles = emulator.runSynchronous(maxCycles);
+                result.halted = emulator.isHalted();
+                result.failed = false;
+            } catch (const std::runtime_error &e) {
+                result.cycles = 0;
+                result.halted = false;
+                result.failed = true;
+            }
+
+            result.outputs = collector->values;
+
+            if (cache != nullptr) {
+                cache->store(key, {result.outputs, result.cycles, result.halted, result.failed});
+            }
+        }
+    }
+}
+
+void Core::SweepRunner::setCache(const std::shared_ptr<ResultCache> &newCache) {
+    cache = newCache;
+}
+
+std::vector<uint8_t> Core::SweepRunner::inputsFor(const size_t combination) const {
+    std::vector<uint8_t> inputs(addresses.size());
+
+    for (size_t i = 0; i < addresses.size(); i++) {
+        const size_t shift = 8 * (addresses.size() - 1 - i);
+        inputs[i] = (combination >> shift) & 0xFF;
+    }
+
+    return inputs;
+}
+
+void Core::SweepRunner::printTable(std::ostream &stream, const std::vector<Result> &results) const {
+    for (const uint8_t address : addresses) {
+        stream << "m" << (int) address << "\t";
+    }
+
+    stream << "cycles\tstatus\toutputs\n";
+
+    for (const Result &result : results) {
+        for (const uint8_t input : result.inputs) {
+            stream << (int) input << "\t";
+        }
+
+        stream << result.cycles << "\t" << (result.failed ? "failed" : result.halted ? "halted" : "timeout") << "\t";
+
+        for (size_t i = 0; i < result.outputs.size(); i++) {
+            stream << (i > 0 ? " " : "") << (int) result.outputs[i];
+        }
+
+        stream << "\n";
+    }
+}
@@ -0,0 +1,65 @@
+#ifndef INC_8_BIT_COMPUTER_EMULATOR_SWEEPRUNNER_H
+#define INC_8_BIT_COMPUTER_EMULATOR_SWEEPRUNNER_H
+
+#include <atomic>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+#include "Assembler.h"
+#include "ResultCache.h"
+
+namespace Core {
+
+    /**
+     * Runs a program over every combination of values in a few chosen memory locations, typically the ones
+     * defined with DB. With 1 address that is 256 runs, and with 2 addresses it's 256 x 256 runs.
+     *
+     * The program is assembled once by the caller. Each worker thread has its own emulator that loads the program
+     * once, and takes a snapshot. Before each run the snapshot is restored, with the chosen memory locations patched.
+     *
+     * Every run executes synchronously until the program halts, or the cycle budget is used up.
+     */
+    class SweepRunner {
+
+    public:
+        /** Max number of addresses to sweep, since the number of runs grows by 256 for each address. */
+        static const int MAX_ADDRESSES = 3;
+
+        struct Result {
+            std::vector<uint8_t> inputs;
+            std::vector<uint8_t> outputs;
+            unsigned long cycles;
+            bool halted;
+            bool failed;
+        };
+
+        SweepRunner(const std::vector<Assembler::Instruction> &instructions, const std::vector<uint8_t> &addresses);
+        ~SweepRunner();
+
+        /** Number of runs needed to cover all the combinations. */
+        [[nodiscard]] size_t combinations() const;
+
+        /**
+         * Run all the combinations, spread over the specified number of threads.
+         * The results are in the order of the combinations, with the value at the last address counting fastest.
+         */
+        [[nodiscard]] std::vector<Result> run(unsigned long maxCycles, unsigned int threads) const;
+
+        /** Look up each run in the cache before running it, and add the new results to it. Optional. */
+        void setCache(const std::shared_ptr<ResultCache> &newCache);
+
+        /** Write the results as a compact tab separated table, with one line per combination. */
+        void printTable(std::ostream &stream, const std::vector<Result> &results) const;
+
+    private:
+        std::vector<Assembler::Instruction> instructions;
+        std::vector<uint8_t> addresses;
+        std::shared_ptr<ResultCache> cache;
+
+        void runWorker(std::vector<Result> &results, std::atomic<size_t> &nextCombination, unsigned long maxCycles) const;
+        [[nodiscard]] std::vector<uint8_t> inputsFor(size_t combination) const;
+    };
+}
+
+#endif //INC_8_BIT_COMPUTER_EMULATOR_SWEEPRUNNER_H
@@ -0,0 +1,405 @@
+#include <iostream>
+
+#include "Instructions.h"
+#include "Interpreter.h"
+#include "Utils.h"
+
+#include "SymbolicInterpreter.h"
+
+bool Core::SymbolicInterpreter::Expression::isConstant() const {
+    for (const uint8_t coefficient : coefficients) {
+        if (coefficient != 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool Core::SymbolicInterpreter::Expression::operator==(const Expression &other) const {
+    return constant == other.constant && coefficients == other.coefficients;
+}
+
+bool Core::SymbolicInterpreter::Expression::operator!=(const Expression &other) const {
+    return !(*this == other);
+}
+
+Core::SymbolicInterpreter::SymbolicInterpreter(const MemoryImage &image, const std::vector<uint8_t> &symbols,
+                                               const unsigned long maxCycles, const size_t maxPaths) {
+    if (Utils::debugL2()) {
+        std::cout << "SymbolicInterpreter construct" << std::endl;
+    }
+
+    for (const uint8_t address : symbols) {
+        if (address > 15) {
+            throw std::runtime_error("SymbolicInterpreter: symbol address out of range: " + std::to_string(address));
+        }
+    }
+
+    this->image = image;
+    this->symbols = symbols;
+    this->maxCycles = maxCycles;
+    this->maxPaths = maxPaths;
+}
+
+Core::SymbolicInterpreter::~SymbolicInterpreter() {
+    if (Utils::debugL2()) {
+        std::cout << "SymbolicInterpreter destruct" << std::endl;
+    }
+}
+
+Core::SymbolicInterpreter::Result Core::SymbolicInterpreter::run() {
+    statistics = Statistics();
+
+    State initial;
+
+    for (uint8_t address = 0; address < 16; address++) {
+        initial.memory[address].constant = image[address];
+    }
+
+    for (const uint8_t address : symbols) {
+        initial.memory[address].constant = 0;
+        initial.memory[address].coefficients[address] = 1;
+    }
+
+    // The values as loaded take the first path, since it has no conditions yet
+    initial.path = {{}, {}, 0, End::HALTED, true, image};
+
+    Result result{{}, true};
+    std::vector<State> pending = {initial};
+
+    while (!pending.empty() && result.paths.size() < maxPaths) {
+        State state = pending.back();
+        pending.pop_back();
+
+        if (follow(state, pending)) {
+            result.paths.push_back(state.path);
+        }
+    }
+
+    result.complete = pending.empty();
+
+    if (Utils::debugL1()) {
+        std::cout << "SymbolicInterpreter: found " << result.paths.size() << " paths after "
+                  << statistics.instructions << " instructions" << std::endl;
+    }
+
+    return result;
+}
+
+Core::SymbolicInterpreter::Statistics Core::SymbolicInterpreter::getStatistics() const {
+    return statistics;
+}
+
+Core::SymbolicInterpreter::Satisfiability Core::SymbolicInterpreter::solve(const std::vector<Condition> &conditions,
+                                                                           MemoryImage &example) {
+    statistics.solverChecks++;
+
+    bool satisfied = true;
+
+    for (const Condition &condition : conditions) {
+        satisfied = satisfied && evaluate(condition, example);
+    }
+
+    if (satisfied) {
+        return Satisfiability::SATISFIABLE;
+    }
+
+    // Try the symbols in order of address, and check each condition as soon as all its symbols have a value
+    std::vector<uint8_t> order;
+    std::array<int, 16> orderIndex{};
+    orderIndex.fill(-1);
+
+    for (uint8_t address = 0; address < 16; address++) {
+        for (const Condition &condition : conditions) {
+            if (orderIndex[address] == -1 &&
+                (condition.left.coefficients[address] != 0 || condition.right.coefficients[address] != 0)) {
+                orderIndex[address] = order.size();
+                order.push_back(address);
+            }
+        }
+    }
+
+    std::vector<std::vector<size_t>> decidedAt(order.size());
+
+    for (size_t index = 0; index < conditions.size(); index++) {
+        int last = -1;
+
+        for (uint8_t address = 0; address < 16; address++) {
+            if (conditions[index].left.coefficients[address] != 0 ||
+                conditions[index].right.coefficients[address] != 0) {
+                last = orderIndex[address];
+            }
+        }
+
+        if (last == -1) {
+            if (!evaluate(conditions[index], example)) {
+                return Satisfiability::UNSATISFIABLE;
+            }
+        } else {
+            decidedAt[last].push_back(index);
+        }
+    }
+
+    unsigned long steps = 0;
+    const bool found = searchValues(conditions, order, decidedAt, 0, steps, example);
+    statistics.solverSteps += steps;
+
+    if (found) {
+        return Satisfiability::SATISFIABLE;
+    }
+
+    return steps >= MAX_SOLVER_STEPS ? Satisfiability::UNKNOWN : Satisfiability::UNSATISFIABLE;
+}
+
+uint8_t Core::SymbolicInterpreter::evaluate(const Expression &expression, const MemoryImage &memory) {
+    uint8_t value = expression.constant;
+
+    for (uint8_t address = 0; address < 16; address++) {
+        value += expression.coefficients[address] * memory[address];
+    }
+
+    return value;
+}
+
+bool Core::SymbolicInterpreter::evaluate(const Condition &condition, const MemoryImage &memory) {
+    const uint8_t left = evaluate(condition.left, memory);
+    const uint8_t right = evaluate(condition.right, memory);
+
+    // The same way as the Interpreter
+    const uint16_t result = left + (condition.subtract ? (uint8_t) -(unsigned int) right : right);
+    const bool flag = condition.flag == Flag::CARRY ? result > 255 : (uint8_t) result == 0;
+
+    return flag == condition.value;
+}
+
+std::string Core::SymbolicInterpreter::toString(const Expression &expression) {
+    std::string text;
+
+    for (uint8_t address = 0; address < 16; address++) {
+        const uint8_t coefficient = expression.coefficients[address];
+
+        if (coefficient == 0) {
+            continue;
+        }
+
+        // Coefficients from 128 read better as subtraction, since it's modulo 256 anyway
+        const bool negative = coefficient >= 128;
+        const int magnitude = negative ? 256 - coefficient : coefficient;
+
+        if (text.empty()) {
+            text += negative ? "-" : "";
+        } else {
+            text += negative ? " - " : " + ";
+        }
+
+        text += (magnitude == 1 ? "" : std::to_string(magnitude) + "*") + "x" + std::to_string(address);
+    }
+
+    if (text.empty()) {
+        return std::to_string(expression.constant);
+    }
+
+    if (expression.constant >= 128) {
+        text += " - " + std::to_string(256 - expression.constant);
+    } else if (expression.constant > 0) {
+        text += " + " + std::to_string(expression.constant);
+    }
+
+    return text;
+}
+
+std::string Core::SymbolicInterpreter::toString(const Condition &condition) {
+    if (condition.flag == Flag::ZERO) {
+        const Expression result = add(condition.left, condition.subtract ? negate(condition.right) : condition.right);
+        return toString(result) + (condition.value ? " is 0" : " is not 0");
+    }
+
+    std::string left = toString(condition.left);
+    std::string right = toString(condition.right);
+
+    if (left.find(' ') != std::string::npos) {
+        left = "(" + left + ")";
+    }
+
+    if (right.find(' ') != std::string::npos) {
+        right = "(" + right + ")";
+    }
+
+    return left + (condition.subtract ? " - " : " + ") + right + (condition.value ? " carries" : " does not carry");
+}
+
+bool Core::SymbolicInterpreter::follow(State &state, std::vector<State> &pending) {
+    while (true) {
+        if (state.path.cycles >= maxCycles) {
+            state.path.end = End::CYCLE_LIMIT;
+            return true;
+        }
+
+        const Expression &instruction = state.memory[state.programCounter];
+
+        if (!instruction.isConstant()) {
+            state.path.end = End::SYMBOLIC_CODE;
+            return true;
+        }
+
+        const uint8_t opcode = instruction.constant >> 4;
+        const uint8_t operand = instruction.constant & 0x0F;
+
+        statistics.instructions++;
+        state.programCounter = (state.programCounter + 1) % 16;
+
+        const bool unknown = opcode > Instructions::JZ.opcode && opcode < Instructions::OUT.opcode;
+
+        if (opcode == Instructions::HLT.opcode || unknown) {
+            state.path.cycles += Interpreter::HALT_CYCLES;
+            state.path.end = opcode == Instructions::HLT.opcode ? End::HALTED : End::FAILED;
+            return true;
+        }
+
+        state.path.cycles += Interpreter::INSTRUCTION_CYCLES;
+
+        switch (opcode) {
+            case Instructions::LDA.opcode:
+                state.aRegister = state.memory[operand];
+                break;
+            case Instructions::ADD.opcode:
+            case Instructions::SUB.opcode: {
+                const bool subtract = opcode == Instructions::SUB.opcode;
+                state.bRegister = state.memory[operand];
+                state.flagsSet = true;
+                state.flagsLeft = state.aRegister;
+                state.flagsRight = state.bRegister;
+                state.flagsSubtract = subtract;
+                state.aRegister = add(state.aRegister, subtract ? negate(state.bRegister) : state.bRegister);
+                break;
+            }
+            case Instructions::STA.opcode:
+                state.memory[operand] = state.aRegister;
+                break;
+            case Instructions::LDI.opcode:
+                state.aRegister = Expression();
+                state.aRegister.constant = operand;
+                break;
+            case Instructions::JMP.opcode:
+                state.programCounter = operand;
+                break;
+            case Instructions::JC.opcode:
+                if (!branch(state, Flag::CARRY, operand, pending)) {
+                    return false;
+                }
+                break;
+            case Instructions::JZ.opcode:
+                if (!branch(state, Flag::ZERO, operand, pending)) {
+                    return false;
+                }
+                break;
+            case Instructions::OUT.opcode:
+                state.path.outputs.push_back(state.aRegister);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+bool Core::SymbolicInterpreter::branch(State &state, const Flag flag, const uint8_t target,
+                                       std::vector<State> &pending) {
+    // Both flags are off until the first ADD or SUB
+    if (!state.flagsSet) {
+        return true;
+    }
+
+    const Condition jumps = {state.flagsLeft, state.flagsRight, state.flagsSubtract, flag, true};
+
+    if (jumps.left.isConstant() && jumps.right.isConstant()) {
+        if (evaluate(jumps, image)) {
+            state.programCounter = target;
+        }
+
+        return true;
+    }
+
+    State taken = state;
+    taken.programCounter = target;
+    taken.path.conditions.push_back(jumps);
+    const Satisfiability takenSatisfiability = solve(taken.path.conditions, taken.path.example);
+    taken.path.solved = takenSatisfiability == Satisfiability::SATISFIABLE;
+
+    Condition staysCondition = jumps;
+    staysCondition.value = false;
+    state.path.conditions.push_back(staysCondition);
+    const Satisfiability staysSatisfiability = solve(state.path.conditions, state.path.example);
+    state.path.solved = staysSatisfiability == Satisfiability::SATISFIABLE;
+
+    if (staysSatisfiability == Satisfiability::UNSATISFIABLE) {
+        if (takenSatisfiability == Satisfiability::UNSATISFIABLE) {
+            // Only possible when the solver gave up on an earlier condition that was impossible
+            return false;
+        }
+
+        state = taken;
+    } else if (takenSatisfiability != Satisfiability::UNSATISFIABLE) {
+        pending.push_back(taken);
+    }
+
+    return true;
+}
+
+bool Core::SymbolicInterpreter::searchValues(const std::vector<Condition> &conditions,
+                                             const std::vector<uint8_t> &order,
+                                             const std::vector<std::vector<size_t>> &decidedAt, const size_t index,
+                                             unsigned long &steps, MemoryImage &example) {
+    if (index == order.size()) {
+        return true;
+    }
+
+    const uint8_t address = order[index];
+    const uint8_t start = example[address];
+
+    // Starting from the value in the example keeps the values close to the ones in the program
+    for (int offset = 0; offset < 256; offset++) {
+        if (steps >= MAX_SOLVER_STEPS) {
+            break;
+        }
+
+        steps++;
+        example[address] = start + offset;
+        bool satisfied = true;
+
+        for (const size_t condition : decidedAt[index]) {
+            satisfied = satisfied && evaluate(conditions[condition], example);
+        }
+
+        if (satisfied && searchValues(conditions, order, decidedAt, index + 1, steps, example)) {
+            return true;
+        }
+    }
+
+    example[address] = start;
+
+    return false;
+}
+
+Core::SymbolicInterpreter::Expression Core::SymbolicInterpreter::add(const Expression &left,
+                                                                     const Expression &right) {
+    Expression sum;
+    sum.constant = left.constant + right.constant;
+
+    for (uint8_t address = 0; address < 16; address++) {
+        sum.coefficients[address] = left.coefficients[address] + right.coefficients[address];
+    }
+
+    return sum;
+}
+
+Core::SymbolicInterpreter::Expression Core::SymbolicInterpreter::negate(const Expression &expression) {
+    Expression negated;
+    negated.constant = -expression.constant;
+
+    for (uint8_t address = 0; address < 16; address++) {
+        negated.coefficients[address] = -expression.coefficients[address];
+    }
+
+    return negated;
+}
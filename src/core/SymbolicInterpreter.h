@@ -0,0 +1,155 @@
+#ifndef INC_8_BIT_COMPUTER_EMULATOR_SYMBOLICINTERPRETER_H
+#define INC_8_BIT_COMPUTER_EMULATOR_SYMBOLICINTERPRETER_H
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "MemoryImage.h"
+
+namespace Core {
+
+    /**
+     * Runs a program with some of the memory locations as unknown inputs, to find every way it can go
+     * without trying all the input values one by one.
+     *
+     * Each input is an 8-bit symbol, named after the address, like x14. The only arithmetic is ADD and SUB,
+     * so every value in the computer is a linear expression of the symbols, modulo 256. The flags are only
+     * known as conditions on the last ADD or SUB, and a JC or JZ that depends on the symbols splits the path
+     * in two. Each path keeps the conditions it took, and a small built-in solver checks that some input can
+     * actually take it, and finds an example of one.
+     *
+     * The result is a handful of paths, with the outputs as expressions and the number of clock cycles,
+     * which together cover every combination of inputs. Loops with a symbolic exit give a path per iteration.
+     */
+    class SymbolicInterpreter {
+
+    public:
+        /** constant + coefficients[0] * x0 + ... + coefficients[15] * x15, modulo 256. */
+        struct Expression {
+            uint8_t constant = 0;
+            std::array<uint8_t, 16> coefficients{};
+
+            [[nodiscard]] bool isConstant() const;
+            bool operator==(const Expression &other) const;
+            bool operator!=(const Expression &other) const;
+        };
+
+        enum class Flag {
+            CARRY, ZERO
+        };
+
+        /** The flag from left + right, or left - right, is the value. */
+        struct Condition {
+            Expression left;
+            Expression right;
+            bool subtract;
+            Flag flag;
+            bool value;
+        };
+
+        /** How a path ends. */
+        enum class End {
+            HALTED,
+            /** On an unknown opcode. */
+            FAILED,
+            /** Still running at the maximum number of cycles. */
+            CYCLE_LIMIT,
+            /** About to execute a value that depends on the symbols. */
+            SYMBOLIC_CODE
+        };
+
+        /** Whether any input can satisfy the conditions. */
+        enum class Satisfiability {
+            SATISFIABLE, UNSATISFIABLE,
+            /** The solver gave up. */
+            UNKNOWN
+        };
+
+        struct Path {
+            std::vector<Condition> conditions;
+            std::vector<Expression> outputs;
+            unsigned long cycles;
+            End end;
+            /** Whether the example is known to take this path. */
+            bool solved;
+            /** The memory as loaded, with values for the symbols that take this path. */
+            MemoryImage example;
+        };
+
+        struct Result {
+            std::vector<Path> paths;
+            /** Whether every path was explored, and not stopped by the maximum number of paths. */
+            bool complete;
+        };
+
+        struct Statistics {
+            unsigned long instructions = 0;
+            unsigned long solverChecks = 0;
+            unsigned long solverSteps = 0;
+        };
+
+        SymbolicInterpreter(const MemoryImage &image, const std::vector<uint8_t> &symbols, unsigned long maxCycles,
+                            size_t maxPaths);
+        ~SymbolicInterpreter();
+
+        /** Find all the paths through the program, starting at address 0. */
+        Result run();
+
+        /** Statistics from the last run. */
+        [[nodiscard]] Statistics getStatistics() const;
+
+        /**
+         * Find values for the symbols that satisfy all the conditions. The example is tried first, and is
+         * changed into the values found.
+         */
+        Satisfiability solve(const std::vector<Condition> &conditions, MemoryImage &example);
+
+        /** The value of the expression, with the symbols from the memory. */
+        [[nodiscard]] static uint8_t evaluate(const Expression &expression, const MemoryImage &memory);
+
+        /** Whether the condition holds, with the symbols from the memory. */
+        [[nodiscard]] static bool evaluate(const Condition &condition, const MemoryImage &memory);
+
+        /** The expression as text, like "x14 - x15 + 3". */
+        [[nodiscard]] static std::string toString(const Expression &expression);
+
+        /** The condition as text, like "x14 - x15 carries" or "x14 + 1 is not 0". */
+        [[nodiscard]] static std::string toString(const Condition &condition);
+
+    private:
+        /** Give up on solving after this many values tried. */
+        static const unsigned long MAX_SOLVER_STEPS = 1 << 24;
+
+        /** What the computer looks like partway through a path. */
+        struct State {
+            std::array<Expression, 16> memory;
+            Expression aRegister;
+            Expression bRegister;
+            uint8_t programCounter = 0;
+            /** The last ADD or SUB, which the flags come from. Both flags are off before the first. */
+            bool flagsSet = false;
+            Expression flagsLeft;
+            Expression flagsRight;
+            bool flagsSubtract = false;
+            Path path;
+        };
+
+        MemoryImage image;
+        std::vector<uint8_t> symbols;
+        unsigned long maxCycles;
+        size_t maxPaths;
+        Statistics statistics;
+
+        /** Run the path until it ends, and put any other way it could go on the pending paths. */
+        bool follow(State &state, std::vector<State> &pending);
+        bool branch(State &state, Flag flag, uint8_t target, std::vector<State> &pending);
+        bool searchValues(const std::vector<Condition> &conditions, const std::vector<uint8_t> &order,
+                          const std::vector<std::vector<size_t>> &decidedAt, size_t index, unsigned long &steps,
+                          MemoryImage &example);
+        [[nodiscard]] static Expression add(const Expression &left, const Expression &right);
+        [[nodiscard]] static Expression negate(const Expression &expression);
+    };
+}
+
+#endif //INC_8_BIT_COMPUTER_EMULATOR_SYMBOLICINTERPRETER_H
@@ -0,0 +1,57 @@
+#ifndef INC_8_BIT_COMPUTER_EMULATOR_TRIPLEBUFFER_H
+#define INC_8_BIT_COMPUTER_EMULATOR_TRIPLEBUFFER_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace Core {
+
+    /**
+     * Hands complete values from one writer thread to one reader thread, without locks, and without either
+     * of them ever waiting for the other.
+     *
+     * There are three copies of the value. The writer fills in the back one, and publishes it by swapping it
+     * with the middle one. The reader swaps the middle one with the front one when there is something new,
+     * and reads from the front. The swaps are a single atomic exchange of the index of the middle copy, so
+     * the reader always sees a whole value from one publish, never a mix of two. Values the reader doesn't
+     * get to in time are skipped.
+     */
+    template<typename T>
+    class TripleBuffer {
+
+    public:
+        TripleBuffer() : buffers(), back(0), front(1), middle(2) {}
+
+        /** The back copy for the writer to fill in, with whatever it had some publishes ago. */
+        T &write() {
+            return buffers[back];
+        }
+
+        /** Let the reader have the back copy. Only for the writer thread. */
+        void publish() {
+            back = middle.exchange(back | FRESH, std::memory_order_acq_rel) & INDEX;
+        }
+
+        /** The latest published value. Only for the reader thread, and valid until the next read(). */
+        const T &read() {
+            if (middle.load(std::memory_order_relaxed) & FRESH) {
+                front = middle.exchange(front, std::memory_order_acq_rel) & INDEX;
+            }
+
+            return buffers[front];
+        }
+
+    private:
+        static const uint8_t INDEX = 0x03;
+        static const uint8_t FRESH = 0x04;
+
+        std::array<T, 3> buffers;
+        uint8_t back;
+        uint8_t front;
+        /** The index of the middle copy, and whether it was published since the reader last took it. */
+        std::atomic<uint8_t> middle;
+    };
+}
+
+#endif //INC_8_BIT_COMPUTER_EMULATOR_TRIPLEBUFFER_H
@@ -1,20 +1,8 @@
+#include <array>
 #include <cmath>
 
 #include "Utils.h"
 
-/*
- * These debug methods are available to avoid warnings about value always being true/false in ifs when using the
- * constant, and unreachable code inside.
- */
-
-bool Core::Utils::debugL1() {
-    return DEBUG >= 1;
-}
-
-bool Core::Utils::debugL2() {
-    return DEBUG >= 2;
-}
-
 std::bitset<4> Core::Utils::to4bits(const uint8_t value) {
     return std::bitset<4>(value);
 }
@@ -27,6 +15,41 @@ bool Core::Utils::startsWith(const std::string &stringToCheck, const std::string
     return stringToCheck.compare(0, valueToLookFor.length(), valueToLookFor) == 0;
 }
 
+bool Core::Utils::endsWith(const std::string &stringToCheck, const std::string &valueToLookFor) {
+    if (valueToLookFor.empty() || valueToLookFor.length() > stringToCheck.length()) {
+        return false;
+    }
+
+    return stringToCheck.compare(stringToCheck.length() - valueToLookFor.length(), valueToLookFor.length(),
+                                 valueToLookFor) == 0;
+}
+
+uint32_t Core::Utils::crc32(const uint8_t *data, const size_t size) {
+    static const std::array<uint32_t, 256> table = [] {
+        std::array<uint32_t, 256> values{};
+
+        for (uint32_t i = 0; i < values.size(); i++) {
+            uint32_t value = i;
+
+            for (int bit = 0; bit < 8; bit++) {
+                value = value & 1 ? 0xEDB88320 ^ (value >> 1) : value >> 1;
+            }
+
+            values[i] = value;
+        }
+
+        return values;
+    }();
+
+    uint32_t crc = 0xFFFFFFFF;
+
+    for (size_t i = 0; i < size; i++) {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+
+    return crc ^ 0xFFFFFFFF;
+}
+
 bool Core::Utils::isLessThan(double x, double y) {
     if (x >= y) {
         return false;
@@ -2,6 +2,8 @@
 #define INC_8_BIT_COMPUTER_UTILS_H
 
 #include <bitset>
+#include <cstdint>
+#include <string>
 
 // Pattern for printf to display 3 bits in binary
 #define BIT_3_PATTERN "%c%c%c"
@@ -39,16 +41,33 @@ namespace Core {
 
     public:
         /** Enable debug logs? 0 = none, 1 = important, 2 = all */
-        static const int DEBUG = 0;
+        static constexpr int DEBUG = 0;
+
+#ifdef EIGHT_BIT_HEADLESS
+        /** Whether the components notify their observers. Off in the headless build, where nothing is shown. */
+        static constexpr bool OBSERVED = false;
+#else
+        /** Whether the components notify their observers. Off in the headless build, where nothing is shown. */
+        static constexpr bool OBSERVED = true;
+#endif
 
         /** 15, or 1111 in binary, is the max value that 4 bits can represent. */
         static const int FOUR_BITS_MAX = 15;
 
+        /*
+         * These debug methods are available to avoid warnings about value always being true/false in ifs when using
+         * the constant, and unreachable code inside. They are constexpr, so disabled logs compile to nothing.
+         */
+
         /** Display the most important debug logs. */
-        static bool debugL1();
+        static constexpr bool debugL1() {
+            return DEBUG >= 1;
+        }
 
         /** Display all debug logs. */
-        static bool debugL2();
+        static constexpr bool debugL2() {
+            return DEBUG >= 2;
+        }
 
         /** Returns the value as a 4-bit bitset. */
         static std::bitset<4> to4bits(uint8_t value);
@@ -56,6 +75,12 @@ namespace Core {
         /** Checks if the first string starts with the value of the second string. Comes in C++20 */
         static bool startsWith(const std::string &stringToCheck, const std::string &valueToLookFor);
 
+        /** Checks if the first string ends with the value of the second string. Comes in C++20 */
+        static bool endsWith(const std::string &stringToCheck, const std::string &valueToLookFor);
+
+        /** Standard CRC-32 (as in zip and png) of the bytes, for detecting corrupt files. */
+        static uint32_t crc32(const uint8_t *data, size_t size);
+
         /** Checks if x is less than y, handling floating point rounding errors. */
         static bool isLessThan(double x, double y);
 
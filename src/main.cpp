@@ -1,26 +1,55 @@
 #include <iostream>
 #include <memory>
 
+#include "core/Log.h"
 #include "ui/UserInterface.h"
 
 int main(int argc, char **argv) {
     std::cout << "Starting the 8-bit-computer emulator" << std::endl;
 
-    if (argc != 2) {
-        std::cerr << "Usage: 8bit <program.asm>" << std::endl;
-        return EXIT_FAILURE;
+    std::string fileName;
+    Core::Emulator::HotReload hotReload = Core::Emulator::HotReload::INSTRUCTION;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string argument = argv[i];
+
+        if (argument == "--hot-reload" && i + 1 < argc) {
+            const std::string value = argv[++i];
+
+            if (value == "off") {
+                hotReload = Core::Emulator::HotReload::OFF;
+            } else if (value == "instruction") {
+                hotReload = Core::Emulator::HotReload::INSTRUCTION;
+            } else if (value == "reset") {
+                hotReload = Core::Emulator::HotReload::RESET;
+            } else {
+                fileName.clear();
+                break;
+            }
+        } else if (argument == "--quiet") {
+            Core::Log::setQuiet(true);
+        } else if (fileName.empty() && argument.rfind("--", 0) != 0) {
+            fileName = argument;
+        } else {
+            fileName.clear();
+            break;
+        }
     }
 
-    std::string fileName = argv[1];
+    if (fileName.empty()) {
+        std::cerr << "Usage: 8bit [--hot-reload off|instruction|reset] [--quiet] <program.asm>" << std::endl;
+        return EXIT_FAILURE;
+    }
 
     try {
-        const auto ui = std::make_unique<UI::UserInterface>(fileName);
+        const auto ui = std::make_unique<UI::UserInterface>(fileName, hotReload);
         ui->start();
     } catch (const std::runtime_error &e) {
         std::cerr << e.what() << std::endl;
         return EXIT_FAILURE;
     }
 
+    Core::Log::flush();
     std::cout << "Finished" << std::endl;
 
     return EXIT_SUCCESS;
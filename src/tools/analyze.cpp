@@ -0,0 +1,38 @@
+#include <iostream>
+
+#include "../core/Assembler.h"
+#include "../core/CycleAnalyzer.h"
+#include "../core/MachineImage.h"
+
+/*
+ * Finds how many clock cycles a program takes without running it, and prints the program with the cycles
+ * of every instruction and basic block, where each block can go next, and the best and worst case to HLT.
+ */
+
+int main(int argc, char **argv) {
+    if (argc != 2) {
+        std::cerr << "Usage: 8bit-analyze <program.asm|program.8bim>" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const std::string fileName = argv[1];
+
+    try {
+        Core::MemoryImage image;
+
+        if (Core::MachineImage::isImageFile(fileName)) {
+            image = Core::MachineImage::load(fileName).memory;
+        } else {
+            Core::Assembler assembler;
+            image = Core::Assembler::toImage(assembler.loadInstructions(fileName));
+        }
+
+        const Core::CycleAnalyzer::Analysis analysis = Core::CycleAnalyzer::analyze(image);
+        std::cout << Core::CycleAnalyzer::toListing(image, analysis);
+    } catch (const std::runtime_error &e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
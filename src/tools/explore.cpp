@@ -0,0 +1,103 @@
+#include <iostream>
+#include <memory>
+#include <thread>
+
+#include "../core/Assembler.h"
+#include "../core/StateExplorer.h"
+#include "../core/Utils.h"
+
+/*
+ * Finds every state a program can reach, over all the values in 0 to 2 memory locations, and reports
+ * how many of them halt, which values can be output, and which parts of the program are never used.
+ */
+
+static const size_t DEFAULT_MAX_STATES = 1 << 22;
+
+static void printUsage() {
+    std::cerr << "Usage: 8bit-explore <program.asm> [address...] [--states <max states>] [--threads <threads>]"
+              << std::endl;
+}
+
+/** Prints the values with ranges of consecutive values shortened, like 0-3 5 8-10. */
+static void printValues(const std::string &title, const std::vector<uint8_t> &values) {
+    std::cout << title << ":";
+
+    for (size_t first = 0; first < values.size();) {
+        size_t last = first;
+
+        while (last + 1 < values.size() && values[last + 1] == values[last] + 1) {
+            last++;
+        }
+
+        std::cout << " " << (int) values[first];
+
+        if (last > first) {
+            std::cout << "-" << (int) values[last];
+        }
+
+        first = last + 1;
+    }
+
+    std::cout << std::endl;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    std::string fileName = argv[1];
+    std::vector<uint8_t> addresses;
+    size_t maxStates = DEFAULT_MAX_STATES;
+    unsigned int threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    try {
+        for (int i = 2; i < argc; i++) {
+            std::string argument = argv[i];
+
+            if (argument == "--states" && i + 1 < argc) {
+                maxStates = std::stoul(argv[++i]);
+            } else if (argument == "--threads" && i + 1 < argc) {
+                threads = std::stoul(argv[++i]);
+            } else {
+                const int address = std::stoi(argument);
+
+                if (address < 0 || address > Core::Utils::FOUR_BITS_MAX) {
+                    throw std::out_of_range("Address out of range: " + argument);
+                }
+
+                addresses.push_back(address);
+            }
+        }
+    } catch (const std::logic_error &e) {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    try {
+        const auto assembler = std::make_unique<Core::Assembler>();
+        const auto explorer = std::make_unique<Core::StateExplorer>(assembler->loadInstructions(fileName), addresses);
+
+        std::cout << "Exploring " << ((size_t) 1 << (8 * addresses.size())) << " starting states using " << threads
+                  << " threads" << std::endl;
+
+        const Core::StateExplorer::Report report = explorer->explore(maxStates, threads);
+
+        if (!report.complete) {
+            std::cout << "Stopped after " << report.states << " states. Use --states to allow more" << std::endl;
+        }
+
+        std::cout << "Reachable states: " << report.states << std::endl;
+        std::cout << "Halting states: " << report.haltingStates << std::endl;
+        std::cout << "Failing states: " << report.failingStates << std::endl;
+        std::cout << "Longest run: " << report.longestRun << " instructions" << std::endl;
+        printValues("Dead code", report.deadCode);
+        printValues("Outputs", report.outputs);
+    } catch (const std::runtime_error &e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
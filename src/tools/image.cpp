@@ -0,0 +1,82 @@
+#include <iostream>
+
+#include "../core/Assembler.h"
+#include "../core/Interpreter.h"
+#include "../core/MachineImage.h"
+
+/*
+ * Assembles a program into a machine image file, which the emulator can load without assembling.
+ * Optionally optimized, with a report of what changed and how many cycles it saves.
+ */
+
+static const unsigned long MAX_CYCLES = 1000000;
+
+/** Runs the program on the interpreter until it halts. Returns 0 if it doesn't halt within MAX_CYCLES. */
+static unsigned long countCycles(const Core::MemoryImage &image) {
+    Core::Interpreter::State state = Core::Interpreter::initialState(image);
+    unsigned long cycles = 0;
+
+    while (!state.halted && !state.failed && cycles <= MAX_CYCLES) {
+        cycles += Core::Interpreter::step(state);
+    }
+
+    return state.halted ? cycles : 0;
+}
+
+static void printReport(const std::vector<Core::PeepholeOptimizer::Rewrite> &rewrites,
+                        const Core::MemoryImage &optimized) {
+    if (rewrites.empty()) {
+        std::cout << "Nothing to optimize" << std::endl;
+        return;
+    }
+
+    Core::MemoryImage original = optimized;
+
+    for (const auto &rewrite : rewrites) {
+        std::cout << "Optimized " << Core::PeepholeOptimizer::describe(rewrite) << std::endl;
+        original[rewrite.address] = rewrite.before;
+    }
+
+    const unsigned long before = countCycles(original);
+    const unsigned long after = countCycles(optimized);
+
+    if (before > 0 && after > 0) {
+        std::cout << "Cycles until halt: " << before << " -> " << after << ", saved " << before - after << std::endl;
+    } else {
+        std::cout << "Cycles until halt: does not halt within " << MAX_CYCLES << " cycles" << std::endl;
+    }
+}
+
+int main(int argc, char **argv) {
+    const bool optimize = argc == 4 && std::string(argv[1]) == "--optimize";
+
+    if (argc != 3 && !optimize) {
+        std::cerr << "Usage: 8bit-image [--optimize] <program.asm> <program.8bim>" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const std::string sourceFileName = argv[argc - 2];
+    const std::string imageFileName = argv[argc - 1];
+
+    if (!Core::MachineImage::isImageFile(imageFileName)) {
+        std::cerr << "The image file must be of type .8bim: " << imageFileName << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    try {
+        Core::Assembler assembler;
+        assembler.setOptimize(optimize);
+        assembler.assembleToImage(sourceFileName, imageFileName);
+
+        if (optimize) {
+            printReport(assembler.getRewrites(), Core::MachineImage::load(imageFileName).memory);
+        }
+    } catch (const std::runtime_error &e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Wrote " << imageFileName << std::endl;
+
+    return EXIT_SUCCESS;
+}
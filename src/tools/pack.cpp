@@ -0,0 +1,134 @@
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+
+#include "../core/Assembler.h"
+#include "../core/Disassembler.h"
+#include "../core/PackFile.h"
+
+/*
+ * Builds a pack file from .asm files and directories of .asm files, or lists the programs in a pack file.
+ */
+
+/** Discards everything written to it. */
+class NullBuffer: public std::streambuf {
+
+protected:
+    int overflow(const int c) override {
+        return c;
+    }
+
+    std::streamsize xsputn(const char *, const std::streamsize n) override {
+        return n;
+    }
+};
+
+static void printUsage() {
+    std::cerr << "Usage: 8bit-pack <pack.8bpk> <program.asm | directory>...\n"
+                 "       8bit-pack --list <pack.8bpk>" << std::endl;
+}
+
+/** The .asm files, with the files in directories sorted by name to always give the same pack. */
+static std::vector<std::string> findSources(const std::vector<std::string> &paths) {
+    std::vector<std::string> sources;
+
+    for (const auto &path : paths) {
+        if (!std::filesystem::is_directory(path)) {
+            sources.push_back(path);
+            continue;
+        }
+
+        std::vector<std::string> directorySources;
+
+        for (const auto &entry : std::filesystem::recursive_directory_iterator(path)) {
+            if (entry.is_regular_file() && entry.path().extension() == ".asm") {
+                directorySources.push_back(entry.path().string());
+            }
+        }
+
+        std::sort(directorySources.begin(), directorySources.end());
+        sources.insert(sources.end(), directorySources.begin(), directorySources.end());
+    }
+
+    return sources;
+}
+
+static int list(const std::string &packFileName) {
+    const Core::PackFile pack(packFileName);
+    pack.verifyChecksum();
+
+    for (size_t i = 0; i < pack.size(); i++) {
+        const Core::MemoryImage &image = pack.image(i);
+        std::cout << pack.name(i) << ":";
+
+        for (size_t address = 0; address < image.size(); address++) {
+            std::cout << (address == 0 ? " " : ", ") << Core::Disassembler::disassemble(image[address]);
+        }
+
+        std::cout << std::endl;
+    }
+
+    std::cout << pack.size() << " programs" << std::endl;
+
+    return EXIT_SUCCESS;
+}
+
+static int build(const std::string &packFileName, const std::vector<std::string> &paths) {
+    std::vector<Core::PackFile::Entry> entries;
+    unsigned long failures = 0;
+    Core::Assembler assembler;
+    // Before redirecting standard out, since this can throw
+    const std::vector<std::string> sources = findSources(paths);
+
+    // The assembler logs every line to standard out
+    NullBuffer nullBuffer;
+    std::streambuf *standardOut = std::cout.rdbuf(&nullBuffer);
+
+    for (const auto &source : sources) {
+        try {
+            entries.push_back({source, Core::Assembler::toImage(assembler.loadInstructions(source))});
+        } catch (const std::runtime_error &e) {
+            std::cerr << source << ": " << e.what() << std::endl;
+            failures++;
+        }
+    }
+
+    std::cout.rdbuf(standardOut);
+
+    Core::PackFile::write(packFileName, entries);
+
+    std::cout << "Wrote " << entries.size() << " programs to " << packFileName;
+
+    if (failures > 0) {
+        std::cout << ", skipped " << failures << " that failed to assemble";
+    }
+
+    std::cout << std::endl;
+
+    return EXIT_SUCCESS;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    const std::string first = argv[1];
+
+    try {
+        if (first == "--list") {
+            if (argc != 3) {
+                printUsage();
+                return EXIT_FAILURE;
+            }
+
+            return list(argv[2]);
+        }
+
+        return build(first, std::vector<std::string>(argv + 2, argv + argc));
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,178 @@
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <thread>
+
+#include "../core/Assembler.h"
+#include "../core/Emulator.h"
+#include "../core/Instructions.h"
+#include "../core/Interpreter.h"
+#include "../core/Log.h"
+#include "../core/OutputCollector.h"
+#include "../core/Superoptimizer.h"
+
+/*
+ * Searches for the smallest or fastest program that outputs the same values as a reference program,
+ * or a list of values, and then halts. The result is verified on the emulator before it's printed.
+ */
+
+static const unsigned long DEFAULT_MAX_CYCLES = 100;
+static const int DEFAULT_MAX_SIZE = 5;
+
+static void printUsage() {
+    std::cerr << "Usage: 8bit-superopt (--output <value,value,...> | --reference <program.asm>) "
+                 "[--goal size|cycles] [--max-size <bytes>] [--cycles <max cycles>] [--threads <threads>]"
+              << std::endl;
+}
+
+static std::vector<uint8_t> parseValues(const std::string &argument) {
+    std::vector<uint8_t> values;
+    std::stringstream stream(argument);
+    std::string value;
+
+    while (std::getline(stream, value, ',')) {
+        const int number = std::stoi(value);
+
+        if (number < 0 || number > 255) {
+            throw std::out_of_range("Value out of range: " + value);
+        }
+
+        values.push_back(number);
+    }
+
+    return values;
+}
+
+/** Runs the reference program on the interpreter, to find the values it outputs. */
+static std::vector<uint8_t> runReference(const std::string &fileName, const unsigned long maxCycles) {
+    const auto assembler = std::make_unique<Core::Assembler>();
+    const std::vector<Core::Assembler::Instruction> instructions = assembler->loadInstructions(fileName);
+
+    Core::Interpreter::State state = Core::Interpreter::initialState(Core::Assembler::toImage(instructions));
+    std::vector<uint8_t> outputs;
+    unsigned long cycles = 0;
+    uint8_t size = 0;
+
+    for (const auto &instruction : instructions) {
+        size = std::max<uint8_t>(size, instruction.address.to_ulong() + 1);
+    }
+
+    while (!state.halted && !state.failed && cycles <= maxCycles) {
+        const bool output = state.memory[state.programCounter] >> 4 == Core::Instructions::OUT.opcode;
+        cycles += Core::Interpreter::step(state);
+
+        if (output) {
+            outputs.push_back(state.outputRegister);
+        }
+    }
+
+    if (!state.halted) {
+        throw std::runtime_error("Reference program did not halt within " + std::to_string(maxCycles) + " cycles");
+    }
+
+    std::cout << "Reference: " << (int) size << " bytes, " << cycles << " cycles" << std::endl;
+
+    return outputs;
+}
+
+/** Runs the solution on the emulator, to make sure it really does the same as on the interpreter. */
+static bool verify(const Core::Superoptimizer::Solution &solution, const std::vector<uint8_t> &target) {
+    Core::Log::setQuiet(true);
+
+    Core::Emulator emulator;
+    auto collector = std::make_shared<Core::OutputCollector>();
+    emulator.setOutputRegisterObserver(collector);
+    emulator.setNotifyEveryWrite(true); // The same value can be output more than once
+    emulator.load(solution.memory);
+    collector->values.clear(); // Skip the value from the reset
+
+    const unsigned long cycles = emulator.runSynchronous(solution.cycles + 1);
+
+    Core::Log::setQuiet(false);
+
+    return emulator.isHalted() && cycles == solution.cycles && collector->values == target;
+}
+
+int main(int argc, char **argv) {
+    std::vector<uint8_t> target;
+    std::string referenceFileName;
+    bool hasTarget = false;
+    Core::Superoptimizer::Goal goal = Core::Superoptimizer::Goal::SIZE;
+    int maxSize = DEFAULT_MAX_SIZE;
+    unsigned long maxCycles = DEFAULT_MAX_CYCLES;
+    unsigned int threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    try {
+        for (int i = 1; i < argc; i++) {
+            std::string argument = argv[i];
+
+            if (argument == "--output" && i + 1 < argc) {
+                target = parseValues(argv[++i]);
+                hasTarget = true;
+            } else if (argument == "--reference" && i + 1 < argc) {
+                referenceFileName = argv[++i];
+                hasTarget = true;
+            } else if (argument == "--goal" && i + 1 < argc) {
+                const std::string value = argv[++i];
+
+                if (value == "size") {
+                    goal = Core::Superoptimizer::Goal::SIZE;
+                } else if (value == "cycles") {
+                    goal = Core::Superoptimizer::Goal::CYCLES;
+                } else {
+                    throw std::invalid_argument("Unknown goal: " + value);
+                }
+            } else if (argument == "--max-size" && i + 1 < argc) {
+                maxSize = std::stoi(argv[++i]);
+            } else if (argument == "--cycles" && i + 1 < argc) {
+                maxCycles = std::stoul(argv[++i]);
+            } else if (argument == "--threads" && i + 1 < argc) {
+                threads = std::stoul(argv[++i]);
+            } else {
+                throw std::invalid_argument("Unknown argument: " + argument);
+            }
+        }
+    } catch (const std::logic_error &e) {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    if (!hasTarget || maxSize < 1 || maxSize > 16) {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    try {
+        if (!referenceFileName.empty()) {
+            target = runReference(referenceFileName, maxCycles);
+        }
+
+        std::cout << "Searching for programs of up to " << maxSize << " bytes using " << threads << " threads"
+                  << std::endl;
+
+        Core::Superoptimizer superoptimizer(target, goal, maxCycles);
+        const Core::Superoptimizer::Solution solution = superoptimizer.search(maxSize, threads);
+        const Core::Superoptimizer::Statistics statistics = superoptimizer.getStatistics();
+
+        std::cout << "Candidates: " << statistics.candidates << ", duplicates: " << statistics.duplicates
+                  << ", steals: " << statistics.steals << std::endl;
+
+        if (!solution.found) {
+            std::cout << "No program found" << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        std::cout << "Found: " << (int) solution.size << " bytes, " << solution.cycles << " cycles" << std::endl;
+        std::cout << superoptimizer.toAssembly(solution);
+
+        if (!verify(solution, target)) {
+            std::cerr << "Verification on the emulator failed" << std::endl;
+            return EXIT_FAILURE;
+        }
+    } catch (const std::runtime_error &e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,108 @@
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+#include "../core/Assembler.h"
+#include "../core/Log.h"
+#include "../core/ResultCache.h"
+#include "../core/SweepRunner.h"
+#include "../core/Utils.h"
+
+/*
+ * Runs a program over all the combinations of values in 1 to 3 memory locations, and writes a table
+ * with the output of each run.
+ */
+
+static const unsigned long DEFAULT_MAX_CYCLES = 100000;
+
+static void printUsage() {
+    std::cerr << "Usage: 8bit-sweep <program.asm> <address> [address...] "
+                 "[--cycles <max cycles per run>] [--threads <threads>] [--output <file>] [--cache <file.8brc>]"
+              << std::endl;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    std::string fileName = argv[1];
+    std::string outputFileName;
+    std::string cacheFileName;
+    std::vector<uint8_t> addresses;
+    unsigned long maxCycles = DEFAULT_MAX_CYCLES;
+    unsigned int threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    try {
+        for (int i = 2; i < argc; i++) {
+            std::string argument = argv[i];
+
+            if (argument == "--cycles" && i + 1 < argc) {
+                maxCycles = std::stoul(argv[++i]);
+            } else if (argument == "--threads" && i + 1 < argc) {
+                threads = std::stoul(argv[++i]);
+            } else if (argument == "--output" && i + 1 < argc) {
+                outputFileName = argv[++i];
+            } else if (argument == "--cache" && i + 1 < argc) {
+                cacheFileName = argv[++i];
+            } else {
+                const int address = std::stoi(argument);
+
+                if (address < 0 || address > Core::Utils::FOUR_BITS_MAX) {
+                    throw std::out_of_range("Address out of range: " + argument);
+                }
+
+                addresses.push_back(address);
+            }
+        }
+    } catch (const std::logic_error &e) {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    try {
+        const auto assembler = std::make_unique<Core::Assembler>();
+        const auto runner = std::make_unique<Core::SweepRunner>(assembler->loadInstructions(fileName), addresses);
+
+        std::shared_ptr<Core::ResultCache> cache;
+
+        if (!cacheFileName.empty()) {
+            cache = std::make_shared<Core::ResultCache>(cacheFileName);
+            runner->setCache(cache);
+        }
+
+        std::cerr << "Sweeping " << runner->combinations() << " combinations using " << threads << " threads"
+                  << std::endl;
+
+        // The emulator logs to standard out while running, so keep it away from the table
+        Core::Log::setQuiet(true);
+        const std::vector<Core::SweepRunner::Result> results = runner->run(maxCycles, threads);
+        Core::Log::setQuiet(false);
+
+        if (cache != nullptr) {
+            const Core::ResultCache::Statistics statistics = cache->getStatistics();
+            std::cerr << "Cache: " << statistics.hits << " hits, " << statistics.misses << " misses ("
+                      << (int) (statistics.hitRate() * 100) << "% hit rate), " << cache->size() << " results"
+                      << std::endl;
+        }
+
+        if (outputFileName.empty()) {
+            runner->printTable(std::cout, results);
+        } else {
+            std::ofstream output(outputFileName);
+
+            if (!output.is_open()) {
+                throw std::runtime_error("Failed to open output file: " + outputFileName);
+            }
+
+            runner->printTable(output, results);
+        }
+    } catch (const std::runtime_error &e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,141 @@
+#include <iostream>
+#include <sstream>
+
+#include "../core/Assembler.h"
+#include "../core/MachineImage.h"
+#include "../core/SymbolicInterpreter.h"
+
+/*
+ * Runs a program with some memory locations as unknown inputs, and prints every path it can take,
+ * with the conditions on the inputs, the values it outputs, the clock cycles, and an example input.
+ */
+
+static const unsigned long DEFAULT_MAX_CYCLES = 100000;
+static const size_t DEFAULT_MAX_PATHS = 1000;
+
+static void printUsage() {
+    std::cerr << "Usage: 8bit-symbolic [--cycles <max cycles>] [--paths <max paths>] "
+                 "<program.asm|program.8bim> <address,address,...>" << std::endl;
+}
+
+static std::vector<uint8_t> parseAddresses(const std::string &argument) {
+    std::vector<uint8_t> addresses;
+    std::stringstream stream(argument);
+    std::string address;
+
+    while (std::getline(stream, address, ',')) {
+        const int number = std::stoi(address);
+
+        if (number < 0 || number > 15) {
+            throw std::out_of_range("Address out of range: " + address);
+        }
+
+        addresses.push_back(number);
+    }
+
+    return addresses;
+}
+
+static std::string describeEnd(const Core::SymbolicInterpreter::Path &path) {
+    switch (path.end) {
+        case Core::SymbolicInterpreter::End::HALTED:
+            return "halts after " + std::to_string(path.cycles) + " cycles";
+        case Core::SymbolicInterpreter::End::FAILED:
+            return "fails after " + std::to_string(path.cycles) + " cycles";
+        case Core::SymbolicInterpreter::End::CYCLE_LIMIT:
+            return "still running after " + std::to_string(path.cycles) + " cycles";
+        case Core::SymbolicInterpreter::End::SYMBOLIC_CODE:
+            return "executes an input as code after " + std::to_string(path.cycles) + " cycles";
+    }
+
+    return "";
+}
+
+static void printPath(const size_t number, const Core::SymbolicInterpreter::Path &path,
+                      const std::vector<uint8_t> &symbols) {
+    std::cout << "Path " << number << ": " << describeEnd(path) << std::endl;
+
+    for (const auto &condition : path.conditions) {
+        std::cout << "  when   " << Core::SymbolicInterpreter::toString(condition) << std::endl;
+    }
+
+    for (const auto &output : path.outputs) {
+        std::cout << "  output " << Core::SymbolicInterpreter::toString(output) << std::endl;
+    }
+
+    if (path.solved) {
+        std::cout << "  for example";
+
+        for (const uint8_t address : symbols) {
+            std::cout << " x" << (int) address << "=" << (int) path.example[address];
+        }
+
+        std::cout << std::endl;
+    } else {
+        std::cout << "  no example found, the path may be impossible" << std::endl;
+    }
+}
+
+int main(int argc, char **argv) {
+    unsigned long maxCycles = DEFAULT_MAX_CYCLES;
+    size_t maxPaths = DEFAULT_MAX_PATHS;
+    std::vector<std::string> arguments;
+
+    try {
+        for (int i = 1; i < argc; i++) {
+            const std::string argument = argv[i];
+
+            if (argument == "--cycles" && i + 1 < argc) {
+                maxCycles = std::stoul(argv[++i]);
+            } else if (argument == "--paths" && i + 1 < argc) {
+                maxPaths = std::stoul(argv[++i]);
+            } else {
+                arguments.push_back(argument);
+            }
+        }
+
+        if (arguments.size() != 2) {
+            printUsage();
+            return EXIT_FAILURE;
+        }
+    } catch (const std::logic_error &e) {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    try {
+        const std::vector<uint8_t> symbols = parseAddresses(arguments[1]);
+        Core::MemoryImage image;
+
+        if (Core::MachineImage::isImageFile(arguments[0])) {
+            image = Core::MachineImage::load(arguments[0]).memory;
+        } else {
+            Core::Assembler assembler;
+            image = Core::Assembler::toImage(assembler.loadInstructions(arguments[0]));
+        }
+
+        Core::SymbolicInterpreter interpreter(image, symbols, maxCycles, maxPaths);
+        const Core::SymbolicInterpreter::Result result = interpreter.run();
+        const Core::SymbolicInterpreter::Statistics statistics = interpreter.getStatistics();
+
+        for (size_t i = 0; i < result.paths.size(); i++) {
+            printPath(i + 1, result.paths[i], symbols);
+        }
+
+        std::cout << result.paths.size() << " paths cover " << (1UL << (8 * std::min<size_t>(symbols.size(), 7)))
+                  << (symbols.size() > 7 ? " or more" : "") << " inputs, using " << statistics.instructions
+                  << " instructions and " << statistics.solverChecks << " solver checks" << std::endl;
+
+        if (!result.complete) {
+            std::cout << "Stopped after " << maxPaths << " paths, there are more" << std::endl;
+        }
+    } catch (const std::logic_error &e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    } catch (const std::runtime_error &e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -5,14 +5,12 @@
 
 #include "ArithmeticLogicUnitModel.h"
 
-UI::ArithmeticLogicUnitModel::ArithmeticLogicUnitModel() {
+UI::ArithmeticLogicUnitModel::ArithmeticLogicUnitModel(const std::shared_ptr<FramePublisher> &publisher) {
     if (Core::Utils::debugL2()) {
         std::cout << "ArithmeticLogicUnitModel construct" << std::endl;
     }
 
-    this->value = 0;
-    this->carry = false;
-    this->zero = true;
+    this->publisher = publisher;
 }
 
 UI::ArithmeticLogicUnitModel::~ArithmeticLogicUnitModel() {
@@ -22,13 +20,17 @@ UI::ArithmeticLogicUnitModel::~ArithmeticLogicUnitModel() {
 }
 
 void UI::ArithmeticLogicUnitModel::resultUpdated(const uint8_t newValue, const bool newCarryBit, const bool newZeroBit) {
-    value = newValue;
-    carry = newCarryBit;
-    zero = newZeroBit;
+    Frame &frame = publisher->working();
+    frame.arithmeticLogicUnit = newValue;
+    frame.arithmeticLogicUnitCarry = newCarryBit;
+    frame.arithmeticLogicUnitZero = newZeroBit;
 }
 
-std::string UI::ArithmeticLogicUnitModel::getRenderText() const {
+std::string UI::ArithmeticLogicUnitModel::getRenderText(const Frame &frame) const {
+    const uint8_t value = frame.arithmeticLogicUnit;
+
     return "Arithmetic Logic Unit: " +
            std::bitset<8>(value).to_string() + " / " + std::to_string(value) +
-           " C=" + std::to_string(carry) + " Z=" + std::to_string(zero);
+           " C=" + std::to_string(frame.arithmeticLogicUnitCarry) +
+           " Z=" + std::to_string(frame.arithmeticLogicUnitZero);
 }
@@ -1,8 +1,11 @@
 #ifndef INC_8_BIT_COMPUTER_EMULATOR_ARITHMETICLOGICUNITMODEL_H
 #define INC_8_BIT_COMPUTER_EMULATOR_ARITHMETICLOGICUNITMODEL_H
 
+#include <memory>
 #include <string>
 
+#include "FramePublisher.h"
+
 #include "../core/ArithmeticLogicUnitObserver.h"
 
 namespace UI {
@@ -13,15 +16,13 @@ namespace UI {
     class ArithmeticLogicUnitModel : public Core::ArithmeticLogicUnitObserver {
 
     public:
-        ArithmeticLogicUnitModel();
+        explicit ArithmeticLogicUnitModel(const std::shared_ptr<FramePublisher> &publisher);
         ~ArithmeticLogicUnitModel();
 
-        [[nodiscard]] std::string getRenderText() const;
+        [[nodiscard]] std::string getRenderText(const Frame &frame) const;
 
     private:
-        uint8_t value;
-        bool carry;
-        bool zero;
+        std::shared_ptr<FramePublisher> publisher;
 
         void resultUpdated(uint8_t newValue, bool newCarryBit, bool newZeroBit) override;
     };
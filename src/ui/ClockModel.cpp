@@ -6,12 +6,12 @@
 
 #include "ClockModel.h"
 
-UI::ClockModel::ClockModel() {
+UI::ClockModel::ClockModel(const std::shared_ptr<FramePublisher> &publisher) {
     if (Core::Utils::debugL2()) {
         std::cout << "ClockModel construct" << std::endl;
     }
 
-    this->on = false;
+    this->publisher = publisher;
     this->frequency = 0;
 }
 
@@ -22,16 +22,16 @@ UI::ClockModel::~ClockModel() {
 }
 
 void UI::ClockModel::clockTicked(const bool newOn) {
-    on = newOn;
+    publisher->working().clockOn = newOn;
 }
 
 void UI::ClockModel::frequencyChanged(const double newHz) {
     frequency = newHz;
 }
 
-std::string UI::ClockModel::getRenderText() const {
+std::string UI::ClockModel::getRenderText(const Frame &frame) const {
     std::stringstream hzStream;
     hzStream << std::fixed << std::setprecision(1) << frequency;
 
-    return "Clock: " + std::to_string(on) + " / " + hzStream.str() + " Hz";
+    return "Clock: " + std::to_string(frame.clockOn) + " / " + hzStream.str() + " Hz";
 }
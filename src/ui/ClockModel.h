@@ -1,26 +1,31 @@
 #ifndef INC_8_BIT_COMPUTER_EMULATOR_CLOCKMODEL_H
 #define INC_8_BIT_COMPUTER_EMULATOR_CLOCKMODEL_H
 
+#include <atomic>
+#include <memory>
 #include <string>
 
+#include "FramePublisher.h"
+
 #include "../core/ClockObserver.h"
 
 namespace UI {
 
     /**
      * Observes the core clock and prepares the state for presentation in the user interface.
+     * The frequency is not part of the frame, since it's changed from the keyboard while the clock runs.
      */
     class ClockModel : public Core::ClockObserver {
 
     public:
-        ClockModel();
+        explicit ClockModel(const std::shared_ptr<FramePublisher> &publisher);
         ~ClockModel();
 
-        [[nodiscard]] std::string getRenderText() const;
+        [[nodiscard]] std::string getRenderText(const Frame &frame) const;
 
     private:
-        bool on;
-        double frequency;
+        std::shared_ptr<FramePublisher> publisher;
+        std::atomic<double> frequency;
 
         void clockTicked(bool newOn) override;
         void frequencyChanged(double newHz) override;
@@ -4,13 +4,12 @@
 
 #include "FlagsRegisterModel.h"
 
-UI::FlagsRegisterModel::FlagsRegisterModel() {
+UI::FlagsRegisterModel::FlagsRegisterModel(const std::shared_ptr<FramePublisher> &publisher) {
     if (Core::Utils::debugL2()) {
         std::cout << "FlagsRegisterModel construct" << std::endl;
     }
 
-    this->carryFlag = false;
-    this->zeroFlag = false;
+    this->publisher = publisher;
 }
 
 UI::FlagsRegisterModel::~FlagsRegisterModel() {
@@ -20,10 +19,11 @@ UI::FlagsRegisterModel::~FlagsRegisterModel() {
 }
 
 void UI::FlagsRegisterModel::flagsUpdated(const bool newCarryFlag, const bool newZeroFlag) {
-    carryFlag = newCarryFlag;
-    zeroFlag = newZeroFlag;
+    Frame &frame = publisher->working();
+    frame.carryFlag = newCarryFlag;
+    frame.zeroFlag = newZeroFlag;
 }
 
-std::string UI::FlagsRegisterModel::getRenderText() const {
-    return "Flags: C=" + std::to_string(carryFlag) + " Z=" + std::to_string(zeroFlag);
+std::string UI::FlagsRegisterModel::getRenderText(const Frame &frame) const {
+    return "Flags: C=" + std::to_string(frame.carryFlag) + " Z=" + std::to_string(frame.zeroFlag);
 }
@@ -1,8 +1,11 @@
 #ifndef INC_8_BIT_COMPUTER_EMULATOR_FLAGSREGISTERMODEL_H
 #define INC_8_BIT_COMPUTER_EMULATOR_FLAGSREGISTERMODEL_H
 
+#include <memory>
 #include <string>
 
+#include "FramePublisher.h"
+
 #include "../core/FlagsRegisterObserver.h"
 
 namespace UI {
@@ -13,14 +16,13 @@ namespace UI {
     class FlagsRegisterModel : public Core::FlagsRegisterObserver {
 
     public:
-        FlagsRegisterModel();
+        explicit FlagsRegisterModel(const std::shared_ptr<FramePublisher> &publisher);
         ~FlagsRegisterModel();
 
-        [[nodiscard]] std::string getRenderText() const;
+        [[nodiscard]] std::string getRenderText(const Frame &frame) const;
 
     private:
-        bool carryFlag;
-        bool zeroFlag;
+        std::shared_ptr<FramePublisher> publisher;
 
         void flagsUpdated(bool newCarryFlag, bool newZeroFlag) override;
     };
@@ -0,0 +1,41 @@
+#ifndef INC_8_BIT_COMPUTER_EMULATOR_FRAME_H
+#define INC_8_BIT_COMPUTER_EMULATOR_FRAME_H
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+#include "../core/ControlWord.h"
+
+namespace UI {
+
+    /**
+     * Everything the user interface shows of the computer at one point in time.
+     * Only plain values, so a whole frame can be copied between threads in one go.
+     */
+    struct Frame {
+        static const int MEMORY_SIZE = 16;
+
+        bool clockOn = false;
+        uint8_t bus = 0;
+        uint8_t aRegister = 0;
+        uint8_t bRegister = 0;
+        uint8_t arithmeticLogicUnit = 0;
+        bool arithmeticLogicUnitCarry = false;
+        bool arithmeticLogicUnitZero = true;
+        uint8_t memoryAddressRegister = 0;
+        uint8_t programCounter = 0;
+        uint8_t randomAccessMemory = 0;
+        std::array<uint8_t, MEMORY_SIZE> memory{};
+        uint8_t instructionRegister = 0;
+        uint8_t outputRegister = 0;
+        uint8_t stepCounter = 0;
+        bool carryFlag = false;
+        bool zeroFlag = false;
+        Core::ControlWord controlWord;
+    };
+
+    static_assert(std::is_trivially_copyable<Frame>::value, "Frame must be a plain block of memory");
+}
+
+#endif //INC_8_BIT_COMPUTER_EMULATOR_FRAME_H
@@ -0,0 +1,40 @@
+#include <iostream>
+
+#include "../core/Utils.h"
+
+#include "FramePublisher.h"
+
+UI::FramePublisher::FramePublisher() {
+    if (Core::Utils::debugL2()) {
+        std::cout << "FramePublisher construct" << std::endl;
+    }
+
+    publish();
+}
+
+UI::FramePublisher::~FramePublisher() {
+    if (Core::Utils::debugL2()) {
+        std::cout << "FramePublisher destruct" << std::endl;
+    }
+}
+
+UI::Frame &UI::FramePublisher::working() {
+    return frame;
+}
+
+void UI::FramePublisher::publish() {
+    buffer.write() = frame;
+    buffer.publish();
+}
+
+const UI::Frame &UI::FramePublisher::latest() {
+    return buffer.read();
+}
+
+void UI::FramePublisher::clockTicked() {
+    publish();
+}
+
+void UI::FramePublisher::invertedClockTicked() {
+    publish();
+}
@@ -0,0 +1,42 @@
+#ifndef INC_8_BIT_COMPUTER_EMULATOR_FRAMEPUBLISHER_H
+#define INC_8_BIT_COMPUTER_EMULATOR_FRAMEPUBLISHER_H
+
+#include "Frame.h"
+
+#include "../core/ClockListener.h"
+#include "../core/TripleBuffer.h"
+
+namespace UI {
+
+    /**
+     * Passes frames from the emulator to the render thread, so each rendered frame is the state after
+     * a whole clock edge, and not halfway through one.
+     *
+     * The models fill in the working frame as the components change, which is published after all the
+     * components have seen the edge. Publishing never waits for the render thread.
+     */
+    class FramePublisher: public Core::ClockListener {
+
+    public:
+        FramePublisher();
+        ~FramePublisher();
+
+        /** The frame the models update. Only for the thread the emulator runs on. */
+        Frame &working();
+
+        /** Let the render thread have the working frame as it is now. */
+        void publish();
+
+        /** The latest published frame. Only for the render thread, and valid until the next call. */
+        const Frame &latest();
+
+        void clockTicked() override;
+        void invertedClockTicked() override;
+
+    private:
+        Frame frame;
+        Core::TripleBuffer<Frame> buffer;
+    };
+}
+
+#endif //INC_8_BIT_COMPUTER_EMULATOR_FRAMEPUBLISHER_H
@@ -4,10 +4,12 @@
 
 #include "InstructionDecoderModel.h"
 
-UI::InstructionDecoderModel::InstructionDecoderModel() {
+UI::InstructionDecoderModel::InstructionDecoderModel(const std::shared_ptr<FramePublisher> &publisher) {
     if (Core::Utils::debugL2()) {
         std::cout << "InstructionDecoderModel construct" << std::endl;
     }
+
+    this->publisher = publisher;
 }
 
 UI::InstructionDecoderModel::~InstructionDecoderModel() {
@@ -16,37 +18,21 @@ UI::InstructionDecoderModel::~InstructionDecoderModel() {
     }
 }
 
-void UI::InstructionDecoderModel::controlWordUpdated(const std::vector<Core::ControlLine> &newLines) {
-    for (auto [key, value] : lines) {
-        lines[key] = false;
-    }
-
-    for (Core::ControlLine line : newLines) {
-        lines[line] = true;
-    }
+void UI::InstructionDecoderModel::controlWordUpdated(const Core::ControlWord newWord) {
+    publisher->working().controlWord = newWord;
 }
 
 std::string UI::InstructionDecoderModel::getRenderTitleText() const {
     return "HLT MI RI RO II IO AI AO BI BO S- SO OI O- CE CO CJ FI";
 }
 
-std::string UI::InstructionDecoderModel::getRenderValueText() const {
-    return " " +  std::to_string(lines.at(Core::ControlLine::HLT)) +
-            "  " +  std::to_string(lines.at(Core::ControlLine::MI)) +
-            "  " +  std::to_string(lines.at(Core::ControlLine::RI)) +
-            "  " +  std::to_string(lines.at(Core::ControlLine::RO)) +
-            "  " +  std::to_string(lines.at(Core::ControlLine::II)) +
-            "  " +  std::to_string(lines.at(Core::ControlLine::IO)) +
-            "  " +  std::to_string(lines.at(Core::ControlLine::AI)) +
-            "  " +  std::to_string(lines.at(Core::ControlLine::AO)) +
-            "  " +  std::to_string(lines.at(Core::ControlLine::BI)) +
-            "  " +  std::to_string(lines.at(Core::ControlLine::BO)) +
-            "  " +  std::to_string(lines.at(Core::ControlLine::SM)) +
-            "  " +  std::to_string(lines.at(Core::ControlLine::SO)) +
-            "  " +  std::to_string(lines.at(Core::ControlLine::OI)) +
-            "  " +  std::to_string(lines.at(Core::ControlLine::OM)) +
-            "  " +  std::to_string(lines.at(Core::ControlLine::CE)) +
-            "  " +  std::to_string(lines.at(Core::ControlLine::CO)) +
-            "  " +  std::to_string(lines.at(Core::ControlLine::CJ)) +
-            "  " +  std::to_string(lines.at(Core::ControlLine::FI));
+std::string UI::InstructionDecoderModel::getRenderValueText(const Frame &frame) const {
+    std::string text;
+
+    // Each value under the middle of its name in the title
+    for (int line = 0; line < Core::ControlWord::LINES; line++) {
+        text += (line == 0 ? " " : "  ") + std::to_string(frame.controlWord.has(static_cast<Core::ControlLine>(line)));
+    }
+
+    return text;
 }
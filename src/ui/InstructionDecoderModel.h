@@ -1,9 +1,11 @@
 #ifndef INC_8_BIT_COMPUTER_EMULATOR_INSTRUCTIONDECODERMODEL_H
 #define INC_8_BIT_COMPUTER_EMULATOR_INSTRUCTIONDECODERMODEL_H
 
-#include <map>
+#include <memory>
 #include <string>
 
+#include "FramePublisher.h"
+
 #include "../core/InstructionDecoderObserver.h"
 
 namespace UI {
@@ -14,35 +16,16 @@ namespace UI {
     class InstructionDecoderModel : public Core::InstructionDecoderObserver {
 
     public:
-        InstructionDecoderModel();
+        explicit InstructionDecoderModel(const std::shared_ptr<FramePublisher> &publisher);
         ~InstructionDecoderModel();
 
         [[nodiscard]] std::string getRenderTitleText() const;
-        [[nodiscard]] std::string getRenderValueText() const;
+        [[nodiscard]] std::string getRenderValueText(const Frame &frame) const;
 
     private:
-        std::map<Core::ControlLine, bool> lines {
-                {Core::ControlLine::HLT, false},
-                {Core::ControlLine::MI, false},
-                {Core::ControlLine::RI, false},
-                {Core::ControlLine::RO, false},
-                {Core::ControlLine::II, false},
-                {Core::ControlLine::IO, false},
-                {Core::ControlLine::AI, false},
-                {Core::ControlLine::AO, false},
-                {Core::ControlLine::BI, false},
-                {Core::ControlLine::BO, false},
-                {Core::ControlLine::SM, false},
-                {Core::ControlLine::SO, false},
-                {Core::ControlLine::OI, false},
-                {Core::ControlLine::OM, false},
-                {Core::ControlLine::CE, false},
-                {Core::ControlLine::CO, false},
-                {Core::ControlLine::CJ, false},
-                {Core::ControlLine::FI, false},
-        };
-
-        void controlWordUpdated(const std::vector<Core::ControlLine> &newLines) override;
+        std::shared_ptr<FramePublisher> publisher;
+
+        void controlWordUpdated(Core::ControlWord newWord) override;
     };
 }
 
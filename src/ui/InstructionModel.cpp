@@ -5,14 +5,10 @@
 
 #include "InstructionModel.h"
 
-UI::InstructionModel::InstructionModel(const std::shared_ptr<ValueModel> &stepCounter,
-                                       const std::shared_ptr<ValueModel> &instructionRegister) {
+UI::InstructionModel::InstructionModel() {
     if (Core::Utils::debugL2()) {
         std::cout << "InstructionModel construct" << std::endl;
     }
-
-    this->stepCounter = stepCounter;
-    this->instructionRegister = instructionRegister;
 }
 
 UI::InstructionModel::~InstructionModel() {
@@ -21,10 +17,10 @@ UI::InstructionModel::~InstructionModel() {
     }
 }
 
-std::string UI::InstructionModel::getRenderText() const {
-    if (stepCounter->getValue() < 2) {
+std::string UI::InstructionModel::getRenderText(const Frame &frame) const {
+    if (frame.stepCounter < 2) {
         return "Instruction: FETCH";
     }
 
-    return "Instruction: " + Core::Disassembler::disassemble(instructionRegister->getValue());
+    return "Instruction: " + Core::Disassembler::disassemble(frame.instructionRegister);
 }
@@ -1,10 +1,9 @@
 #ifndef INC_8_BIT_COMPUTER_EMULATOR_INSTRUCTIONMODEL_H
 #define INC_8_BIT_COMPUTER_EMULATOR_INSTRUCTIONMODEL_H
 
-#include <memory>
 #include <string>
 
-#include "ValueModel.h"
+#include "Frame.h"
 
 namespace UI {
 
@@ -15,15 +14,10 @@ namespace UI {
     class InstructionModel {
 
     public:
-        InstructionModel(const std::shared_ptr<ValueModel> &stepCounter,
-                         const std::shared_ptr<ValueModel> &instructionRegister);
+        InstructionModel();
         ~InstructionModel();
 
-        [[nodiscard]] std::string getRenderText() const;
-
-    private:
-        std::shared_ptr<ValueModel> stepCounter;
-        std::shared_ptr<ValueModel> instructionRegister;
+        [[nodiscard]] std::string getRenderText(const Frame &frame) const;
     };
 }
 
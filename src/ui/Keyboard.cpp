@@ -4,12 +4,14 @@
 
 #include "Keyboard.h"
 
-UI::Keyboard::Keyboard(const std::shared_ptr<Core::Emulator> &emulator) {
+UI::Keyboard::Keyboard(const std::shared_ptr<Core::Emulator> &emulator,
+                       const std::shared_ptr<FramePublisher> &publisher) {
     if (Core::Utils::debugL2()) {
         std::cout << "Keyboard construct" << std::endl;
     }
 
     this->emulator = emulator;
+    this->publisher = publisher;
 }
 
 UI::Keyboard::~Keyboard() {
@@ -32,6 +34,15 @@ void UI::Keyboard::keyUp(const SDL_Keycode keycode) {
     else if (keycode == SDLK_r) {
         if (!emulator->isRunning()) {
             emulator->reload();
+            publisher->publish(); // The clock is not running to do it
+        }
+    }
+
+    // l: read the program file again, and reload like r
+    else if (keycode == SDLK_l) {
+        if (!emulator->isRunning()) {
+            emulator->reloadFile();
+            publisher->publish();
         }
     }
 
@@ -4,6 +4,8 @@
 #include <memory>
 #include <SDL.h>
 
+#include "FramePublisher.h"
+
 #include "../core/Emulator.h"
 
 namespace UI {
@@ -14,13 +16,14 @@ namespace UI {
     class Keyboard {
 
     public:
-        explicit Keyboard(const std::shared_ptr<Core::Emulator> &emulator);
+        Keyboard(const std::shared_ptr<Core::Emulator> &emulator, const std::shared_ptr<FramePublisher> &publisher);
         ~Keyboard();
 
         void keyUp(SDL_Keycode keycode);
 
     private:
         std::shared_ptr<Core::Emulator> emulator;
+        std::shared_ptr<FramePublisher> publisher;
     };
 }
 
@@ -5,13 +5,12 @@
 
 #include "RandomAccessMemoryModel.h"
 
-UI::RandomAccessMemoryModel::RandomAccessMemoryModel(const std::shared_ptr<ValueModel> &memoryAddressRegister) {
+UI::RandomAccessMemoryModel::RandomAccessMemoryModel(const std::shared_ptr<FramePublisher> &publisher) {
     if (Core::Utils::debugL2()) {
         std::cout << "RandomAccessMemoryModel construct" << std::endl;
     }
 
-    this->memoryAddressRegister = memoryAddressRegister;
-    this->value = 0;
+    this->publisher = publisher;
 }
 
 UI::RandomAccessMemoryModel::~RandomAccessMemoryModel() {
@@ -20,20 +19,28 @@ UI::RandomAccessMemoryModel::~RandomAccessMemoryModel() {
     }
 }
 
-void UI::RandomAccessMemoryModel::valueUpdated(const uint8_t newValue) {
-    value = newValue;
-    memory[memoryAddressRegister->getValue()] = newValue;
+void UI::RandomAccessMemoryModel::valueUpdated(const uint8_t address, const uint8_t newValue) {
+    Frame &frame = publisher->working();
+    frame.randomAccessMemory = newValue;
+    frame.memory[address] = newValue;
 }
 
-std::string UI::RandomAccessMemoryModel::getRenderText() const {
+void UI::RandomAccessMemoryModel::memoryUpdated(const Core::MemoryImage &newMemory) {
+    publisher->working().memory = newMemory;
+}
+
+std::string UI::RandomAccessMemoryModel::getRenderText(const Frame &frame) const {
+    const uint8_t value = frame.randomAccessMemory;
+
     return "Random Access Memory: " + std::bitset<8>(value).to_string() + " / " + std::to_string(value);
 }
 
-std::array<std::string, UI::RandomAccessMemoryModel::MEMORY_SIZE> UI::RandomAccessMemoryModel::getRenderTextFull() const {
+std::array<std::string, UI::RandomAccessMemoryModel::MEMORY_SIZE> UI::RandomAccessMemoryModel::getRenderTextFull(
+        const Frame &frame) const {
     std::array<std::string, MEMORY_SIZE> text{};
 
-    for (int i = 0; i < memory.size(); i++) {
-        const uint8_t currentValue = memory[i];
+    for (int i = 0; i < frame.memory.size(); i++) {
+        const uint8_t currentValue = frame.memory[i];
         text[i] = std::bitset<8>(currentValue).to_string() + " / " + std::to_string(currentValue);
     }
 
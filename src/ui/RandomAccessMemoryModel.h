@@ -5,7 +5,9 @@
 #include <memory>
 #include <string>
 
-#include "ValueModel.h"
+#include "FramePublisher.h"
+
+#include "../core/RandomAccessMemoryObserver.h"
 
 namespace UI {
 
@@ -14,23 +16,22 @@ namespace UI {
      * Supports presentation of the value in the current memory address as well as mapping out the full
      * memory content.
      */
-    class RandomAccessMemoryModel: public Core::ValueObserver {
+    class RandomAccessMemoryModel: public Core::RandomAccessMemoryObserver {
 
     public:
-        static const int MEMORY_SIZE = 16;
+        static const int MEMORY_SIZE = Frame::MEMORY_SIZE;
 
-        explicit RandomAccessMemoryModel(const std::shared_ptr<ValueModel> &memoryAddressRegister);
+        explicit RandomAccessMemoryModel(const std::shared_ptr<FramePublisher> &publisher);
         ~RandomAccessMemoryModel();
 
-        [[nodiscard]] std::string getRenderText() const;
-        [[nodiscard]] std::array<std::string, MEMORY_SIZE> getRenderTextFull() const;
+        [[nodiscard]] std::string getRenderText(const Frame &frame) const;
+        [[nodiscard]] std::array<std::string, MEMORY_SIZE> getRenderTextFull(const Frame &frame) const;
 
     private:
-        std::array<uint8_t, MEMORY_SIZE> memory{};
-        std::shared_ptr<ValueModel> memoryAddressRegister;
-        uint8_t value;
+        std::shared_ptr<FramePublisher> publisher;
 
-        void valueUpdated(uint8_t newValue) override;
+        void valueUpdated(uint8_t address, uint8_t newValue) override;
+        void memoryUpdated(const Core::MemoryImage &newMemory) override;
     };
 }
 
@@ -7,38 +7,45 @@
 
 #include "UserInterface.h"
 
-UI::UserInterface::UserInterface(const std::string &fileName) {
+UI::UserInterface::UserInterface(const std::string &fileName, const Core::Emulator::HotReload hotReload) {
     if (Core::Utils::debugL2()) {
         std::cout << "UserInterface construct" << std::endl;
     }
 
     this->fileName = fileName;
+    this->hotReload = hotReload;
     this->running = false;
 
     this->emulator = std::make_shared<Core::Emulator>();
-    this->keyboard = std::make_shared<Keyboard>(this->emulator);
+    this->publisher = std::make_shared<FramePublisher>();
+    this->keyboard = std::make_shared<Keyboard>(this->emulator, this->publisher);
     this->window = std::make_unique<Window>("8bit " + fileName, this->keyboard);
 
-    this->clock = std::make_shared<ClockModel>();
-    this->bus = std::make_shared<ValueModel>("Bus", 8);
-    this->aRegister = std::make_shared<ValueModel>("A Register", 8);
-    this->bRegister = std::make_shared<ValueModel>("B Register", 8);
-    this->arithmeticLogicUnit = std::make_shared<ArithmeticLogicUnitModel>();
-    this->memoryAddressRegister = std::make_shared<ValueModel>("Memory Address Register", 4);
-    this->programCounter = std::make_shared<ValueModel>("Program Counter", 4);
-    this->randomAccessMemory = std::make_shared<RandomAccessMemoryModel>(this->memoryAddressRegister);
-    this->instructionRegister = std::make_shared<ValueModel>("Instruction Register", 8);
-    this->outputRegister = std::make_shared<ValueModel>("Output Register", 8);
-    this->stepCounter = std::make_shared<ValueModel>("Step Counter", 3);
-    this->flagsRegister = std::make_shared<FlagsRegisterModel>();
-    this->instruction = std::make_unique<InstructionModel>(this->stepCounter, this->instructionRegister);
-    this->instructionDecoder = std::make_shared<InstructionDecoderModel>();
+    this->clock = std::make_shared<ClockModel>(this->publisher);
+    this->bus = std::make_shared<ValueModel>("Bus", 8, &Frame::bus, this->publisher);
+    this->aRegister = std::make_shared<ValueModel>("A Register", 8, &Frame::aRegister, this->publisher);
+    this->bRegister = std::make_shared<ValueModel>("B Register", 8, &Frame::bRegister, this->publisher);
+    this->arithmeticLogicUnit = std::make_shared<ArithmeticLogicUnitModel>(this->publisher);
+    this->memoryAddressRegister = std::make_shared<ValueModel>("Memory Address Register", 4,
+                                                               &Frame::memoryAddressRegister, this->publisher);
+    this->programCounter = std::make_shared<ValueModel>("Program Counter", 4, &Frame::programCounter,
+                                                        this->publisher);
+    this->randomAccessMemory = std::make_shared<RandomAccessMemoryModel>(this->publisher);
+    this->instructionRegister = std::make_shared<ValueModel>("Instruction Register", 8, &Frame::instructionRegister,
+                                                             this->publisher);
+    this->outputRegister = std::make_shared<ValueModel>("Output Register", 8, &Frame::outputRegister,
+                                                        this->publisher);
+    this->stepCounter = std::make_shared<ValueModel>("Step Counter", 3, &Frame::stepCounter, this->publisher);
+    this->flagsRegister = std::make_shared<FlagsRegisterModel>(this->publisher);
+    this->instruction = std::make_unique<InstructionModel>();
+    this->instructionDecoder = std::make_shared<InstructionDecoderModel>(this->publisher);
 
     this->emulator->setClockObserver(this->clock);
     this->emulator->setBusObserver(this->bus);
     this->emulator->setARegisterObserver(this->aRegister);
     this->emulator->setBRegisterObserver(this->bRegister);
     this->emulator->setArithmeticLogicUnitObserver(this->arithmeticLogicUnit);
+    this->emulator->setArithmeticLogicUnitEager(true);
     this->emulator->setMemoryAddressRegisterObserver(this->memoryAddressRegister);
     this->emulator->setProgramCounterObserver(this->programCounter);
     this->emulator->setRandomAccessMemoryObserver(this->randomAccessMemory);
@@ -47,6 +54,9 @@ UI::UserInterface::UserInterface(const std::string &fileName) {
     this->emulator->setStepCounterObserver(this->stepCounter);
     this->emulator->setFlagsRegisterObserver(this->flagsRegister);
     this->emulator->setInstructionDecoderObserver(this->instructionDecoder);
+
+    // After all the components, so each edge is published whole
+    this->emulator->addClockListener(this->publisher);
 }
 
 UI::UserInterface::~UserInterface() {
@@ -86,12 +96,17 @@ void UI::UserInterface::mainLoop() {
 
     emulator->load(fileName);
     emulator->setFrequency(2);
+    emulator->setHotReload(hotReload);
+    publisher->publish();
 
     while (running) {
+        // One frame for everything, so it all comes from the same point in time
+        const Frame &frame = publisher->latest();
+
         window->clearScreen();
 
-        drawLeftColumn();
-        drawRightColumn();
+        drawLeftColumn(frame);
+        drawRightColumn(frame);
 
         window->redraw();
 
@@ -101,26 +116,26 @@ void UI::UserInterface::mainLoop() {
     emulator->stop();
 }
 
-void UI::UserInterface::drawLeftColumn() {
+void UI::UserInterface::drawLeftColumn(const Frame &frame) {
     int currentLine = 0;
 
-    drawLeftText(clock->getRenderText(), currentLine++);
-    drawLeftText(programCounter->getRenderText(), currentLine++);
-    drawLeftText(bus->getRenderText(), currentLine++);
-    drawLeftText(aRegister->getRenderText(), currentLine++);
-    drawLeftText(bRegister->getRenderText(), currentLine++);
-    drawLeftText(arithmeticLogicUnit->getRenderText(), currentLine++);
-    drawLeftText(flagsRegister->getRenderText(), currentLine++);
-    drawLeftText(memoryAddressRegister->getRenderText(), currentLine++);
-    drawLeftText(randomAccessMemory->getRenderText(), currentLine++);
-    drawLeftText(stepCounter->getRenderText(), currentLine++);
-    drawLeftText(instructionRegister->getRenderText(), currentLine++);
-    drawLeftText(instruction->getRenderText(), currentLine++);
-    drawLeftText(outputRegister->getRenderText(), currentLine++);
+    drawLeftText(clock->getRenderText(frame), currentLine++);
+    drawLeftText(programCounter->getRenderText(frame), currentLine++);
+    drawLeftText(bus->getRenderText(frame), currentLine++);
+    drawLeftText(aRegister->getRenderText(frame), currentLine++);
+    drawLeftText(bRegister->getRenderText(frame), currentLine++);
+    drawLeftText(arithmeticLogicUnit->getRenderText(frame), currentLine++);
+    drawLeftText(flagsRegister->getRenderText(frame), currentLine++);
+    drawLeftText(memoryAddressRegister->getRenderText(frame), currentLine++);
+    drawLeftText(randomAccessMemory->getRenderText(frame), currentLine++);
+    drawLeftText(stepCounter->getRenderText(frame), currentLine++);
+    drawLeftText(instructionRegister->getRenderText(frame), currentLine++);
+    drawLeftText(instruction->getRenderText(frame), currentLine++);
+    drawLeftText(outputRegister->getRenderText(frame), currentLine++);
 
     currentLine++;
 
-    drawLeftText(instructionDecoder->getRenderValueText(), currentLine++);
+    drawLeftText(instructionDecoder->getRenderValueText(frame), currentLine++);
     drawLeftText(instructionDecoder->getRenderTitleText(), currentLine);
 }
 
@@ -128,13 +143,14 @@ void UI::UserInterface::drawLeftText(const std::string &text, const int currentL
     window->drawText(text, LEFT_POSITION, currentLine * LINE_HEIGHT);
 }
 
-void UI::UserInterface::drawRightColumn() {
-    const std::array<std::string, RandomAccessMemoryModel::MEMORY_SIZE> &ramValues = randomAccessMemory->getRenderTextFull();
+void UI::UserInterface::drawRightColumn(const Frame &frame) {
+    const std::array<std::string, RandomAccessMemoryModel::MEMORY_SIZE> &ramValues =
+            randomAccessMemory->getRenderTextFull(frame);
 
     for (int i = 0; i < ramValues.size(); i++) {
         const std::string &ramValue = ramValues[i];
 
-        if (memoryAddressRegister->getValue() == i) {
+        if (frame.memoryAddressRegister == i) {
             window->drawText("* " + ramValue, RIGHT_MARKER_POSITION, i * LINE_HEIGHT);
         } else {
             window->drawText(ramValue, RIGHT_POSITION, i * LINE_HEIGHT);
@@ -6,6 +6,7 @@
 #include "ArithmeticLogicUnitModel.h"
 #include "ClockModel.h"
 #include "FlagsRegisterModel.h"
+#include "FramePublisher.h"
 #include "InstructionDecoderModel.h"
 #include "InstructionModel.h"
 #include "RandomAccessMemoryModel.h"
@@ -22,7 +23,7 @@ namespace UI {
     class UserInterface {
 
     public:
-        explicit UserInterface(const std::string &fileName);
+        UserInterface(const std::string &fileName, Core::Emulator::HotReload hotReload);
         ~UserInterface();
 
         void start();
@@ -36,6 +37,7 @@ namespace UI {
         std::unique_ptr<Window> window;
         std::shared_ptr<Keyboard> keyboard;
         std::shared_ptr<Core::Emulator> emulator;
+        std::shared_ptr<FramePublisher> publisher;
 
         std::shared_ptr<ClockModel> clock;
         std::shared_ptr<ValueModel> bus;
@@ -53,12 +55,13 @@ namespace UI {
         std::shared_ptr<InstructionDecoderModel> instructionDecoder;
 
         std::string fileName;
+        Core::Emulator::HotReload hotReload;
         bool running;
 
         void mainLoop();
-        void drawLeftColumn();
+        void drawLeftColumn(const Frame &frame);
         void drawLeftText(const std::string &text, int currentLine);
-        void drawRightColumn();
+        void drawRightColumn(const Frame &frame);
     };
 }
 
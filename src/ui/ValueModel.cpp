@@ -5,10 +5,12 @@
 
 #include "ValueModel.h"
 
-UI::ValueModel::ValueModel(const std::string &name, const size_t bits) {
+UI::ValueModel::ValueModel(const std::string &name, const size_t bits, uint8_t Frame::*field,
+                           const std::shared_ptr<FramePublisher> &publisher) {
     this->name = name;
     this->bits = bits;
-    this->value = 0;
+    this->field = field;
+    this->publisher = publisher;
 
     if (Core::Utils::debugL2()) {
         std::cout << this->name << " Model construct" << std::endl;
@@ -22,18 +24,16 @@ UI::ValueModel::~ValueModel() {
 }
 
 void UI::ValueModel::valueUpdated(const uint8_t newValue) {
-    value = newValue;
+    publisher->working().*field = newValue;
 }
 
-std::string UI::ValueModel::getRenderText() const {
-    return name + ": " + valueAsBinary() + " / " + std::to_string(value);
-}
+std::string UI::ValueModel::getRenderText(const Frame &frame) const {
+    const uint8_t value = frame.*field;
 
-uint8_t UI::ValueModel::getValue() const {
-    return value;
+    return name + ": " + valueAsBinary(value) + " / " + std::to_string(value);
 }
 
-std::string UI::ValueModel::valueAsBinary() const {
+std::string UI::ValueModel::valueAsBinary(const uint8_t value) const {
     switch (bits) {
         case 3: return std::bitset<3>(value).to_string();
         case 4: return std::bitset<4>(value).to_string();
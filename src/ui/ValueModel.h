@@ -1,8 +1,11 @@
 #ifndef INC_8_BIT_COMPUTER_EMULATOR_VALUEMODEL_H
 #define INC_8_BIT_COMPUTER_EMULATOR_VALUEMODEL_H
 
+#include <memory>
 #include <string>
 
+#include "FramePublisher.h"
+
 #include "../core/ValueObserver.h"
 
 namespace UI {
@@ -14,18 +17,19 @@ namespace UI {
     class ValueModel: public Core::ValueObserver {
 
     public:
-        ValueModel(const std::string &name, size_t bits);
+        ValueModel(const std::string &name, size_t bits, uint8_t Frame::*field,
+                   const std::shared_ptr<FramePublisher> &publisher);
         ~ValueModel();
 
-        [[nodiscard]] std::string getRenderText() const;
-        [[nodiscard]] uint8_t getValue() const;
+        [[nodiscard]] std::string getRenderText(const Frame &frame) const;
 
     private:
         std::string name;
         size_t bits;
-        uint8_t value;
+        uint8_t Frame::*field;
+        std::shared_ptr<FramePublisher> publisher;
 
-        [[nodiscard]] std::string valueAsBinary() const;
+        [[nodiscard]] std::string valueAsBinary(uint8_t value) const;
 
         void valueUpdated(uint8_t newValue) override;
     };
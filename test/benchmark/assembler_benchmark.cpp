@@ -0,0 +1,78 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+
+#include "core/Assembler.h"
+
+/*
+ * Measures the throughput of the assembler on a large generated source.
+ *
+ * The source is made of many programs after each other, each starting with ORG 0, with all the instructions,
+ * data, and comments. Every program is valid, so all of it is assembled.
+ */
+
+using namespace Core;
+
+static const double DEFAULT_MEGABYTES = 64;
+
+static const char *LINES[] = {
+        "NOP", "LDA 14", "ADD 15", "SUB 13", "STA 12", "LDI 7", "JMP 3", "JC 4", "JZ 5", "OUT", "HLT",
+        "DB 255", "DB 0", "  OUT        ; Output the value of the A-register", "; Just a comment",
+};
+
+static std::string generateSource(const size_t size, const unsigned int seed) {
+    std::mt19937 random(seed);
+    std::uniform_int_distribution<size_t> line(0, std::size(LINES) - 1);
+    std::string source;
+    source.reserve(size + 1024);
+
+    while (source.size() < size) {
+        source += "ORG 0\n";
+
+        // The assembler stops at any line after address 15 has been used, so leave the last one free for ORG
+        for (int address = 0; address < 15;) {
+            const std::string_view next = LINES[line(random)];
+            source += next;
+            source += '\n';
+
+            if (next[0] != ';') {
+                address++;
+            }
+        }
+    }
+
+    return source;
+}
+
+int main(int argc, char **argv) {
+    double megabytes = DEFAULT_MEGABYTES;
+
+    if (argc == 3 && std::string(argv[1]) == "--megabytes") {
+        megabytes = std::stod(argv[2]);
+    } else if (argc != 1) {
+        std::cerr << "Usage: 8bit-assembler-benchmark [--megabytes <size of source>]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const std::string source = generateSource(megabytes * 1024 * 1024, 1);
+    const size_t lines = std::count(source.begin(), source.end(), '\n');
+
+    // The assembler logs every file it loads to standard out, but nothing else unless debugging
+    Assembler assembler;
+
+    const auto start = std::chrono::steady_clock::now();
+    const std::vector<Assembler::Instruction> instructions = assembler.interpretSource(source);
+    const auto end = std::chrono::steady_clock::now();
+
+    const double seconds = std::chrono::duration<double>(end - start).count();
+
+    std::cout << "Assembled " << source.size() / (1024.0 * 1024.0) << " MB, " << lines << " lines, "
+              << instructions.size() << " instructions in " << seconds << " seconds" << std::endl;
+    std::cout << source.size() / (1024.0 * 1024.0) / seconds << " MB/s, "
+              << (unsigned long) (lines / seconds) << " lines/sec" << std::endl;
+
+    return instructions.empty() ? EXIT_FAILURE : EXIT_SUCCESS;
+}
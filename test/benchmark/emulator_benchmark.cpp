@@ -0,0 +1,169 @@
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/Emulator.h"
+#include "core/FileOutputSink.h"
+#include "core/Log.h"
+#include "core/Utils.h"
+
+/*
+ * Measures how many clock cycles per second the emulator runs the programs at.
+ *
+ * Built twice, against the normal core and the headless core, to compare the cost of the observer hooks.
+ * Programs that halt are started again until they have run for the number of cycles. With --observers, every
+ * component gets an observer that does nothing, like a user interface that is not looking. With --outputs, every
+ * value the programs output is written to a file through an output sink.
+ */
+
+using namespace Core;
+
+static const unsigned long DEFAULT_CYCLES = 10000000;
+
+class NullValueObserver: public ValueObserver {
+
+public:
+    void valueUpdated(const uint8_t) override {}
+};
+
+class NullRandomAccessMemoryObserver: public RandomAccessMemoryObserver {
+
+public:
+    void valueUpdated(const uint8_t, const uint8_t) override {}
+    void memoryUpdated(const MemoryImage &) override {}
+};
+
+class NullArithmeticLogicUnitObserver: public ArithmeticLogicUnitObserver {
+
+public:
+    void resultUpdated(const uint8_t, const bool, const bool) override {}
+};
+
+class NullFlagsRegisterObserver: public FlagsRegisterObserver {
+
+public:
+    void flagsUpdated(const bool, const bool) override {}
+};
+
+class NullInstructionDecoderObserver: public InstructionDecoderObserver {
+
+public:
+    void controlWordUpdated(const ControlWord) override {}
+};
+
+static void setObservers(Emulator &emulator) {
+    const auto value = std::make_shared<NullValueObserver>();
+
+    emulator.setBusObserver(value);
+    emulator.setARegisterObserver(value);
+    emulator.setBRegisterObserver(value);
+    emulator.setArithmeticLogicUnitObserver(std::make_shared<NullArithmeticLogicUnitObserver>());
+    emulator.setMemoryAddressRegisterObserver(value);
+    emulator.setProgramCounterObserver(value);
+    emulator.setRandomAccessMemoryObserver(std::make_shared<NullRandomAccessMemoryObserver>());
+    emulator.setInstructionRegisterObserver(value);
+    emulator.setOutputRegisterObserver(value);
+    emulator.setStepCounterObserver(value);
+    emulator.setInstructionDecoderObserver(std::make_shared<NullInstructionDecoderObserver>());
+    emulator.setFlagsRegisterObserver(std::make_shared<NullFlagsRegisterObserver>());
+}
+
+/** Runs the program for the number of cycles, and returns the seconds it took. */
+static double run(const std::string &fileName, const unsigned long cycles, const bool observers,
+                  const std::shared_ptr<OutputSink> &sink) {
+    Emulator emulator;
+
+    if (observers) {
+        setObservers(emulator);
+    }
+
+    emulator.load(fileName);
+
+    if (sink != nullptr) {
+        emulator.setOutputSink(sink);
+    }
+
+    Core::Log::setQuiet(true);
+
+    // Restoring is the same as reloading, but without printing all the values every time
+    const Snapshot loaded = emulator.snapshot();
+
+    const auto start = std::chrono::steady_clock::now();
+    unsigned long remaining = cycles;
+
+    while (remaining > 0) {
+        remaining -= emulator.runSynchronous(remaining);
+
+        if (emulator.isHalted()) {
+            emulator.restore(loaded);
+        }
+    }
+
+    emulator.flushOutputs();
+
+    const auto end = std::chrono::steady_clock::now();
+    Core::Log::setQuiet(false);
+
+    return std::chrono::duration<double>(end - start).count();
+}
+
+int main(int argc, char **argv) {
+    unsigned long cycles = DEFAULT_CYCLES;
+    bool observers = false;
+    std::string outputsFileName;
+    std::vector<std::string> fileNames;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string argument = argv[i];
+
+        if (argument == "--cycles" && i + 1 < argc) {
+            cycles = std::stoul(argv[++i]);
+        } else if (argument == "--observers") {
+            observers = true;
+        } else if (argument == "--outputs" && i + 1 < argc) {
+            outputsFileName = argv[++i];
+        } else {
+            fileNames.push_back(argument);
+        }
+    }
+
+    if (fileNames.empty() || cycles == 0) {
+        std::cerr << "Usage: 8bit-emulator-benchmark [--cycles <cycles per program>] [--observers] [--outputs <file>] "
+                     "<program.asm|program.8bim>..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // The headless core doesn't take observers, so it's always measured without them
+    observers = observers && Utils::OBSERVED;
+
+    std::cout << (Utils::OBSERVED ? "Observed" : "Headless") << " core"
+              << (observers ? " with observers" : "") << ", " << cycles << " cycles per program"
+              << std::endl;
+
+    double totalSeconds = 0;
+
+    try {
+        std::shared_ptr<OutputSink> sink;
+
+        if (!outputsFileName.empty()) {
+            sink = std::make_shared<FileOutputSink>(outputsFileName);
+        }
+
+        for (const std::string &fileName : fileNames) {
+            const double seconds = run(fileName, cycles, observers, sink);
+            totalSeconds += seconds;
+
+            std::cout << fileName << ": " << (unsigned long) (cycles / seconds) << " cycles/sec" << std::endl;
+        }
+    } catch (const std::runtime_error &e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Total: " << (unsigned long) (cycles * fileNames.size() / totalSeconds) << " cycles/sec"
+              << std::endl;
+
+    return EXIT_SUCCESS;
+}
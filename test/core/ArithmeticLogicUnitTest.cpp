@@ -178,6 +178,87 @@ TEST_SUITE("ArithmeticLogicUnitTest") {
             fakeit::Verify(Method(observerMock, resultUpdated).Using(0, true, true)).Once();
         }
 
+        SUBCASE("registerValueChanged() should not add until the result is used") {
+            fakeit::Mock<ArithmeticLogicUnitObserver> observerMock;
+            auto observerPtr = std::shared_ptr<ArithmeticLogicUnitObserver>(&observerMock(), [](...) {});
+            alu.setObserver(observerPtr);
+            fakeit::When(Method(observerMock, resultUpdated)).AlwaysReturn();
+
+            fakeit::When(Method(aRegisterMock, readValue)).AlwaysReturn(3);
+            fakeit::When(Method(bRegisterMock, readValue)).AlwaysReturn(4);
+
+            theRegister.registerValueChanged(0);
+            theRegister.registerValueChanged(0);
+            theRegister.registerValueChanged(0);
+
+            fakeit::Verify(Method(observerMock, resultUpdated)).Never();
+
+            CHECK_FALSE(alu.isCarry());
+            CHECK_FALSE(alu.isZero());
+            alu.out();
+            CHECK_EQ(bus->read(), 7);
+
+            fakeit::Verify(Method(observerMock, resultUpdated).Using(7, false, false)).Once();
+        }
+
+        SUBCASE("getState() and print() should not notify observer of a result that isn't used yet") {
+            fakeit::Mock<ArithmeticLogicUnitObserver> observerMock;
+            auto observerPtr = std::shared_ptr<ArithmeticLogicUnitObserver>(&observerMock(), [](...) {});
+            alu.setObserver(observerPtr);
+            fakeit::When(Method(observerMock, resultUpdated)).AlwaysReturn();
+
+            fakeit::When(Method(aRegisterMock, readValue)).AlwaysReturn(3);
+            fakeit::When(Method(bRegisterMock, readValue)).AlwaysReturn(4);
+
+            theRegister.registerValueChanged(0);
+
+            const ArithmeticLogicUnit::State state = alu.getState();
+            CHECK_EQ(state.value, 7);
+            CHECK_FALSE(state.carry);
+            CHECK_FALSE(state.zero);
+
+            alu.print();
+
+            fakeit::Verify(Method(observerMock, resultUpdated)).Never();
+
+            alu.out();
+
+            fakeit::Verify(Method(observerMock, resultUpdated).Using(7, false, false)).Once();
+        }
+
+        SUBCASE("subtract() should not be overwritten by a pending addition") {
+            fakeit::When(Method(aRegisterMock, readValue)).AlwaysReturn(5);
+            fakeit::When(Method(bRegisterMock, readValue)).AlwaysReturn(2);
+
+            theRegister.registerValueChanged(0);
+            alu.subtract();
+
+            CHECK(alu.isCarry());
+            alu.out();
+            CHECK_EQ(bus->read(), 3);
+        }
+
+        SUBCASE("setEager() should add every time a register changes") {
+            fakeit::Mock<ArithmeticLogicUnitObserver> observerMock;
+            auto observerPtr = std::shared_ptr<ArithmeticLogicUnitObserver>(&observerMock(), [](...) {});
+            alu.setObserver(observerPtr);
+            std::vector<int> values;
+            fakeit::When(Method(observerMock, resultUpdated)).AlwaysDo([&](uint8_t newValue, bool, bool) {
+                values.push_back(newValue);
+            });
+
+            alu.setEager(true);
+
+            fakeit::When(Method(aRegisterMock, readValue)).AlwaysReturn(3);
+            fakeit::When(Method(bRegisterMock, readValue)).AlwaysReturn(4);
+            theRegister.registerValueChanged(0);
+
+            fakeit::When(Method(bRegisterMock, readValue)).AlwaysReturn(5);
+            theRegister.registerValueChanged(0);
+
+            CHECK_EQ(values, std::vector<int>{7, 8});
+        }
+
         SUBCASE("print() should not fail") {
             alu.print();
         }
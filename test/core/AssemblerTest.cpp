@@ -1,8 +1,10 @@
 #include <doctest.h>
+#include <cstdio>
 #include <iostream> // Due to bug with doctest on macOS in release mode: https://github.com/onqtam/doctest/issues/126
 
 #include "core/Assembler.h"
 #include "core/Instructions.h"
+#include "core/MachineImage.h"
 
 using namespace Core;
 
@@ -197,4 +199,175 @@ TEST_SUITE("AssemblerTest") {
         CHECK_THROWS_WITH(assembler.loadInstructions("../../programs/test/missing_operand_test.asm"),
                           "Assembler: interpret operand - wrong number of arguments to JMP");
     }
+
+    TEST_CASE("interpret() should start at address 0 every time") {
+        Assembler assembler;
+
+        CHECK_EQ(assembler.interpret({"LDI 1", "OUT"})[1].address.to_ulong(), 1);
+        CHECK_EQ(assembler.interpret({"LDI 1", "OUT"})[1].address.to_ulong(), 1);
+    }
+
+    TEST_CASE("interpret() should throw exception if origin is missing the address") {
+        Assembler assembler;
+
+        CHECK_THROWS_WITH(assembler.interpret({"ORG"}), "Assembler: wrong number of arguments to origin");
+    }
+
+    TEST_CASE("interpret() should throw exception if origin is out of bounds") {
+        Assembler assembler;
+
+        CHECK_THROWS_WITH(assembler.interpret({"ORG 300"}), "Assembler: address out of bounds 300");
+        CHECK_THROWS_WITH(assembler.interpret({"ORG -1"}), "Assembler: address out of bounds -1");
+    }
+
+    TEST_CASE("interpret() should skip empty lines after the last address, like assemble()") {
+        Assembler assembler;
+
+        CHECK(assembler.assemble("ORG 16\n\n").ok());
+        CHECK(assembler.interpret({"ORG 16", ""}).empty());
+        CHECK_THROWS_WITH(assembler.interpret({"ORG 16", "OUT"}), "Assembler: address out of bounds 16");
+    }
+
+    TEST_CASE("interpret() should throw exception if data is out of bounds") {
+        Assembler assembler;
+
+        CHECK_THROWS_WITH(assembler.interpret({"DB 256"}), "Assembler: data out of bounds 256");
+        CHECK_THROWS_WITH(assembler.interpret({"DB -1"}), "Assembler: data out of bounds -1");
+    }
+
+    TEST_CASE("interpret() should throw exception if operand is out of bounds after wrapping") {
+        Assembler assembler;
+
+        CHECK_THROWS_WITH(assembler.interpret({"LDA 256"}), "Assembler: interpret operand - out of bounds 256");
+        CHECK_THROWS_WITH(assembler.interpret({"LDA -1"}), "Assembler: interpret operand - out of bounds -1");
+    }
+
+    TEST_CASE("interpret() should throw exception for invalid numbers") {
+        Assembler assembler;
+
+        CHECK_THROWS_WITH(assembler.interpret({"DB abc"}), "Assembler: invalid number abc");
+        CHECK_THROWS_WITH(assembler.interpret({"JMP 12abc"}), "Assembler: invalid number 12abc");
+        CHECK_THROWS_WITH(assembler.interpret({"ORG 99999999999"}), "Assembler: invalid number 99999999999");
+    }
+
+    TEST_CASE("assembleToImage() should write the assembled memory to an image file") {
+        const std::string fileName = "assembler_test.8bim";
+        Assembler assembler;
+
+        assembler.assembleToImage("../../programs/add_two_numbers.asm", fileName);
+        const MachineImage::Program program = MachineImage::load(fileName);
+
+        std::remove(fileName.c_str());
+
+        CHECK_EQ(program.memory, Assembler::toImage(assembler.loadInstructions("../../programs/add_two_numbers.asm")));
+        CHECK_EQ(program.entry.programCounter, 0);
+        CHECK(program.symbols.empty());
+    }
+
+    TEST_CASE("assembleToImage() should throw exception if there are no instructions") {
+        Assembler assembler;
+
+        CHECK_THROWS_WITH(assembler.assembleToImage("../../programs/test/empty_test.asm", "assembler_test.8bim"),
+                          "Assembler: no instructions in file: ../../programs/test/empty_test.asm");
+    }
+
+    TEST_CASE("interpretSource() should give the same result as interpret() of the lines") {
+        Assembler assembler;
+
+        const std::vector<Assembler::Instruction> fromLines = assembler.interpret(
+                {"LDA 14 ; load", "", "; comment", "ADD 15", "OUT", "HLT", "ORG 14", "DB 28", "DB 14"});
+        const std::vector<Assembler::Instruction> fromSource = assembler.interpretSource(
+                "LDA 14 ; load\n\n; comment\nADD 15\nOUT\nHLT\nORG 14\nDB 28\nDB 14");
+
+        CHECK_EQ(Assembler::toImage(fromSource), Assembler::toImage(fromLines));
+        CHECK_EQ(fromSource.size(), 6);
+    }
+
+    TEST_CASE("interpretSource() should handle windows line endings, tabs and missing newline at the end") {
+        Assembler assembler;
+
+        const std::vector<Assembler::Instruction> instructions = assembler.interpretSource(
+                "LDI\t5\r\n\tOUT\r\nHLT");
+
+        CHECK_EQ(Assembler::toImage(instructions), MemoryImage{0x55, 0xE0, 0xF0});
+    }
+
+    TEST_CASE("interpretSource() should throw the same exceptions as interpret()") {
+        Assembler assembler;
+
+        CHECK_THROWS_WITH(assembler.interpretSource("OUT\nmonkey 1\n"),
+                          "Assembler: interpret mnemonic - unknown mnemonic monkey");
+        CHECK_THROWS_WITH(assembler.interpretSource("LDA 1 2 3"),
+                          "Assembler: interpret operand - wrong number of arguments to LDA");
+        CHECK_THROWS_WITH(assembler.interpretSource("DB"), "Assembler: wrong number of arguments to data");
+        CHECK_THROWS_WITH(assembler.interpretSource("ORG 16\n; comment"), "Assembler: address out of bounds 16");
+    }
+
+    TEST_CASE("interpret() should accept numbers with a plus sign") {
+        Assembler assembler;
+
+        CHECK_EQ(Assembler::toImage(assembler.interpret({"LDI +5"})), MemoryImage{0x55});
+        CHECK_THROWS_WITH(assembler.interpret({"LDI +-5"}), "Assembler: invalid number +-5");
+        CHECK_THROWS_WITH(assembler.interpret({"LDI +"}), "Assembler: invalid number +");
+    }
+
+    TEST_CASE("assemble() should return the image of valid code") {
+        Assembler assembler;
+
+        const Assembler::Result result = assembler.assemble("LDA 14\nADD 15\nOUT\nHLT\nORG 14\nDB 28\nDB 14\n");
+
+        CHECK(result.ok());
+        CHECK(result.errors.empty());
+        CHECK_EQ(result.instructions.size(), 6);
+        CHECK_EQ(result.image, MemoryImage{0x1E, 0x2F, 0xE0, 0xF0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 28, 14});
+    }
+
+    TEST_CASE("assemble() should report every invalid line with line and column, and assemble the rest") {
+        Assembler assembler;
+
+        const Assembler::Result result = assembler.assemble(
+                "LDI 5\n"
+                "\tmonkey 1\n"
+                "\n"
+                "LDA  -1 ; comment\n"
+                "DB 1 2\n"
+                "JMP 12abc\n"
+                "OUT");
+
+        REQUIRE_FALSE(result.ok());
+        REQUIRE_EQ(result.errors.size(), 4);
+
+        CHECK_EQ(result.errors[0].line, 2);
+        CHECK_EQ(result.errors[0].column, 2);
+        CHECK_EQ(result.errors[0].message, "interpret mnemonic - unknown mnemonic monkey");
+
+        CHECK_EQ(result.errors[1].line, 4);
+        CHECK_EQ(result.errors[1].column, 6);
+        CHECK_EQ(result.errors[1].message, "interpret operand - out of bounds -1");
+
+        CHECK_EQ(result.errors[2].line, 5);
+        CHECK_EQ(result.errors[2].column, 1);
+        CHECK_EQ(result.errors[2].message, "wrong number of arguments to data");
+
+        CHECK_EQ(result.errors[3].line, 6);
+        CHECK_EQ(result.errors[3].column, 5);
+        CHECK_EQ(result.errors[3].message, "invalid number 12abc");
+
+        CHECK_EQ(result.instructions.size(), 2);
+        CHECK_EQ(result.image[0], 0x55);
+        CHECK_EQ(result.image[1], 0xE0);
+    }
+
+    TEST_CASE("assemble() should report addresses that are out of bounds") {
+        Assembler assembler;
+
+        const Assembler::Result result = assembler.assemble("ORG 15\nOUT\n  HLT\nORG 17");
+
+        REQUIRE_EQ(result.errors.size(), 2);
+        CHECK_EQ(result.errors[0].line, 3);
+        CHECK_EQ(result.errors[0].column, 3);
+        CHECK_EQ(result.errors[0].message, "address out of bounds 16");
+        CHECK_EQ(result.errors[1].line, 4);
+        CHECK_EQ(result.errors[1].column, 1);
+    }
 }
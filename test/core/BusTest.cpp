@@ -60,6 +60,49 @@ TEST_SUITE("BusTest") {
         fakeit::VerifyNoOtherInvocations(observerMock);
     }
 
+    TEST_CASE("reset() should not notify observer when the value is 0 already") {
+        Bus bus = Bus();
+
+        fakeit::Mock<ValueObserver> observerMock;
+        auto observerPtr = std::shared_ptr<ValueObserver>(&observerMock(), [](...) {});
+        bus.setObserver(observerPtr);
+        fakeit::When(Method(observerMock, valueUpdated)).AlwaysReturn();
+
+        bus.reset();
+        fakeit::VerifyNoOtherInvocations(observerMock);
+
+        SUBCASE("unless notifying every write") {
+            bus.setNotifyEveryWrite(true);
+
+            bus.reset();
+            fakeit::Verify(Method(observerMock, valueUpdated).Using(0)).Once();
+        }
+    }
+
+    TEST_CASE("write() should only notify observer when the value changes") {
+        Bus bus = Bus();
+
+        fakeit::Mock<ValueObserver> observerMock;
+        auto observerPtr = std::shared_ptr<ValueObserver>(&observerMock(), [](...) {});
+        bus.setObserver(observerPtr);
+        fakeit::When(Method(observerMock, valueUpdated)).AlwaysReturn();
+
+        bus.write(3);
+        bus.write(3);
+        bus.write(4);
+
+        fakeit::Verify(Method(observerMock, valueUpdated).Using(3)).Once();
+        fakeit::Verify(Method(observerMock, valueUpdated).Using(4)).Once();
+        CHECK_EQ(bus.getNotificationStatistics().skipped, 1);
+
+        SUBCASE("unless notifying every write") {
+            bus.setNotifyEveryWrite(true);
+
+            bus.write(4);
+            fakeit::Verify(Method(observerMock, valueUpdated).Using(4)).Twice();
+        }
+    }
+
     TEST_CASE("print() should not fail") {
         Bus bus = Bus();
 
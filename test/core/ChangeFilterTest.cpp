@@ -0,0 +1,38 @@
+#include <doctest.h>
+
+#include "core/ChangeFilter.h"
+#include "core/EventObserver.h"
+
+using namespace Core;
+
+TEST_SUITE("ChangeFilterTest") {
+    TEST_CASE("shouldPass() should only pass values that changed") {
+        ChangeFilter filter;
+
+        CHECK(filter.shouldPass(0));
+        CHECK_FALSE(filter.shouldPass(0));
+        CHECK(filter.shouldPass(5));
+        CHECK_FALSE(filter.shouldPass(5));
+        CHECK(filter.shouldPass(0));
+
+        CHECK_EQ(filter.getStatistics().passed, 3);
+        CHECK_EQ(filter.getStatistics().skipped, 2);
+
+        SUBCASE("every write should pass everything") {
+            filter.setEveryWrite(true);
+
+            CHECK(filter.isEveryWrite());
+            CHECK(filter.shouldPass(0));
+            CHECK_EQ(filter.getStatistics().passed, 4);
+        }
+    }
+
+    TEST_CASE("shouldPass() should pass when any of the packed values changed") {
+        ChangeFilter filter;
+
+        CHECK(filter.shouldPass(Event::pack(0, false, true)));
+        CHECK(filter.shouldPass(Event::pack(0, true, true)));
+        CHECK_FALSE(filter.shouldPass(Event::pack(0, true, true)));
+        CHECK(filter.shouldPass(Event::pack(1, true, true)));
+    }
+}
@@ -0,0 +1,136 @@
+#include <doctest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iostream> // Due to bug with doctest on macOS in release mode: https://github.com/onqtam/doctest/issues/126
+
+#include "core/Checkpoint.h"
+
+using namespace Core;
+
+static Snapshot exampleSnapshot() {
+    Snapshot snapshot{};
+
+    for (int i = 0; i < RandomAccessMemory::MEMORY_SIZE; i++) {
+        snapshot.randomAccessMemory.memory[i] = i * 16 + 1;
+    }
+
+    snapshot.randomAccessMemory.address = 14;
+    snapshot.randomAccessMemory.readOnClock = true;
+    snapshot.clock.halted = true;
+    snapshot.bus.value = 201;
+    snapshot.aRegister = {202, true};
+    snapshot.bRegister = {203, false};
+    snapshot.arithmeticLogicUnit = {204, true, false};
+    snapshot.memoryAddressRegister = {13, true};
+    snapshot.programCounter = {12, true, false};
+    snapshot.instructionRegister = {205, true};
+    snapshot.outputRegister = {206, true};
+    snapshot.stepCounter.counter = 3;
+    snapshot.flagsRegister = {false, true, true};
+
+    return snapshot;
+}
+
+static void checkEqual(const Snapshot &actual, const Snapshot &expected) {
+    CHECK_EQ(actual.randomAccessMemory.memory, expected.randomAccessMemory.memory);
+    CHECK_EQ(actual.randomAccessMemory.address, expected.randomAccessMemory.address);
+    CHECK_EQ(actual.randomAccessMemory.readOnClock, expected.randomAccessMemory.readOnClock);
+    CHECK_EQ(actual.clock.halted, expected.clock.halted);
+    CHECK_EQ(actual.bus.value, expected.bus.value);
+    CHECK_EQ(actual.aRegister.value, expected.aRegister.value);
+    CHECK_EQ(actual.aRegister.readOnClock, expected.aRegister.readOnClock);
+    CHECK_EQ(actual.bRegister.value, expected.bRegister.value);
+    CHECK_EQ(actual.bRegister.readOnClock, expected.bRegister.readOnClock);
+    CHECK_EQ(actual.arithmeticLogicUnit.value, expected.arithmeticLogicUnit.value);
+    CHECK_EQ(actual.arithmeticLogicUnit.carry, expected.arithmeticLogicUnit.carry);
+    CHECK_EQ(actual.arithmeticLogicUnit.zero, expected.arithmeticLogicUnit.zero);
+    CHECK_EQ(actual.memoryAddressRegister.value, expected.memoryAddressRegister.value);
+    CHECK_EQ(actual.memoryAddressRegister.readOnClock, expected.memoryAddressRegister.readOnClock);
+    CHECK_EQ(actual.programCounter.value, expected.programCounter.value);
+    CHECK_EQ(actual.programCounter.incrementOnClock, expected.programCounter.incrementOnClock);
+    CHECK_EQ(actual.programCounter.readOnClock, expected.programCounter.readOnClock);
+    CHECK_EQ(actual.instructionRegister.value, expected.instructionRegister.value);
+    CHECK_EQ(actual.instructionRegister.readOnClock, expected.instructionRegister.readOnClock);
+    CHECK_EQ(actual.outputRegister.value, expected.outputRegister.value);
+    CHECK_EQ(actual.outputRegister.readOnClock, expected.outputRegister.readOnClock);
+    CHECK_EQ(actual.stepCounter.counter, expected.stepCounter.counter);
+    CHECK_EQ(actual.flagsRegister.carryFlag, expected.flagsRegister.carryFlag);
+    CHECK_EQ(actual.flagsRegister.zeroFlag, expected.flagsRegister.zeroFlag);
+    CHECK_EQ(actual.flagsRegister.readOnClock, expected.flagsRegister.readOnClock);
+}
+
+TEST_SUITE("CheckpointTest") {
+    TEST_CASE("toBytes() should write header and state") {
+        const std::vector<uint8_t> bytes = Checkpoint::toBytes(exampleSnapshot());
+
+        REQUIRE_EQ(bytes.size(), 6 + 36);
+        CHECK_EQ(std::string(bytes.begin(), bytes.begin() + 4), "8BCP");
+        CHECK_EQ(bytes[4], 1);
+        CHECK_EQ(bytes[5], 36);
+        CHECK_EQ(bytes[6], 1); // First byte of memory
+        CHECK_EQ(bytes[22], 14); // Memory address
+        CHECK_EQ(bytes[41], 0b110); // Flags register
+    }
+
+    TEST_CASE("fromBytes() should read what toBytes() wrote") {
+        const Snapshot snapshot = exampleSnapshot();
+
+        checkEqual(Checkpoint::fromBytes(Checkpoint::toBytes(snapshot)), snapshot);
+    }
+
+    TEST_CASE("fromBytes() should throw exception on wrong magic") {
+        std::vector<uint8_t> bytes = Checkpoint::toBytes(exampleSnapshot());
+        bytes[0] = 'X';
+
+        CHECK_THROWS_WITH(Checkpoint::fromBytes(bytes), "Checkpoint: not a checkpoint");
+        CHECK_THROWS_WITH(Checkpoint::fromBytes({}), "Checkpoint: not a checkpoint");
+    }
+
+    TEST_CASE("fromBytes() should throw exception on unknown version") {
+        std::vector<uint8_t> bytes = Checkpoint::toBytes(exampleSnapshot());
+        bytes[4] = 2;
+
+        CHECK_THROWS_WITH(Checkpoint::fromBytes(bytes), "Checkpoint: unsupported version 2");
+    }
+
+    TEST_CASE("fromBytes() should throw exception on wrong size") {
+        std::vector<uint8_t> bytes = Checkpoint::toBytes(exampleSnapshot());
+        bytes.pop_back();
+
+        CHECK_THROWS_WITH(Checkpoint::fromBytes(bytes), "Checkpoint: wrong size");
+    }
+
+    TEST_CASE("fromBytes() should throw exception on values out of bounds") {
+        std::vector<uint8_t> bytes = Checkpoint::toBytes(exampleSnapshot());
+        bytes[22] = 16;
+
+        CHECK_THROWS_WITH(Checkpoint::fromBytes(bytes), "Checkpoint: memory address out of bounds 16");
+    }
+
+    TEST_CASE("fromBytes() should throw exception on register values out of bounds") {
+        std::vector<uint8_t> bytes = Checkpoint::toBytes(exampleSnapshot());
+        bytes[32] = 16;
+
+        CHECK_THROWS_WITH(Checkpoint::fromBytes(bytes), "Checkpoint: memory address register out of bounds 16");
+
+        bytes = Checkpoint::toBytes(exampleSnapshot());
+        bytes[34] = 255;
+
+        CHECK_THROWS_WITH(Checkpoint::fromBytes(bytes), "Checkpoint: program counter out of bounds 255");
+    }
+
+    TEST_CASE("save() and load() should use a file") {
+        const std::string fileName = "checkpoint_test.8bcp";
+        const Snapshot snapshot = exampleSnapshot();
+
+        Checkpoint::save(fileName, snapshot);
+        checkEqual(Checkpoint::load(fileName), snapshot);
+
+        std::remove(fileName.c_str());
+    }
+
+    TEST_CASE("load() should throw exception for missing file") {
+        CHECK_THROWS_WITH(Checkpoint::load("does_not_exist.8bcp"), "Checkpoint: failed to open file: does_not_exist.8bcp");
+    }
+}
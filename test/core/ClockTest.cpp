@@ -246,6 +246,35 @@ TEST_SUITE("ClockTest") {
             fakeit::VerifyNoOtherInvocations(listenerMock);
         }
 
+        SUBCASE("runCycles() should notify listener of every cycle without using the time source") {
+            CHECK_EQ(clock.runCycles(3), 3);
+
+            fakeit::Verify(Method(listenerMock, clockTicked), Method(listenerMock, invertedClockTicked)).Exactly(3);
+            fakeit::Verify(Method(timeSourceMock, delta)).Never();
+            fakeit::Verify(Method(timeSourceMock, sleep)).Never();
+            CHECK_FALSE(clock.isRunning());
+        }
+
+        SUBCASE("runCycles() should stop on halt()") {
+            fakeit::When(Method(listenerMock, invertedClockTicked)).AlwaysDo([&]() { clock.halt(); });
+
+            CHECK_EQ(clock.runCycles(10), 1);
+            CHECK(clock.isHalted());
+            CHECK_FALSE(clock.isRunning());
+
+            CHECK_EQ(clock.runCycles(10), 0);
+
+            clock.reset();
+            CHECK_FALSE(clock.isHalted());
+        }
+
+        SUBCASE("runCycles() should stop running when a listener fails") {
+            fakeit::When(Method(listenerMock, clockTicked)).AlwaysThrow(std::runtime_error("failure"));
+
+            CHECK_THROWS_WITH(clock.runCycles(10), "failure");
+            CHECK_FALSE(clock.isRunning());
+        }
+
         SUBCASE("detach() should allow restarting the clock without join()") {
             clock.setFrequency(5);
             clock.start();
@@ -0,0 +1,84 @@
+#include <doctest.h>
+
+#include <iostream> // Due to bug with doctest on macOS in release mode: https://github.com/onqtam/doctest/issues/126
+#include <thread>
+#include <vector>
+
+#include "core/ConcurrentStateSet.h"
+
+using namespace Core;
+
+static ConcurrentStateSet::Key keyFor(const uint32_t number) {
+    ConcurrentStateSet::Key key{};
+    key[0] = number;
+    key[1] = number >> 8;
+    key[2] = number >> 16;
+    key[19] = number >> 24;
+
+    return key;
+}
+
+TEST_SUITE("ConcurrentStateSetTest") {
+    TEST_CASE("insert() should add new keys only once") {
+        ConcurrentStateSet set(100);
+
+        CHECK_EQ(set.size(), 0);
+        CHECK_EQ(set.insert(keyFor(1)), ConcurrentStateSet::Insert::ADDED);
+        CHECK_EQ(set.insert(keyFor(2)), ConcurrentStateSet::Insert::ADDED);
+        CHECK_EQ(set.insert(keyFor(1)), ConcurrentStateSet::Insert::EXISTS);
+        CHECK_EQ(set.insert(keyFor(2)), ConcurrentStateSet::Insert::EXISTS);
+        CHECK_EQ(set.size(), 2);
+    }
+
+    TEST_CASE("insert() should treat keys that only differ in the last byte as different") {
+        ConcurrentStateSet set(10);
+
+        ConcurrentStateSet::Key first{};
+        ConcurrentStateSet::Key second{};
+        second[ConcurrentStateSet::KEY_SIZE - 1] = 1;
+
+        CHECK_EQ(set.insert(first), ConcurrentStateSet::Insert::ADDED);
+        CHECK_EQ(set.insert(second), ConcurrentStateSet::Insert::ADDED);
+    }
+
+    TEST_CASE("insert() should report full when there is no more room") {
+        ConcurrentStateSet set(3);
+
+        CHECK_EQ(set.getMaxStates(), 3);
+        CHECK_EQ(set.insert(keyFor(1)), ConcurrentStateSet::Insert::ADDED);
+        CHECK_EQ(set.insert(keyFor(2)), ConcurrentStateSet::Insert::ADDED);
+        CHECK_EQ(set.insert(keyFor(3)), ConcurrentStateSet::Insert::ADDED);
+        CHECK_EQ(set.insert(keyFor(4)), ConcurrentStateSet::Insert::FULL);
+        CHECK_EQ(set.insert(keyFor(2)), ConcurrentStateSet::Insert::EXISTS);
+        CHECK_EQ(set.size(), 3);
+    }
+
+    TEST_CASE("insert() should add each key once when used from many threads") {
+        const uint32_t keys = 100000;
+        ConcurrentStateSet set(keys);
+        std::vector<std::thread> threads;
+        std::atomic<uint32_t> added(0);
+
+        // All the threads try to add the same keys, so they compete for every one of them
+        for (int i = 0; i < 4; i++) {
+            threads.emplace_back([&set, &added] {
+                for (uint32_t key = 0; key < keys; key++) {
+                    if (set.insert(keyFor(key * 2654435761u)) == ConcurrentStateSet::Insert::ADDED) {
+                        added++;
+                    }
+                }
+            });
+        }
+
+        for (auto &thread : threads) {
+            thread.join();
+        }
+
+        CHECK_EQ(added, keys);
+        CHECK_EQ(set.size(), keys);
+    }
+
+    TEST_CASE("constructor should throw exception on 0 max states") {
+        CHECK_THROWS_WITH(ConcurrentStateSet(0), "ConcurrentStateSet: max states must be more than 0");
+    }
+}
@@ -0,0 +1,71 @@
+#include <doctest.h>
+
+#include "core/InstructionDecoderObserver.h"
+
+using namespace Core;
+
+namespace {
+    class LinesCollector: public InstructionDecoderLinesObserver {
+
+    public:
+        std::vector<ControlLine> lines;
+
+        void controlLinesUpdated(const std::vector<ControlLine> &newLines) override {
+            lines = newLines;
+        }
+    };
+}
+
+TEST_SUITE("ControlWordTest") {
+    TEST_CASE("ControlWord() should have no lines enabled") {
+        const ControlWord controlWord;
+
+        CHECK(controlWord.empty());
+        CHECK_EQ(controlWord.bits(), 0);
+        CHECK_EQ(controlWord.toString(), "");
+        CHECK(controlWord.toLines().empty());
+        CHECK_FALSE(controlWord.has(ControlLine::HLT));
+    }
+
+    TEST_CASE("ControlWord() should set one bit for each line in the order of ControlLine") {
+        const ControlWord controlWord = {ControlLine::HLT, ControlLine::CO, ControlLine::FI};
+
+        CHECK_FALSE(controlWord.empty());
+        CHECK_EQ(controlWord.bits(), 0b101000000000000001);
+        CHECK(controlWord.has(ControlLine::HLT));
+        CHECK(controlWord.has(ControlLine::CO));
+        CHECK(controlWord.has(ControlLine::FI));
+        CHECK_FALSE(controlWord.has(ControlLine::MI));
+        CHECK_EQ(ControlWord::fromBits(controlWord.bits()), controlWord);
+    }
+
+    TEST_CASE("iterating should give the enabled lines in order") {
+        const ControlWord controlWord = {ControlLine::SO, ControlLine::AI, ControlLine::SM, ControlLine::FI};
+        std::vector<ControlLine> lines;
+
+        for (const ControlLine line : controlWord) {
+            lines.push_back(line);
+        }
+
+        const std::vector<ControlLine> expected = {ControlLine::AI, ControlLine::SM, ControlLine::SO, ControlLine::FI};
+        CHECK_EQ(lines, expected);
+        CHECK_EQ(controlWord.toLines(), expected);
+    }
+
+    TEST_CASE("toString() should use the names from the computer") {
+        CHECK_EQ(ControlWord({ControlLine::MI, ControlLine::CO}).toString(), "MI CO");
+        CHECK_EQ(ControlWord({ControlLine::AI, ControlLine::SM, ControlLine::SO, ControlLine::FI}).toString(),
+                 "AI S- SO FI");
+        CHECK_EQ(ControlWord::name(ControlLine::OM), "O-");
+    }
+
+    TEST_CASE("InstructionDecoderLinesObserver should give the lines as a list") {
+        LinesCollector collector;
+        InstructionDecoderObserver &observer = collector;
+
+        observer.controlWordUpdated({ControlLine::RO, ControlLine::II, ControlLine::CE});
+
+        const std::vector<ControlLine> expected = {ControlLine::RO, ControlLine::II, ControlLine::CE};
+        CHECK_EQ(collector.lines, expected);
+    }
+}
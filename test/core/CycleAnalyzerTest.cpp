@@ -0,0 +1,158 @@
+#include <doctest.h>
+
+#include <iostream> // Due to bug with doctest on macOS in release mode: https://github.com/onqtam/doctest/issues/126
+
+#include "core/Assembler.h"
+#include "core/CycleAnalyzer.h"
+#include "core/Interpreter.h"
+
+using namespace Core;
+
+static MemoryImage imageWith(const std::vector<uint8_t> &bytes) {
+    MemoryImage image{};
+    std::copy(bytes.begin(), bytes.end(), image.begin());
+
+    return image;
+}
+
+static MemoryImage loadImage(const std::string &fileName) {
+    Assembler assembler;
+
+    return Assembler::toImage(assembler.loadInstructions(fileName));
+}
+
+static unsigned long runCycles(const MemoryImage &image) {
+    Interpreter::State state = Interpreter::initialState(image);
+    unsigned long cycles = 0;
+
+    while (!state.halted && !state.failed && cycles < 100000) {
+        cycles += Interpreter::step(state);
+    }
+
+    return cycles;
+}
+
+TEST_SUITE("CycleAnalyzerTest") {
+    TEST_CASE("analyze() should count the cycles of a straight program exactly") {
+        const MemoryImage image = loadImage("../../programs/add_two_numbers.asm");
+
+        const CycleAnalyzer::Analysis analysis = CycleAnalyzer::analyze(image);
+
+        REQUIRE_EQ(analysis.blocks.size(), 1);
+        CHECK_EQ(analysis.blocks[0].first, 0);
+        CHECK_EQ(analysis.blocks[0].last, 3);
+        CHECK_EQ(analysis.blocks[0].cycles, 17);
+        CHECK(analysis.blocks[0].halts);
+        CHECK(analysis.canHalt);
+        CHECK(analysis.bounded);
+        CHECK_EQ(analysis.bestCase, 17);
+        CHECK_EQ(analysis.worstCase, 17);
+        CHECK_EQ(analysis.bestCase, runCycles(image));
+        CHECK_FALSE(analysis.selfModifying);
+
+        CHECK_EQ(analysis.cycles[0], 5);
+        CHECK_EQ(analysis.cycles[3], 2);
+        CHECK_EQ(analysis.cycles[14], 0);
+        CHECK_EQ(analysis.blockAt[14], -1);
+    }
+
+    TEST_CASE("analyze() should match the real cycles of programs without loops") {
+        for (const std::string program : {"nop_test", "subtract_two_numbers", "memory_test"}) {
+            const MemoryImage image = loadImage("../../programs/" + program + ".asm");
+
+            const CycleAnalyzer::Analysis analysis = CycleAnalyzer::analyze(image);
+
+            CHECK(analysis.bounded);
+            CHECK_EQ(analysis.bestCase, runCycles(image));
+            CHECK_EQ(analysis.worstCase, runCycles(image));
+        }
+    }
+
+    TEST_CASE("analyze() should build the control flow graph of a loop") {
+        const MemoryImage image = loadImage("../../programs/count_0_255_stop.asm");
+
+        const CycleAnalyzer::Analysis analysis = CycleAnalyzer::analyze(image);
+
+        // OUT, ADD 15, JC 4 | JMP 0 | HLT
+        REQUIRE_EQ(analysis.blocks.size(), 3);
+        CHECK_EQ(analysis.blocks[0].successors, std::vector<size_t>{1, 2});
+        CHECK_EQ(analysis.blocks[1].successors, std::vector<size_t>{0});
+        CHECK(analysis.blocks[2].successors.empty());
+        CHECK(analysis.blocks[2].halts);
+        CHECK_EQ(analysis.blocks[2].cycles, 2);
+
+        CHECK(analysis.canHalt);
+        CHECK_EQ(analysis.bestCase, 17);
+        CHECK_FALSE(analysis.bounded);
+        CHECK_LE(analysis.bestCase, runCycles(image));
+    }
+
+    TEST_CASE("analyze() should take the shortest and longest way when both branches halt") {
+        // JZ 3, NOP, NOP, HLT
+        const CycleAnalyzer::Analysis analysis = CycleAnalyzer::analyze(imageWith({0x83, 0x00, 0x00, 0xF0}));
+
+        REQUIRE_EQ(analysis.blocks.size(), 3);
+        CHECK_EQ(analysis.blocks[0].successors, std::vector<size_t>{1, 2});
+        CHECK_EQ(analysis.blocks[1].successors, std::vector<size_t>{2});
+        CHECK_EQ(analysis.blocks[1].cycles, 10);
+        CHECK(analysis.bounded);
+        CHECK_EQ(analysis.bestCase, 7);
+        CHECK_EQ(analysis.worstCase, 17);
+
+        // JZ 3, JMP 4, NOP, NOP, HLT
+        const CycleAnalyzer::Analysis jumps = CycleAnalyzer::analyze(imageWith({0x83, 0x64, 0x00, 0x00, 0xF0}));
+
+        REQUIRE_EQ(jumps.blocks.size(), 4);
+        CHECK_EQ(jumps.blocks[1].successors, std::vector<size_t>{3});
+        CHECK_EQ(jumps.blocks[2].successors, std::vector<size_t>{3});
+        CHECK_EQ(jumps.blockAt[2], -1);
+        CHECK_EQ(jumps.bestCase, 12);
+        CHECK_EQ(jumps.worstCase, 12);
+    }
+
+    TEST_CASE("analyze() should find programs that never halt") {
+        // JMP 0
+        const CycleAnalyzer::Analysis loop = CycleAnalyzer::analyze(imageWith({0x60}));
+
+        CHECK_FALSE(loop.canHalt);
+        CHECK_FALSE(loop.bounded);
+
+        // Unknown opcode fails instead of halting
+        const CycleAnalyzer::Analysis failing = CycleAnalyzer::analyze(imageWith({0x00, 0x90}));
+
+        REQUIRE_EQ(failing.blocks.size(), 1);
+        CHECK_EQ(failing.blocks[0].cycles, 7);
+        CHECK_FALSE(failing.blocks[0].halts);
+        CHECK(failing.blocks[0].successors.empty());
+        CHECK_FALSE(failing.canHalt);
+        CHECK(failing.bounded);
+    }
+
+    TEST_CASE("analyze() should notice when a program stores into its own code") {
+        // LDI 0, STA 2, NOP, HLT
+        const CycleAnalyzer::Analysis modifying = CycleAnalyzer::analyze(imageWith({0x50, 0x42, 0x00, 0xF0}));
+        CHECK(modifying.selfModifying);
+
+        // LDI 0, STA 15, HLT
+        const CycleAnalyzer::Analysis data = CycleAnalyzer::analyze(imageWith({0x50, 0x4F, 0xF0}));
+        CHECK_FALSE(data.selfModifying);
+    }
+
+    TEST_CASE("toListing() should annotate the program with cycles and blocks") {
+        const MemoryImage image = loadImage("../../programs/count_0_255_stop.asm");
+
+        const std::string listing = CycleAnalyzer::toListing(image, CycleAnalyzer::analyze(image));
+
+        CHECK_EQ(listing, "; Block 0 at 0-2: 15 cycles, next 1 2\n"
+                          " 0: OUT      ; 5 cycles\n"
+                          " 1: ADD 15   ; 5 cycles\n"
+                          " 2: JC 4     ; 5 cycles\n"
+                          "; Block 1 at 3-3: 5 cycles, next 0\n"
+                          " 3: JMP 0    ; 5 cycles\n"
+                          "; Block 2 at 4-4: 2 cycles, halts\n"
+                          " 4: HLT      ; 2 cycles\n"
+                          "15: DB 1\n"
+                          "; Best case: 17 cycles to HLT\n"
+                          "; Worst case: unbounded, the program can go around a loop\n");
+    }
+}
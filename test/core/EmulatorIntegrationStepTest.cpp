@@ -10,8 +10,8 @@ std::shared_ptr<T> ptr(fakeit::Mock<T> &mock) {
     return std::shared_ptr<T>(&mock(), [](...) {});
 }
 
-// Just a prettier cast from initializer_list to vector
-std::vector<ControlLine> lines(const std::vector<ControlLine> &lines) {
+// Just a prettier cast from initializer_list to control word
+ControlWord lines(const std::initializer_list<ControlLine> &lines) {
     return lines;
 }
 
@@ -40,7 +40,7 @@ struct State {
     uint8_t irValue = 0;
     uint8_t outValue = 0;
     uint8_t stepValue = 0;
-    std::vector<ControlLine> decoderLines{};
+    ControlWord decoderLines{};
     bool flagsCarry = false;
     bool flagsZero = false;
 };
@@ -56,7 +56,7 @@ TEST_SUITE("EmulatorIntegrationStepTest") {
         fakeit::Mock<ArithmeticLogicUnitObserver> aluObserver;
         fakeit::Mock<ValueObserver> marObserver;
         fakeit::Mock<ValueObserver> pcObserver;
-        fakeit::Mock<ValueObserver> ramObserver;
+        fakeit::Mock<RandomAccessMemoryObserver> ramObserver;
         fakeit::Mock<ValueObserver> irObserver;
         fakeit::Mock<ValueObserver> outObserver;
         fakeit::Mock<ValueObserver> stepObserver;
@@ -79,6 +79,7 @@ TEST_SUITE("EmulatorIntegrationStepTest") {
         fakeit::When(Method(bRegisterObserver, valueUpdated)).AlwaysDo([&](uint8_t newValue) {state.bRegValue = newValue;});
 
         emulator.setArithmeticLogicUnitObserver(ptr(aluObserver));
+        emulator.setArithmeticLogicUnitEager(true); // Like the user interface, to see every change
         fakeit::When(Method(aluObserver, resultUpdated)).AlwaysDo([&](uint8_t newValue, bool newCarryBit, bool newZeroBit) {
             state.aluValue = newValue;
             state.aluCarry = newCarryBit;
@@ -92,7 +93,8 @@ TEST_SUITE("EmulatorIntegrationStepTest") {
         fakeit::When(Method(pcObserver, valueUpdated)).AlwaysDo([&](uint8_t newValue) {state.pcValue = newValue;});
 
         emulator.setRandomAccessMemoryObserver(ptr(ramObserver));
-        fakeit::When(Method(ramObserver, valueUpdated)).AlwaysDo([&](uint8_t newValue) {state.ramValue = newValue;});
+        fakeit::When(Method(ramObserver, valueUpdated)).AlwaysDo([&](uint8_t, uint8_t newValue) {state.ramValue = newValue;});
+        fakeit::When(Method(ramObserver, memoryUpdated)).AlwaysReturn();
 
         emulator.setInstructionRegisterObserver(ptr(irObserver));
         fakeit::When(Method(irObserver, valueUpdated)).AlwaysDo([&](uint8_t newValue) {state.irValue = newValue;});
@@ -104,7 +106,7 @@ TEST_SUITE("EmulatorIntegrationStepTest") {
         fakeit::When(Method(stepObserver, valueUpdated)).AlwaysDo([&](uint8_t newValue) {state.stepValue = newValue;});
 
         emulator.setInstructionDecoderObserver(ptr(decoderObserver));
-        fakeit::When(Method(decoderObserver, controlWordUpdated)).AlwaysDo([&](const std::vector<ControlLine> &newLines) {
+        fakeit::When(Method(decoderObserver, controlWordUpdated)).AlwaysDo([&](ControlWord newLines) {
             state.decoderLines = newLines;
         });
 
@@ -1,10 +1,51 @@
 #include <doctest.h>
 #include <fakeit.hpp>
 
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+
 #include "core/Emulator.h"
+#include "core/MemoryOutputSink.h"
 
 using namespace Core;
 
+/** Waits until a changed program is assembled, or a few seconds have passed. */
+static bool waitForHotReload(const Emulator &emulator) {
+    for (int i = 0; i < 500 && !emulator.isHotReloadPending(); i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    return emulator.isHotReloadPending();
+}
+
+/** Keeps all the batches of events. */
+class EventCollector: public EventObserver {
+
+public:
+    std::vector<std::vector<Event>> batches;
+
+    void eventsUpdated(const Event *events, const size_t count) override {
+        batches.emplace_back(events, events + count);
+    }
+};
+
+/** Keeps a copy of the memory, like the memory panel in the user interface. */
+class MemoryCollector: public RandomAccessMemoryObserver {
+
+public:
+    MemoryImage memory{};
+
+    void valueUpdated(const uint8_t address, const uint8_t newValue) override {
+        memory[address] = newValue;
+    }
+
+    void memoryUpdated(const MemoryImage &newMemory) override {
+        memory = newMemory;
+    }
+};
+
 TEST_SUITE("EmulatorIntegrationTest") {
     TEST_CASE("emulator should work correctly") {
         Emulator emulator;
@@ -15,6 +56,7 @@ TEST_SUITE("EmulatorIntegrationTest") {
         fakeit::When(Method(observerMock, valueUpdated)).AlwaysReturn();
 
         emulator.setOutputRegisterObserver(observerPtr);
+        emulator.setNotifyEveryWrite(true); // To count every output
         emulator.setFrequency(5000);
 
         SUBCASE("load() should throw exception if file does not exist") {
@@ -97,6 +139,118 @@ TEST_SUITE("EmulatorIntegrationTest") {
             fakeit::VerifyNoOtherInvocations(observerMock);
         }
 
+        SUBCASE("observers should only be notified of changes when not notifying every write") {
+            emulator.setNotifyEveryWrite(false);
+            emulator.load("../../programs/count_0_255_stop.asm");
+
+            emulator.startSynchronous();
+
+            // Counting starts with the 0 from the reset
+            fakeit::Verify(Method(observerMock, valueUpdated).Using(0)).Once();
+
+            for (int i = 1; i <= 255; i++) {
+                fakeit::Verify(Method(observerMock, valueUpdated).Using(i)).Once();
+            }
+
+            fakeit::VerifyNoOtherInvocations(observerMock);
+
+            const ChangeFilter::Statistics statistics = emulator.getNotificationStatistics();
+            CHECK_EQ(statistics.passed, 256);
+            CHECK_EQ(statistics.skipped, 1);
+        }
+
+        SUBCASE("setEventObserver() should deliver the changes in batches at instruction boundaries") {
+            emulator.setNotifyEveryWrite(false);
+            emulator.load("../../programs/count_0_255_stop.asm");
+
+            auto collector = std::make_shared<EventCollector>();
+            emulator.setEventObserver(collector);
+
+            emulator.startSynchronous();
+
+            std::vector<Event> outputs;
+            unsigned long lastCycle = 0;
+
+            for (const auto &batch : collector->batches) {
+                REQUIRE_FALSE(batch.empty());
+
+                // An instruction is at most 5 cycles
+                CHECK_LE(batch.back().cycle - batch.front().cycle, 4);
+                CHECK_GE(batch.front().cycle, lastCycle);
+                lastCycle = batch.back().cycle;
+
+                for (const Event &event : batch) {
+                    CHECK_NE(event.oldValue, event.newValue);
+
+                    if (event.component == Event::Component::OUTPUT_REGISTER) {
+                        outputs.push_back(event);
+                    }
+                }
+            }
+
+            REQUIRE_EQ(outputs.size(), 255);
+
+            for (int i = 1; i <= 255; i++) {
+                CHECK_EQ(outputs[i - 1].oldValue, i - 1);
+                CHECK_EQ(outputs[i - 1].newValue, i);
+            }
+
+            // The observer of the output register still gets the changes one by one
+            for (int i = 0; i <= 255; i++) {
+                fakeit::Verify(Method(observerMock, valueUpdated).Using(i)).Once();
+            }
+
+            fakeit::VerifyNoOtherInvocations(observerMock);
+        }
+
+        SUBCASE("setEventObserver() should deliver the changes every number of cycles") {
+            emulator.load("../../programs/add_two_numbers.asm");
+
+            auto collector = std::make_shared<EventCollector>();
+            emulator.setEventObserver(collector, 7);
+
+            CHECK_EQ(emulator.runSynchronous(14), 14);
+            CHECK_EQ(collector->batches.size(), 2);
+
+            for (const Event &event : collector->batches[0]) {
+                CHECK_LT(event.cycle, 7);
+            }
+
+            emulator.setEventObserver(nullptr);
+            emulator.runSynchronous(100);
+
+            CHECK_EQ(collector->batches.size(), 2);
+        }
+
+        SUBCASE("setOutputSink() should stream every output with the cycle") {
+            emulator.load("../../programs/count_0_255_stop.asm");
+
+            auto sink = std::make_shared<MemoryOutputSink>(1000);
+            emulator.setOutputSink(sink);
+
+            emulator.startSynchronous();
+            emulator.flushOutputs();
+
+            const std::vector<Output> outputs = sink->getOutputs();
+            REQUIRE_EQ(outputs.size(), 256);
+
+            // The same loop of instructions between each output
+            const unsigned long loopCycles = outputs[1].cycle - outputs[0].cycle;
+
+            for (int i = 0; i <= 255; i++) {
+                CHECK_EQ(outputs[i].value, i);
+                CHECK_EQ(outputs[i].cycle, outputs[0].cycle + i * loopCycles);
+            }
+
+            CHECK_EQ(emulator.getDroppedOutputs(), 0);
+
+            emulator.setOutputSink(nullptr);
+            emulator.reload();
+            emulator.startSynchronous();
+
+            CHECK_EQ(sink->getCount(), 256);
+        }
+
         SUBCASE("reload() should reset all state including memory") {
             emulator.load("../../programs/memory_test.asm");
 
@@ -117,6 +271,325 @@ TEST_SUITE("EmulatorIntegrationTest") {
             fakeit::VerifyNoOtherInvocations(observerMock);
         }
 
+        SUBCASE("load() and reload() should notify the memory observer of all of memory") {
+            const auto memory = std::make_shared<MemoryCollector>();
+            emulator.setRandomAccessMemoryObserver(memory);
+
+            const MemoryImage image = Assembler::toImage(Assembler().loadInstructions("../../programs/memory_test.asm"));
+            emulator.load("../../programs/memory_test.asm");
+
+            for (int i = 0; i < RandomAccessMemory::MEMORY_SIZE; i++) {
+                CHECK_EQ(memory->memory[i], image[i]);
+            }
+
+            emulator.startSynchronous();
+
+            CHECK_EQ(memory->memory[14], 7); // Stored by STA 14
+
+            emulator.reload();
+
+            for (int i = 0; i < RandomAccessMemory::MEMORY_SIZE; i++) {
+                CHECK_EQ(memory->memory[i], image[i]);
+            }
+        }
+
+        SUBCASE("load() should run a memory image") {
+            emulator.load(Assembler::toImage(Assembler().loadInstructions("../../programs/multiply_two_numbers.asm")));
+            emulator.startSynchronous();
+
+            fakeit::Verify(Method(observerMock, valueUpdated).Using(0)).Once(); // Reset before start
+            fakeit::Verify(Method(observerMock, valueUpdated).Using(56)).Once(); // 7*8
+            fakeit::VerifyNoOtherInvocations(observerMock);
+
+            observerMock.ClearInvocationHistory();
+
+            emulator.reload();
+            emulator.startSynchronous();
+
+            fakeit::Verify(Method(observerMock, valueUpdated).Using(56)).Once();
+        }
+
+        SUBCASE("load() should replace all of memory from the previous program") {
+            emulator.load("../../programs/add_two_numbers.asm");
+
+            // Only defines addresses 0 to 3, so 14 and 15 would still have 28 and 14 if left alone
+            std::vector<Assembler::Instruction> instructions = Assembler().interpret({"LDA 14", "ADD 15", "OUT", "HLT"});
+            emulator.load(instructions);
+            emulator.startSynchronous();
+
+            fakeit::Verify(Method(observerMock, valueUpdated).Using(42)).Never();
+        }
+
+        SUBCASE("loadSource() should run source code from memory") {
+            emulator.loadSource("LDI 5\nADD 15\nOUT\nHLT\nORG 15\nDB 37\n");
+            emulator.startSynchronous();
+
+            fakeit::Verify(Method(observerMock, valueUpdated).Using(42)).Once();
+
+            emulator.reload();
+            emulator.startSynchronous();
+
+            fakeit::Verify(Method(observerMock, valueUpdated).Using(42)).Twice();
+        }
+
+        SUBCASE("loadSource() should throw exception with the line and column of invalid code") {
+            CHECK_THROWS_WITH(emulator.loadSource("LDI 5\n  LDA 7 8\n"),
+                              "Emulator: line 2 column 3: interpret operand - wrong number of arguments to LDA");
+            CHECK_THROWS_WITH(emulator.loadSource("; nothing\n"), "Emulator: no instructions loaded. Aborting");
+        }
+
+        SUBCASE("reload() should use the loaded program, and reloadFile() should read the file again") {
+            const std::string fileName = "emulator_integration_test.asm";
+
+            std::ofstream(fileName) << "LDI 5\nOUT\nHLT\n";
+            emulator.load(fileName);
+            std::ofstream(fileName) << "LDI 6\nOUT\nHLT\n";
+
+            emulator.reload();
+            emulator.startSynchronous();
+            fakeit::Verify(Method(observerMock, valueUpdated).Using(5)).Once();
+            fakeit::Verify(Method(observerMock, valueUpdated).Using(6)).Never();
+
+            emulator.reloadFile();
+            emulator.startSynchronous();
+
+            std::remove(fileName.c_str());
+
+            fakeit::Verify(Method(observerMock, valueUpdated).Using(5)).Once();
+            fakeit::Verify(Method(observerMock, valueUpdated).Using(6)).Once();
+        }
+
+        SUBCASE("setHotReload() should swap in the changed program at an instruction boundary while running") {
+            const std::string fileName = "emulator_integration_test.asm";
+
+            // Outputs 5 forever, and then 6 from the same addresses after the change
+            std::ofstream(fileName) << "LDI 5\nOUT\nJMP 1\n";
+            emulator.load(fileName);
+            emulator.setHotReload(Emulator::HotReload::INSTRUCTION);
+            emulator.runSynchronous(23);
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+            std::ofstream(fileName) << "LDI 6\nLDI 6\nOUT\nJMP 1\n";
+            REQUIRE(waitForHotReload(emulator));
+
+            CHECK_EQ(emulator.getHotReloadLatency().count(), 0);
+            emulator.runSynchronous(50);
+
+            emulator.setHotReload(Emulator::HotReload::OFF);
+            std::remove(fileName.c_str());
+
+            CHECK_FALSE(emulator.isHotReloadPending());
+            CHECK_GT(emulator.getHotReloadLatency().count(), 0);
+            fakeit::Verify(Method(observerMock, valueUpdated).Using(6)).AtLeastOnce();
+        }
+
+        SUBCASE("setHotReload() should wait for reload() when swapping on reset") {
+            const std::string fileName = "emulator_integration_test.asm";
+
+            std::ofstream(fileName) << "LDI 5\nOUT\nJMP 1\n";
+            emulator.load(fileName);
+            emulator.setHotReload(Emulator::HotReload::RESET);
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+            std::ofstream(fileName) << "LDI 6\nOUT\nJMP 1\n";
+            REQUIRE(waitForHotReload(emulator));
+
+            emulator.runSynchronous(50);
+            fakeit::Verify(Method(observerMock, valueUpdated).Using(6)).Never();
+
+            emulator.reload();
+            emulator.runSynchronous(50);
+
+            emulator.setHotReload(Emulator::HotReload::OFF);
+            std::remove(fileName.c_str());
+
+            fakeit::Verify(Method(observerMock, valueUpdated).Using(6)).AtLeastOnce();
+        }
+
+        SUBCASE("load() of a program in memory should stop the hot reload of the file before") {
+            const std::string fileName = "emulator_integration_test.asm";
+
+            std::ofstream(fileName) << "LDI 5\nOUT\nJMP 1\n";
+            emulator.load(fileName);
+            emulator.setHotReload(Emulator::HotReload::INSTRUCTION);
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+            std::ofstream(fileName) << "LDI 6\nLDI 6\nOUT\nJMP 1\n";
+            REQUIRE(waitForHotReload(emulator));
+
+            // The change that was waiting is dropped with the file
+            emulator.loadSource("LDI 7\nOUT\nJMP 1\n");
+            CHECK_FALSE(emulator.isHotReloadPending());
+
+            const MemoryImage memory = emulator.snapshot().randomAccessMemory.memory;
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+            std::ofstream(fileName) << "LDI 8\nLDI 8\nOUT\nJMP 1\n";
+            std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+            CHECK_FALSE(emulator.isHotReloadPending());
+
+            emulator.runSynchronous(50);
+            CHECK_EQ(emulator.snapshot().randomAccessMemory.memory, memory);
+
+            emulator.reload();
+            CHECK_EQ(emulator.snapshot().randomAccessMemory.memory, memory);
+
+            std::remove(fileName.c_str());
+
+            fakeit::Verify(Method(observerMock, valueUpdated).Using(7)).AtLeastOnce();
+            fakeit::Verify(Method(observerMock, valueUpdated).Using(6)).Never();
+            fakeit::Verify(Method(observerMock, valueUpdated).Using(8)).Never();
+        }
+
+        SUBCASE("setHotReload() should throw exception if the program is not from a file") {
+            emulator.loadSource("OUT\nHLT\n");
+
+            CHECK_THROWS_WITH(emulator.setHotReload(Emulator::HotReload::INSTRUCTION),
+                              "Emulator: hot reload needs a program loaded from a file");
+        }
+
+        SUBCASE("load() should run a machine image with entry values") {
+            const std::string fileName = "emulator_integration_test.8bim";
+
+            // OUT, ADD 15, OUT, HLT, with A and B set from the entry
+            MachineImage::Program program{};
+            program.memory = {0xE0, 0x2F, 0xE0, 0xF0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 5};
+            program.entry = {0, 30, 12};
+            MachineImage::save(fileName, program);
+
+            emulator.load(fileName);
+            emulator.startSynchronous();
+
+            fakeit::Verify(Method(observerMock, valueUpdated).Using(30)).Once();
+            fakeit::Verify(Method(observerMock, valueUpdated).Using(35)).Once();
+
+            observerMock.ClearInvocationHistory();
+
+            // Starting further in
+            program.entry = {2, 7, 0};
+            MachineImage::save(fileName, program);
+
+            emulator.reloadFile();
+            emulator.startSynchronous();
+
+            std::remove(fileName.c_str());
+
+            fakeit::Verify(Method(observerMock, valueUpdated).Using(7)).Once();
+            fakeit::Verify(Method(observerMock, valueUpdated).Using(12)).Never();
+        }
+
+        SUBCASE("restore() should continue from the snapshot") {
+            emulator.load("../../programs/multiply_two_numbers.asm");
+
+            // Somewhere in the middle of the multiplication
+            emulator.runSynchronous(103);
+            const Snapshot snapshot = emulator.snapshot();
+
+            const unsigned long cycles = emulator.runSynchronous(100000);
+            CHECK(emulator.isHalted());
+            fakeit::Verify(Method(observerMock, valueUpdated).Using(56)).Once();
+
+            observerMock.ClearInvocationHistory();
+
+            emulator.restore(snapshot);
+            CHECK_FALSE(emulator.isHalted());
+
+            CHECK_EQ(emulator.runSynchronous(100000), cycles);
+            CHECK(emulator.isHalted());
+
+            // Once for the restore, and once when done
+            fakeit::Verify(Method(observerMock, valueUpdated).Using(0)).Once();
+            fakeit::Verify(Method(observerMock, valueUpdated).Using(56)).Once();
+            fakeit::VerifyNoOtherInvocations(observerMock);
+        }
+
+        SUBCASE("loadCheckpoint() should continue from saveCheckpoint()") {
+            const std::string fileName = "emulator_integration_test.8bcp";
+
+            emulator.load("../../programs/count_0_255_stop.asm");
+            emulator.runSynchronous(1002);
+            emulator.saveCheckpoint(fileName);
+
+            emulator.load("../../programs/nop_test.asm");
+            observerMock.ClearInvocationHistory();
+
+            emulator.loadCheckpoint(fileName);
+            emulator.runSynchronous(100000);
+
+            std::remove(fileName.c_str());
+
+            CHECK(emulator.isHalted());
+            fakeit::Verify(Method(observerMock, valueUpdated).Using(255)).Once();
+            // Already counted past these before the checkpoint
+            fakeit::Verify(Method(observerMock, valueUpdated).Using(0)).Never();
+            fakeit::Verify(Method(observerMock, valueUpdated).Using(1)).Never();
+        }
+
+        SUBCASE("fork() should give children that continue from the same state") {
+            emulator.load("../../programs/count_0_255_stop.asm");
+
+            // After OUT and ADD, so JC is next
+            emulator.runSynchronous(10);
+            std::vector<Fork> children = emulator.fork(3);
+            observerMock.ClearInvocationHistory();
+
+            children[1].setFlags(true, false); // Jump to HLT
+            children[2].writeMemory(15, 2); // Count by 2
+
+            emulator.restore(children[0]);
+            emulator.runSynchronous(100000);
+            CHECK(emulator.isHalted());
+            fakeit::Verify(Method(observerMock, valueUpdated).Using(255)).Once();
+            fakeit::Verify(Method(observerMock, valueUpdated).Using(2)).Once();
+
+            const Fork halted = emulator.fork(children[0]);
+            CHECK(halted.isSiblingOf(children[0]));
+            CHECK(halted.toSnapshot().clock.halted);
+
+            observerMock.ClearInvocationHistory();
+            emulator.restore(children[1]);
+            emulator.runSynchronous(100000);
+            CHECK(emulator.isHalted());
+            fakeit::Verify(Method(observerMock, valueUpdated).Using(0)).Once(); // For the restore
+            fakeit::VerifyNoOtherInvocations(observerMock);
+
+            observerMock.ClearInvocationHistory();
+            emulator.restore(children[2]);
+            emulator.runSynchronous(100000);
+            CHECK(emulator.isHalted());
+            // Odd numbers only, since it was at 1 when forked
+            fakeit::Verify(Method(observerMock, valueUpdated).Using(3)).Once();
+            fakeit::Verify(Method(observerMock, valueUpdated).Using(4)).Never();
+            fakeit::Verify(Method(observerMock, valueUpdated).Using(255)).Once();
+        }
+
+        SUBCASE("runSynchronous() should complete add_two_numbers.asm loaded from instructions") {
+            Assembler assembler;
+            emulator.load(assembler.loadInstructions("../../programs/add_two_numbers.asm"));
+
+            // 3 instructions of 5 cycles, and 2 cycles to fetch HLT
+            CHECK_EQ(emulator.runSynchronous(1000), 17);
+            CHECK(emulator.isHalted());
+
+            fakeit::Verify(Method(observerMock, valueUpdated).Using(0)).Once(); // Reset before start
+            fakeit::Verify(Method(observerMock, valueUpdated).Using(42)).Once(); // 28+14
+            fakeit::VerifyNoOtherInvocations(observerMock);
+        }
+
+        SUBCASE("runSynchronous() should stop after max cycles") {
+            emulator.load("../../programs/count_0_255.asm");
+
+            CHECK_EQ(emulator.runSynchronous(100), 100);
+            CHECK_FALSE(emulator.isHalted());
+            CHECK_FALSE(emulator.isRunning());
+        }
+
+        SUBCASE("load() should throw exception if there are no instructions") {
+            CHECK_THROWS_WITH(emulator.load(std::vector<Assembler::Instruction>()),
+                              "Emulator: no instructions loaded. Aborting");
+        }
+
         SUBCASE("increaseFrequency() and decreaseFrequency() should work") {
             fakeit::Mock<ClockObserver> clockObserver;
             auto clockPtr = std::shared_ptr<ClockObserver>(&clockObserver(), [](...) {});
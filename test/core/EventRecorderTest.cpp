@@ -0,0 +1,172 @@
+#include <doctest.h>
+#include <fakeit.hpp>
+
+#include "core/EventRecorder.h"
+
+using namespace Core;
+
+/** Keeps all the batches of events. */
+class EventBatches: public EventObserver {
+
+public:
+    std::vector<std::vector<Event>> batches;
+
+    void eventsUpdated(const Event *events, const size_t count) override {
+        batches.emplace_back(events, events + count);
+    }
+};
+
+TEST_SUITE("EventRecorderTest") {
+    TEST_CASE("EventRecorder should record changes and deliver them in batches") {
+        auto clock = std::make_shared<Clock>(std::make_shared<TimeSource>());
+        auto recorder = std::make_shared<EventRecorder>(clock);
+        auto batches = std::make_shared<EventBatches>();
+        clock->addListener(recorder);
+
+        fakeit::Mock<ValueObserver> observerMock;
+        auto observerPtr = std::shared_ptr<ValueObserver>(&observerMock(), [](...) {});
+        fakeit::When(Method(observerMock, valueUpdated)).AlwaysReturn();
+
+        const auto bus = recorder->tapValue(Event::Component::BUS, observerPtr);
+
+        SUBCASE("nothing should be recorded without an observer") {
+            bus->valueUpdated(1);
+            recorder->flush();
+
+            CHECK_FALSE(recorder->isRecording());
+            fakeit::Verify(Method(observerMock, valueUpdated).Using(1)).Once();
+        }
+
+        SUBCASE("only changes should be recorded, and passed on to the next observer") {
+            recorder->setObserver(batches, 2);
+            recorder->setValue(Event::Component::BUS, 3);
+
+            bus->valueUpdated(3);
+            bus->valueUpdated(4);
+            clock->runCycles(1);
+            bus->valueUpdated(4);
+            bus->valueUpdated(5);
+
+            CHECK(batches->batches.empty());
+
+            clock->runCycles(1);
+
+            REQUIRE_EQ(batches->batches.size(), 1);
+            REQUIRE_EQ(batches->batches[0].size(), 2);
+            CHECK_EQ(batches->batches[0][0].cycle, 0);
+            CHECK_EQ(batches->batches[0][0].oldValue, 3);
+            CHECK_EQ(batches->batches[0][0].newValue, 4);
+            CHECK_EQ(batches->batches[0][1].cycle, 1);
+            CHECK_EQ(batches->batches[0][1].oldValue, 4);
+            CHECK_EQ(batches->batches[0][1].newValue, 5);
+
+            fakeit::Verify(Method(observerMock, valueUpdated)).Exactly(4);
+        }
+
+        SUBCASE("every write should be recorded with setEveryWrite()") {
+            recorder->setObserver(batches, 1);
+            recorder->setEveryWrite(true);
+
+            bus->valueUpdated(0);
+            bus->valueUpdated(0);
+            recorder->flush();
+
+            REQUIRE_EQ(batches->batches.size(), 1);
+            CHECK_EQ(batches->batches[0].size(), 2);
+        }
+
+        SUBCASE("memory events should have the address, and all of memory should be recorded when replaced") {
+            recorder->setObserver(batches, 1);
+            const auto memory = recorder->tapRandomAccessMemory(nullptr);
+
+            memory->valueUpdated(3, 9);
+            memory->valueUpdated(4, 9);
+
+            MemoryImage image{};
+            image[15] = 1;
+            memory->memoryUpdated(image);
+            recorder->flush();
+
+            REQUIRE_EQ(batches->batches.size(), 1);
+            REQUIRE_EQ(batches->batches[0].size(), 18);
+            CHECK_EQ(batches->batches[0][0].newValue, Event::packMemory(3, 9));
+            CHECK_EQ(batches->batches[0][1].newValue, Event::packMemory(4, 9));
+            CHECK_EQ(batches->batches[0][2].newValue, Event::packMemory(0, 0));
+            CHECK_EQ(batches->batches[0][17].newValue, Event::packMemory(15, 1));
+        }
+
+        SUBCASE("events should be delivered at instruction boundaries with 0 flush cycles") {
+            recorder->setObserver(batches, 0);
+            const auto stepCounter = recorder->tapValue(Event::Component::STEP_COUNTER, nullptr);
+
+            stepCounter->valueUpdated(1);
+            clock->runCycles(1);
+            stepCounter->valueUpdated(0);
+
+            CHECK(batches->batches.empty());
+
+            clock->runCycles(1);
+
+            REQUIRE_EQ(batches->batches.size(), 1);
+            CHECK_EQ(batches->batches[0].size(), 2);
+        }
+
+        SUBCASE("setObserver() should deliver the events for the last observer first") {
+            recorder->setObserver(batches, 100);
+            bus->valueUpdated(1);
+
+            recorder->setObserver(nullptr, 0);
+
+            CHECK_EQ(batches->batches.size(), 1);
+        }
+    }
+
+    TEST_CASE("EventDispatcher should pass each event on to the observer of the component") {
+        fakeit::Mock<ValueObserver> valueMock;
+        auto valuePtr = std::shared_ptr<ValueObserver>(&valueMock(), [](...) {});
+        fakeit::When(Method(valueMock, valueUpdated)).AlwaysReturn();
+
+        fakeit::Mock<ArithmeticLogicUnitObserver> arithmeticLogicUnitMock;
+        auto arithmeticLogicUnitPtr = std::shared_ptr<ArithmeticLogicUnitObserver>(&arithmeticLogicUnitMock(),
+                                                                                   [](...) {});
+        fakeit::When(Method(arithmeticLogicUnitMock, resultUpdated)).AlwaysReturn();
+
+        fakeit::Mock<FlagsRegisterObserver> flagsMock;
+        auto flagsPtr = std::shared_ptr<FlagsRegisterObserver>(&flagsMock(), [](...) {});
+        fakeit::When(Method(flagsMock, flagsUpdated)).AlwaysReturn();
+
+        fakeit::Mock<RandomAccessMemoryObserver> memoryMock;
+        auto memoryPtr = std::shared_ptr<RandomAccessMemoryObserver>(&memoryMock(), [](...) {});
+        fakeit::When(Method(memoryMock, valueUpdated)).AlwaysReturn();
+
+        fakeit::Mock<InstructionDecoderObserver> decoderMock;
+        auto decoderPtr = std::shared_ptr<InstructionDecoderObserver>(&decoderMock(), [](...) {});
+        fakeit::When(Method(decoderMock, controlWordUpdated)).AlwaysReturn();
+
+        EventDispatcher dispatcher;
+        dispatcher.setValueObserver(Event::Component::OUTPUT_REGISTER, valuePtr);
+        dispatcher.setArithmeticLogicUnitObserver(arithmeticLogicUnitPtr);
+        dispatcher.setFlagsRegisterObserver(flagsPtr);
+        dispatcher.setRandomAccessMemoryObserver(memoryPtr);
+        dispatcher.setInstructionDecoderObserver(decoderPtr);
+
+        const ControlWord word = {ControlLine::AI, ControlLine::RO};
+        const Event events[] = {
+                {0, 0, 7, Event::Component::OUTPUT_REGISTER},
+                {0, 0, 9, Event::Component::BUS},
+                {1, 0, Event::pack(200, true, false), Event::Component::ARITHMETIC_LOGIC_UNIT},
+                {1, 0, Event::pack(false, true), Event::Component::FLAGS_REGISTER},
+                {1, 0, Event::packMemory(14, 42), Event::Component::RANDOM_ACCESS_MEMORY},
+                {2, 0, word.bits(), Event::Component::INSTRUCTION_DECODER}
+        };
+
+        dispatcher.eventsUpdated(events, 6);
+
+        fakeit::Verify(Method(valueMock, valueUpdated).Using(7)).Once();
+        fakeit::Verify(Method(arithmeticLogicUnitMock, resultUpdated).Using(200, true, false)).Once();
+        fakeit::Verify(Method(flagsMock, flagsUpdated).Using(false, true)).Once();
+        fakeit::Verify(Method(memoryMock, valueUpdated).Using(14, 42)).Once();
+        fakeit::Verify(Method(decoderMock, controlWordUpdated).Using(word)).Once();
+        fakeit::VerifyNoOtherInvocations(valueMock);
+    }
+}
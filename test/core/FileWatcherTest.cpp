@@ -0,0 +1,88 @@
+#include <doctest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream> // Due to bug with doctest on macOS in release mode: https://github.com/onqtam/doctest/issues/126
+#include <thread>
+
+#include "core/FileWatcher.h"
+
+using namespace Core;
+
+namespace {
+    class ChangeCounter: public FileListener {
+
+    public:
+        std::atomic<int> changes = 0;
+
+        void fileChanged() override {
+            changes++;
+        }
+    };
+}
+
+/** Waits until the condition is true, or a few seconds have passed. */
+template<typename Condition>
+static bool waitFor(const Condition &condition) {
+    for (int i = 0; i < 500 && !condition(); i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    return condition();
+}
+
+TEST_SUITE("FileWatcherTest") {
+    TEST_CASE("start() should notify the listener when the file is written to") {
+        const std::string fileName = "file_watcher_test.asm";
+        std::ofstream(fileName) << "OUT\n";
+
+        auto counter = std::make_shared<ChangeCounter>();
+        FileWatcher watcher(fileName, counter);
+        watcher.start();
+
+        CHECK(watcher.isWatching());
+
+        // Can only see changes after it has started
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        std::ofstream(fileName) << "HLT\n";
+
+        CHECK(waitFor([&counter]() { return counter->changes > 0; }));
+
+        watcher.stop();
+        std::remove(fileName.c_str());
+
+        CHECK_FALSE(watcher.isWatching());
+    }
+
+    TEST_CASE("start() should notify the listener when the file is replaced") {
+        const std::string fileName = "file_watcher_test.asm";
+        const std::string newFileName = "file_watcher_test.asm.new";
+        std::ofstream(fileName) << "OUT\n";
+
+        auto counter = std::make_shared<ChangeCounter>();
+        FileWatcher watcher(fileName, counter);
+        watcher.start();
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        std::ofstream(newFileName) << "HLT\n";
+        const int changesBeforeRename = counter->changes;
+        std::rename(newFileName.c_str(), fileName.c_str());
+
+        CHECK(waitFor([&counter, changesBeforeRename]() { return counter->changes > changesBeforeRename; }));
+
+        watcher.stop();
+        std::remove(fileName.c_str());
+    }
+
+    TEST_CASE("start() should throw exception if the directory does not exist") {
+        FileWatcher watcher("does/not/exist.asm", std::make_shared<ChangeCounter>());
+
+        const std::string expected = "FileWatcher: failed to watch file: " +
+                                     std::filesystem::absolute("does/not/exist.asm").string();
+        CHECK_THROWS_WITH(watcher.start(), expected.c_str());
+        CHECK_FALSE(watcher.isWatching());
+    }
+}
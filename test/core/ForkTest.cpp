@@ -0,0 +1,92 @@
+#include <doctest.h>
+
+#include <iostream> // Due to bug with doctest on macOS in release mode: https://github.com/onqtam/doctest/issues/126
+
+#include "core/Fork.h"
+
+using namespace Core;
+
+static Snapshot parentSnapshot() {
+    Snapshot snapshot{};
+    snapshot.randomAccessMemory.memory[15] = 1;
+    snapshot.aRegister.value = 10;
+
+    return snapshot;
+}
+
+TEST_SUITE("ForkTest") {
+    TEST_CASE("fork should have the state of the parent without changes") {
+        const Fork fork(parentSnapshot());
+
+        const Snapshot snapshot = fork.toSnapshot();
+
+        CHECK_EQ(fork.getChangedBytes(), 0);
+        CHECK_EQ(snapshot.randomAccessMemory.memory[15], 1);
+        CHECK_EQ(snapshot.aRegister.value, 10);
+    }
+
+    TEST_CASE("copies should share the parent, and only store their own changes") {
+        const Fork parent(parentSnapshot());
+        Fork first = parent;
+        Fork second = parent;
+
+        first.writeMemory(15, 2);
+        second.setFlags(true, true);
+
+        CHECK(first.isSiblingOf(second));
+        CHECK_EQ(&first.getParent(), &second.getParent());
+        CHECK_EQ(first.getChangedBytes(), 1);
+        CHECK_EQ(second.getChangedBytes(), 2);
+        CHECK_EQ(parent.getChangedBytes(), 0);
+
+        CHECK_EQ(first.toSnapshot().randomAccessMemory.memory[15], 2);
+        CHECK_FALSE(first.toSnapshot().flagsRegister.carryFlag);
+        CHECK_EQ(second.toSnapshot().randomAccessMemory.memory[15], 1);
+        CHECK(second.toSnapshot().flagsRegister.carryFlag);
+        CHECK(second.toSnapshot().flagsRegister.zeroFlag);
+        CHECK_EQ(first.getParent().randomAccessMemory.memory[15], 1);
+    }
+
+    TEST_CASE("writing back the value of the parent should remove the change") {
+        Fork fork(parentSnapshot());
+
+        fork.writeMemory(15, 2);
+        fork.writeMemory(14, 3);
+        fork.writeMemory(15, 4);
+        CHECK_EQ(fork.getChangedBytes(), 2);
+
+        fork.writeMemory(15, 1);
+        CHECK_EQ(fork.getChangedBytes(), 1);
+        CHECK_EQ(fork.toSnapshot().randomAccessMemory.memory[14], 3);
+        CHECK_EQ(fork.toSnapshot().randomAccessMemory.memory[15], 1);
+    }
+
+    TEST_CASE("withState() should only store the bytes that differ from the parent") {
+        const Fork parent(parentSnapshot());
+
+        Snapshot snapshot = parentSnapshot();
+        snapshot.aRegister.value = 11;
+        snapshot.programCounter.value = 3;
+
+        const Fork sibling = parent.withState(snapshot);
+
+        CHECK(sibling.isSiblingOf(parent));
+        CHECK_EQ(sibling.getChangedBytes(), 2);
+        CHECK_EQ(sibling.toSnapshot().aRegister.value, 11);
+        CHECK_EQ(sibling.toSnapshot().programCounter.value, 3);
+        CHECK_EQ(sibling.toSnapshot().randomAccessMemory.memory[15], 1);
+    }
+
+    TEST_CASE("writeMemory() should throw exception on address out of bounds") {
+        Fork fork(parentSnapshot());
+
+        CHECK_THROWS_WITH(fork.writeMemory(16, 1), "Fork: memory address out of bounds 16");
+    }
+
+    TEST_CASE("separate forks should not be siblings") {
+        const Fork first(parentSnapshot());
+        const Fork second(parentSnapshot());
+
+        CHECK_FALSE(first.isSiblingOf(second));
+    }
+}
@@ -156,6 +156,26 @@ TEST_SUITE("GenericRegisterTest") {
             fakeit::VerifyNoOtherInvocations(observerMock);
         }
 
+        SUBCASE("setState() should restore value and pending read from the bus") {
+            bus->write(45);
+            genericRegister.in();
+            const GenericRegister::State state = genericRegister.getState();
+
+            CHECK_EQ(state.value, 0);
+            CHECK(state.readOnClock);
+
+            clock.clockTicked();
+            CHECK_EQ(genericRegister.readValue(), 45);
+
+            genericRegister.setState(state);
+            CHECK_EQ(genericRegister.readValue(), 0);
+
+            // The read is still pending
+            bus->write(46);
+            clock.clockTicked();
+            CHECK_EQ(genericRegister.readValue(), 46);
+        }
+
         SUBCASE("print() should not fail") {
             genericRegister.print();
         }
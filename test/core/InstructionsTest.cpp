@@ -0,0 +1,34 @@
+#include <doctest.h>
+
+#include <iostream> // Due to bug with doctest on macOS in release mode: https://github.com/onqtam/doctest/issues/126
+
+#include "core/Instructions.h"
+
+using namespace Core;
+
+TEST_SUITE("InstructionsTest") {
+    TEST_CASE("find() should find all the instructions") {
+        for (const auto &instruction : {Instructions::NOP, Instructions::LDA, Instructions::ADD, Instructions::SUB,
+                                        Instructions::STA, Instructions::LDI, Instructions::JMP, Instructions::JC,
+                                        Instructions::JZ, Instructions::OUT, Instructions::HLT}) {
+            CHECK_EQ(Instructions::find(instruction.mnemonic), instruction);
+        }
+    }
+
+    TEST_CASE("find() should return UNKNOWN for anything else") {
+        // Same slot in the hash table as real instructions
+        CHECK_EQ(Instructions::find("NOT"), Instructions::UNKNOWN);
+        CHECK_EQ(Instructions::find("LLA"), Instructions::UNKNOWN);
+
+        CHECK_EQ(Instructions::find("nop"), Instructions::UNKNOWN);
+        CHECK_EQ(Instructions::find("JCC"), Instructions::UNKNOWN);
+        CHECK_EQ(Instructions::find("J"), Instructions::UNKNOWN);
+        CHECK_EQ(Instructions::find(""), Instructions::UNKNOWN);
+        CHECK_EQ(Instructions::find("UNKNOWN"), Instructions::UNKNOWN);
+    }
+
+    TEST_CASE("operator!=() should be the opposite of operator==()") {
+        CHECK(Instructions::NOP != Instructions::HLT);
+        CHECK_FALSE(Instructions::NOP != Instructions::NOP);
+    }
+}
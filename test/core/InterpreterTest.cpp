@@ -0,0 +1,220 @@
+#include <doctest.h>
+
+#include <iostream> // Due to bug with doctest on macOS in release mode: https://github.com/onqtam/doctest/issues/126
+
+#include "core/Assembler.h"
+#include "core/Emulator.h"
+#include "core/Instructions.h"
+#include "core/Interpreter.h"
+#include "core/OutputCollector.h"
+
+using namespace Core;
+
+static Interpreter::State stateWith(const std::vector<uint8_t> &bytes) {
+    MemoryImage memory{};
+    std::copy(bytes.begin(), bytes.end(), memory.begin());
+
+    return Interpreter::initialState(memory);
+}
+
+/** Runs the program on both the interpreter and the emulator, and checks that they agree. */
+static void compareWithEmulator(const std::string &fileName, const unsigned long maxCycles) {
+    Assembler assembler;
+    const std::vector<Assembler::Instruction> instructions = assembler.loadInstructions(fileName);
+
+    Interpreter::State state = Interpreter::initialState(Assembler::toImage(instructions));
+    std::vector<uint8_t> interpreterOutputs;
+    unsigned long interpreterCycles = 0;
+
+    while (!state.halted && !state.failed && interpreterCycles < maxCycles) {
+        const bool output = state.memory[state.programCounter] >> 4 == Instructions::OUT.opcode;
+
+        interpreterCycles += Interpreter::step(state);
+
+        if (output) {
+            interpreterOutputs.push_back(state.outputRegister);
+        }
+    }
+
+    Emulator emulator;
+    auto collector = std::make_shared<OutputCollector>();
+    emulator.setOutputRegisterObserver(collector);
+    emulator.setNotifyEveryWrite(true);
+    emulator.load(instructions);
+    collector->values.clear(); // Skip the value from the reset
+
+    const unsigned long emulatorCycles = emulator.runSynchronous(maxCycles);
+
+    CHECK(state.halted);
+    CHECK(emulator.isHalted());
+    CHECK_EQ(interpreterCycles, emulatorCycles);
+    CHECK_EQ(interpreterOutputs, collector->values);
+}
+
+TEST_SUITE("InterpreterTest") {
+    TEST_CASE("initialState() should only contain the memory") {
+        MemoryImage memory{};
+        memory[3] = 42;
+
+        const Interpreter::State state = Interpreter::initialState(memory);
+
+        CHECK_EQ(state.memory, memory);
+        CHECK_EQ(state.aRegister, 0);
+        CHECK_EQ(state.bRegister, 0);
+        CHECK_EQ(state.programCounter, 0);
+        CHECK_EQ(state.outputRegister, 0);
+        CHECK_FALSE(state.carryFlag);
+        CHECK_FALSE(state.zeroFlag);
+        CHECK_FALSE(state.halted);
+        CHECK_FALSE(state.failed);
+    }
+
+    TEST_CASE("step() should execute NOP") {
+        Interpreter::State state = stateWith({0x00});
+
+        Interpreter::State expected = stateWith({0x00});
+        expected.programCounter = 1;
+
+        CHECK_EQ(Interpreter::step(state), 5);
+        CHECK_EQ(state, expected);
+    }
+
+    TEST_CASE("step() should execute LDA") {
+        Interpreter::State state = stateWith({0x13, 0, 0, 77});
+
+        CHECK_EQ(Interpreter::step(state), 5);
+        CHECK_EQ(state.aRegister, 77);
+        CHECK_EQ(state.programCounter, 1);
+    }
+
+    TEST_CASE("step() should execute ADD with flags") {
+        Interpreter::State state = stateWith({0x14, 0x25, 0x24, 0, 200, 56});
+
+        Interpreter::step(state);
+        Interpreter::step(state);
+
+        CHECK_EQ(state.aRegister, 0);
+        CHECK_EQ(state.bRegister, 56);
+        CHECK(state.carryFlag);
+        CHECK(state.zeroFlag);
+
+        Interpreter::step(state);
+
+        CHECK_EQ(state.aRegister, 200);
+        CHECK_EQ(state.bRegister, 200);
+        CHECK_FALSE(state.carryFlag);
+        CHECK_FALSE(state.zeroFlag);
+    }
+
+    TEST_CASE("step() should execute SUB with flags") {
+        Interpreter::State state = stateWith({0x13, 0x34, 0x35, 30, 12, 0});
+
+        Interpreter::step(state);
+        Interpreter::step(state);
+
+        CHECK_EQ(state.aRegister, 18);
+        CHECK_EQ(state.bRegister, 12);
+        CHECK(state.carryFlag);
+        CHECK_FALSE(state.zeroFlag);
+
+        // Subtracting 0 is the same as adding 0, so no carry
+        Interpreter::step(state);
+
+        CHECK_EQ(state.aRegister, 18);
+        CHECK_FALSE(state.carryFlag);
+        CHECK_FALSE(state.zeroFlag);
+    }
+
+    TEST_CASE("step() should execute STA") {
+        Interpreter::State state = stateWith({0x59, 0x4F});
+
+        Interpreter::step(state);
+        Interpreter::step(state);
+
+        CHECK_EQ(state.memory[15], 9);
+    }
+
+    TEST_CASE("step() should execute LDI") {
+        Interpreter::State state = stateWith({0x5B});
+
+        CHECK_EQ(Interpreter::step(state), 5);
+        CHECK_EQ(state.aRegister, 11);
+    }
+
+    TEST_CASE("step() should execute JMP") {
+        Interpreter::State state = stateWith({0x6C});
+
+        Interpreter::step(state);
+
+        CHECK_EQ(state.programCounter, 12);
+    }
+
+    TEST_CASE("step() should execute JC and JZ depending on the flags") {
+        Interpreter::State state = stateWith({0x7C, 0x8D});
+
+        Interpreter::step(state);
+        CHECK_EQ(state.programCounter, 1);
+
+        Interpreter::step(state);
+        CHECK_EQ(state.programCounter, 2);
+
+        state = stateWith({0x7C});
+        state.carryFlag = true;
+        Interpreter::step(state);
+        CHECK_EQ(state.programCounter, 12);
+
+        state = stateWith({0x8D});
+        state.zeroFlag = true;
+        Interpreter::step(state);
+        CHECK_EQ(state.programCounter, 13);
+    }
+
+    TEST_CASE("step() should execute OUT") {
+        Interpreter::State state = stateWith({0x57, 0xE0});
+
+        Interpreter::step(state);
+        Interpreter::step(state);
+
+        CHECK_EQ(state.outputRegister, 7);
+    }
+
+    TEST_CASE("step() should halt on HLT after 2 cycles") {
+        Interpreter::State state = stateWith({0xF0});
+
+        CHECK_EQ(Interpreter::step(state), 2);
+        CHECK(state.halted);
+        CHECK_FALSE(state.failed);
+
+        // Nothing more happens
+        CHECK_EQ(Interpreter::step(state), 0);
+        CHECK_EQ(state.programCounter, 1);
+    }
+
+    TEST_CASE("step() should fail on unknown opcode after 2 cycles") {
+        Interpreter::State state = stateWith({0x90});
+
+        CHECK_EQ(Interpreter::step(state), 2);
+        CHECK(state.failed);
+        CHECK_FALSE(state.halted);
+        CHECK_EQ(Interpreter::step(state), 0);
+    }
+
+    TEST_CASE("step() should wrap the program counter around") {
+        Interpreter::State state = stateWith({});
+        state.programCounter = 15;
+
+        Interpreter::step(state);
+
+        CHECK_EQ(state.programCounter, 0);
+    }
+
+    TEST_CASE("step() should give the same result as the emulator") {
+        compareWithEmulator("../../programs/nop_test.asm", 1000);
+        compareWithEmulator("../../programs/add_two_numbers.asm", 1000);
+        compareWithEmulator("../../programs/subtract_two_numbers.asm", 1000);
+        compareWithEmulator("../../programs/multiply_two_numbers.asm", 10000);
+        compareWithEmulator("../../programs/count_0_255_stop.asm", 100000);
+        compareWithEmulator("../../programs/count_255_0_stop.asm", 100000);
+        compareWithEmulator("../../programs/memory_test.asm", 1000);
+    }
+}
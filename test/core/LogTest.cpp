@@ -0,0 +1,117 @@
+#include <doctest.h>
+
+#include <cstdio>
+#include <functional>
+#include <sstream>
+#include <thread>
+#include <unistd.h>
+
+#include "core/Log.h"
+
+using namespace Core;
+
+/** Everything the log writes to standard out while running the function. */
+static std::string captureLog(const std::function<void()> &function) {
+    fflush(stdout);
+
+    FILE *file = std::tmpfile();
+    const int standardOut = dup(fileno(stdout));
+    dup2(fileno(file), fileno(stdout));
+
+    function();
+    Log::flush();
+
+    dup2(standardOut, fileno(stdout));
+    close(standardOut);
+
+    std::string output;
+    char buffer[4096];
+    size_t length;
+    rewind(file);
+
+    while ((length = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        output.append(buffer, length);
+    }
+
+    fclose(file);
+
+    return output;
+}
+
+TEST_SUITE("LogTest") {
+    TEST_CASE("printf() should write the messages in order") {
+        const std::string output = captureLog([] {
+            for (int i = 0; i < 100; i++) {
+                Log::printf("*** Display: %d\n", i);
+            }
+        });
+
+        std::string expected;
+
+        for (int i = 0; i < 100; i++) {
+            expected += "*** Display: " + std::to_string(i) + "\n";
+        }
+
+        CHECK_EQ(output, expected);
+    }
+
+    TEST_CASE("println() should add a newline") {
+        const std::string output = captureLog([] {
+            Log::println("Clock: stopped");
+        });
+
+        CHECK_EQ(output, "Clock: stopped\n");
+    }
+
+    TEST_CASE("printf() should cut off long messages") {
+        const std::string output = captureLog([] {
+            Log::println(std::string(Log::MESSAGE_SIZE * 2, 'x'));
+        });
+
+        CHECK_EQ(output, std::string(Log::MESSAGE_SIZE - 2, 'x') + "\n");
+    }
+
+    TEST_CASE("setQuiet() should stop all logging") {
+        const std::string output = captureLog([] {
+            Log::setQuiet(true);
+            CHECK(Log::isQuiet());
+            Log::println("Clock: stopped");
+            Log::setQuiet(false);
+            CHECK_FALSE(Log::isQuiet());
+        });
+
+        CHECK_EQ(output, "");
+    }
+
+    TEST_CASE("printf() should write or count every message from many threads") {
+        const unsigned long droppedBefore = Log::getDropped();
+
+        const std::string output = captureLog([] {
+            std::vector<std::thread> threads;
+
+            for (int thread = 0; thread < 4; thread++) {
+                threads.emplace_back([thread] {
+                    for (int i = 0; i < 5000; i++) {
+                        Log::printf("Thread %d: %d\n", thread, i);
+                    }
+                });
+            }
+
+            for (auto &thread : threads) {
+                thread.join();
+            }
+        });
+
+        std::stringstream lines(output);
+        std::string line;
+        unsigned long written = 0;
+
+        while (std::getline(lines, line)) {
+            if (line.rfind("Thread ", 0) == 0) {
+                written++;
+            }
+        }
+
+        CHECK_EQ(written + Log::getDropped() - droppedBefore, 20000);
+    }
+}
@@ -0,0 +1,128 @@
+#include <doctest.h>
+
+#include <cstdio>
+#include <iostream> // Due to bug with doctest on macOS in release mode: https://github.com/onqtam/doctest/issues/126
+
+#include "core/MachineImage.h"
+
+using namespace Core;
+
+static MachineImage::Program exampleProgram() {
+    MachineImage::Program program{};
+    program.memory = {0x1E, 0x2F, 0xE0, 0xF0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 28, 14};
+    program.entry = {1, 2, 3};
+    program.symbols = {{"first", 14}, {"second", 15}};
+
+    return program;
+}
+
+static void checkEqual(const MachineImage::Program &actual, const MachineImage::Program &expected) {
+    CHECK_EQ(actual.memory, expected.memory);
+    CHECK_EQ(actual.entry.programCounter, expected.entry.programCounter);
+    CHECK_EQ(actual.entry.aRegister, expected.entry.aRegister);
+    CHECK_EQ(actual.entry.bRegister, expected.entry.bRegister);
+    CHECK_EQ(actual.symbols, expected.symbols);
+}
+
+TEST_SUITE("MachineImageTest") {
+    TEST_CASE("toBytes() should write header and body") {
+        const std::vector<uint8_t> bytes = MachineImage::toBytes(exampleProgram());
+
+        // Header, memory, entry, symbol count, and the symbols with address and length
+        REQUIRE_EQ(bytes.size(), 12 + 16 + 3 + 1 + 2 + 5 + 2 + 6);
+        CHECK_EQ(std::string(bytes.begin(), bytes.begin() + 4), "8BIM");
+        CHECK_EQ(bytes[4], 1);
+        CHECK_EQ(bytes[5], 16);
+        CHECK_EQ(bytes[6], bytes.size() - 12);
+        CHECK_EQ(bytes[7], 0);
+        CHECK_EQ(bytes[12], 0x1E);
+        CHECK_EQ(bytes[28], 1);
+        CHECK_EQ(bytes[31], 2);
+    }
+
+    TEST_CASE("fromBytes() should read what toBytes() wrote") {
+        const MachineImage::Program program = exampleProgram();
+
+        checkEqual(MachineImage::fromBytes(MachineImage::toBytes(program)), program);
+    }
+
+    TEST_CASE("fromBytes() should read a program without symbols") {
+        MachineImage::Program program = exampleProgram();
+        program.symbols.clear();
+
+        checkEqual(MachineImage::fromBytes(MachineImage::toBytes(program)), program);
+    }
+
+    TEST_CASE("fromBytes() should throw exception on wrong magic") {
+        std::vector<uint8_t> bytes = MachineImage::toBytes(exampleProgram());
+        bytes[3] = 'P';
+
+        CHECK_THROWS_WITH(MachineImage::fromBytes(bytes), "MachineImage: not a machine image");
+        CHECK_THROWS_WITH(MachineImage::fromBytes({}), "MachineImage: not a machine image");
+    }
+
+    TEST_CASE("fromBytes() should throw exception on unknown version") {
+        std::vector<uint8_t> bytes = MachineImage::toBytes(exampleProgram());
+        bytes[4] = 9;
+
+        CHECK_THROWS_WITH(MachineImage::fromBytes(bytes), "MachineImage: unsupported version 9");
+    }
+
+    TEST_CASE("fromBytes() should throw exception on other memory size") {
+        std::vector<uint8_t> bytes = MachineImage::toBytes(exampleProgram());
+        bytes[5] = 32;
+
+        CHECK_THROWS_WITH(MachineImage::fromBytes(bytes), "MachineImage: unsupported memory size 32");
+    }
+
+    TEST_CASE("fromBytes() should throw exception on wrong size") {
+        std::vector<uint8_t> bytes = MachineImage::toBytes(exampleProgram());
+        bytes.pop_back();
+
+        CHECK_THROWS_WITH(MachineImage::fromBytes(bytes), "MachineImage: wrong size");
+    }
+
+    TEST_CASE("fromBytes() should throw exception on corrupt body") {
+        std::vector<uint8_t> bytes = MachineImage::toBytes(exampleProgram());
+        bytes[20]++;
+
+        CHECK_THROWS_WITH(MachineImage::fromBytes(bytes), "MachineImage: checksum mismatch");
+    }
+
+    TEST_CASE("toBytes() should throw exception on values out of bounds") {
+        MachineImage::Program program = exampleProgram();
+        program.entry.programCounter = 16;
+
+        CHECK_THROWS_WITH(MachineImage::toBytes(program), "MachineImage: entry address out of bounds 16");
+
+        program = exampleProgram();
+        program.symbols.push_back({"third", 16});
+
+        CHECK_THROWS_WITH(MachineImage::toBytes(program), "MachineImage: symbol address out of bounds 16");
+
+        program = exampleProgram();
+        program.symbols.push_back({"", 1});
+
+        CHECK_THROWS_WITH(MachineImage::toBytes(program), "MachineImage: invalid symbol name length 0");
+    }
+
+    TEST_CASE("save() and load() should use a file") {
+        const std::string fileName = "machine_image_test.8bim";
+        const MachineImage::Program program = exampleProgram();
+
+        MachineImage::save(fileName, program);
+        checkEqual(MachineImage::load(fileName), program);
+
+        std::remove(fileName.c_str());
+    }
+
+    TEST_CASE("load() should throw exception for missing file") {
+        CHECK_THROWS_WITH(MachineImage::load("does_not_exist.8bim"),
+                          "MachineImage: failed to open file: does_not_exist.8bim");
+    }
+
+    TEST_CASE("isImageFile() should check the extension") {
+        CHECK(MachineImage::isImageFile("programs/add_two_numbers.8bim"));
+        CHECK_FALSE(MachineImage::isImageFile("programs/add_two_numbers.asm"));
+    }
+}
@@ -0,0 +1,183 @@
+#include <doctest.h>
+
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <iostream> // Due to bug with doctest on macOS in release mode: https://github.com/onqtam/doctest/issues/126
+#include <sstream>
+#include <thread>
+
+#include "core/FileOutputSink.h"
+#include "core/MemoryOutputSink.h"
+#include "core/OutputStream.h"
+
+using namespace Core;
+
+static const std::string FILE_NAME = "output_stream_test.txt";
+
+static std::string readFile(const std::string &fileName) {
+    std::ifstream file(fileName);
+    std::stringstream text;
+    text << file.rdbuf();
+
+    return text.str();
+}
+
+/** A sink that waits until it's opened, and then takes its time, so the queue fills up. */
+class SlowOutputSink: public MemoryOutputSink {
+
+public:
+    std::atomic<bool> open{true};
+
+    SlowOutputSink() : MemoryOutputSink(1000000) {}
+
+    void outputsWritten(const Output *outputs, const size_t count) override {
+        do {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        } while (!open);
+
+        MemoryOutputSink::outputsWritten(outputs, count);
+    }
+};
+
+TEST_SUITE("OutputStreamTest") {
+    TEST_CASE("write() should deliver the outputs with the clock cycle") {
+        OutputStream stream;
+        auto sink = std::make_shared<MemoryOutputSink>(10);
+
+        CHECK_FALSE(stream.isStreaming());
+
+        stream.setSink(sink, OutputStream::Overflow::WAIT);
+
+        CHECK(stream.isStreaming());
+
+        stream.write(1);
+        stream.invertedClockTicked();
+        stream.invertedClockTicked();
+        stream.write(2);
+        stream.write(3);
+        stream.flush();
+
+        const std::vector<Output> outputs = sink->getOutputs();
+        REQUIRE_EQ(outputs.size(), 3);
+        CHECK_EQ(outputs[0].cycle, 0);
+        CHECK_EQ(outputs[0].value, 1);
+        CHECK_EQ(outputs[1].cycle, 2);
+        CHECK_EQ(outputs[1].value, 2);
+        CHECK_EQ(outputs[2].cycle, 2);
+        CHECK_EQ(outputs[2].value, 3);
+    }
+
+    TEST_CASE("write() should do nothing without a sink") {
+        OutputStream stream;
+        auto sink = std::make_shared<MemoryOutputSink>(10);
+
+        stream.setSink(sink, OutputStream::Overflow::WAIT);
+        stream.write(1);
+        stream.setSink(nullptr, OutputStream::Overflow::WAIT);
+        stream.write(2);
+        stream.flush();
+
+        CHECK_FALSE(stream.isStreaming());
+        CHECK_EQ(sink->getCount(), 1);
+    }
+
+    TEST_CASE("write() should keep every output when waiting for a slow sink") {
+        OutputStream stream;
+        auto sink = std::make_shared<SlowOutputSink>();
+        const unsigned long total = OutputStream::CAPACITY * 3;
+
+        stream.setSink(sink, OutputStream::Overflow::WAIT);
+
+        for (unsigned long i = 0; i < total; i++) {
+            stream.write(i);
+            stream.invertedClockTicked();
+        }
+
+        stream.flush();
+
+        CHECK_EQ(stream.getDropped(), 0);
+        CHECK_EQ(sink->getCount(), total);
+
+        const std::vector<Output> outputs = sink->getOutputs();
+
+        for (unsigned long i = 0; i < total; i++) {
+            CHECK_EQ(outputs[i].cycle, i);
+            CHECK_EQ(outputs[i].value, (uint8_t) i);
+        }
+    }
+
+    TEST_CASE("write() should count the outputs dropped for a slow sink") {
+        OutputStream stream;
+        auto sink = std::make_shared<SlowOutputSink>();
+        const unsigned long total = OutputStream::CAPACITY * 3;
+
+        sink->open = false;
+        stream.setSink(sink, OutputStream::Overflow::DROP);
+
+        for (unsigned long i = 0; i < total; i++) {
+            stream.write(i);
+        }
+
+        sink->open = true;
+        stream.flush();
+
+        CHECK_GT(stream.getDropped(), 0);
+        CHECK_EQ(sink->getCount() + stream.getDropped(), total);
+    }
+
+    TEST_CASE("MemoryOutputSink should keep the latest outputs") {
+        MemoryOutputSink sink(3);
+        const Output outputs[] = {{0, 10}, {1, 11}, {2, 12}, {3, 13}, {4, 14}};
+
+        sink.outputsWritten(outputs, 2);
+
+        CHECK_EQ(sink.getOutputs().size(), 2);
+
+        sink.outputsWritten(outputs + 2, 3);
+
+        const std::vector<Output> kept = sink.getOutputs();
+        REQUIRE_EQ(kept.size(), 3);
+        CHECK_EQ(kept[0].value, 12);
+        CHECK_EQ(kept[1].value, 13);
+        CHECK_EQ(kept[2].value, 14);
+        CHECK_EQ(sink.getCount(), 5);
+    }
+
+    TEST_CASE("MemoryOutputSink should throw exception on 0 capacity") {
+        CHECK_THROWS_WITH(MemoryOutputSink(0), "MemoryOutputSink: capacity must be at least 1");
+    }
+
+    TEST_CASE("FileOutputSink should write a line for each output") {
+        std::remove(FILE_NAME.c_str());
+
+        {
+            FileOutputSink sink(FILE_NAME);
+            const Output outputs[] = {{2, 0}, {26, 255}};
+            sink.outputsWritten(outputs, 2);
+        }
+
+        CHECK_EQ(readFile(FILE_NAME), "2 0\n26 255\n");
+
+        std::remove(FILE_NAME.c_str());
+    }
+
+    TEST_CASE("FileOutputSink should throw exception if the file can't be opened") {
+        CHECK_THROWS_WITH(FileOutputSink("missing/output.txt"),
+                          "FileOutputSink: failed to open file: missing/output.txt");
+    }
+
+    TEST_CASE("PipeOutputSink should write to the command") {
+        std::remove(FILE_NAME.c_str());
+
+        {
+            PipeOutputSink sink("cat > " + FILE_NAME);
+            const Output outputs[] = {{7, 42}};
+            sink.outputsWritten(outputs, 1);
+        }
+
+        CHECK_EQ(readFile(FILE_NAME), "7 42\n");
+
+        std::remove(FILE_NAME.c_str());
+    }
+}
@@ -0,0 +1,132 @@
+#include <doctest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iostream> // Due to bug with doctest on macOS in release mode: https://github.com/onqtam/doctest/issues/126
+
+#include "core/PackFile.h"
+
+using namespace Core;
+
+static const std::string FILE_NAME = "pack_file_test.8bpk";
+
+static std::vector<PackFile::Entry> exampleEntries() {
+    return {
+            {"first.asm",  {0x1E, 0x2F, 0xE0, 0xF0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 28, 14}},
+            {"second.asm", {0xE0, 0xF0}},
+            {"",           {}}
+    };
+}
+
+/** Writes the bytes over the file from the offset. */
+static void patch(const size_t offset, const std::vector<uint8_t> &bytes) {
+    std::fstream file(FILE_NAME, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(offset);
+    file.write(reinterpret_cast<const char *>(bytes.data()), bytes.size());
+}
+
+TEST_SUITE("PackFileTest") {
+    TEST_CASE("pack file should read what write() wrote") {
+        const std::vector<PackFile::Entry> entries = exampleEntries();
+        PackFile::write(FILE_NAME, entries);
+
+        {
+            const PackFile pack(FILE_NAME);
+
+            REQUIRE_EQ(pack.size(), 3);
+            pack.verifyChecksum();
+
+            for (size_t i = 0; i < entries.size(); i++) {
+                CHECK_EQ(pack.image(i), entries[i].image);
+                CHECK_EQ(pack.name(i), entries[i].name);
+            }
+
+            // The images are packed after each other
+            CHECK_EQ(pack.end() - pack.begin(), 3);
+            CHECK_EQ(&pack.image(1), pack.begin() + 1);
+
+            size_t index = 0;
+
+            for (const MemoryImage &image : pack) {
+                CHECK_EQ(image, entries[index++].image);
+            }
+        }
+
+        std::remove(FILE_NAME.c_str());
+    }
+
+    TEST_CASE("pack file should be empty without entries") {
+        PackFile::write(FILE_NAME, {});
+
+        {
+            const PackFile pack(FILE_NAME);
+
+            CHECK_EQ(pack.size(), 0);
+            CHECK_EQ(pack.begin(), pack.end());
+            pack.verifyChecksum();
+        }
+
+        std::remove(FILE_NAME.c_str());
+    }
+
+    TEST_CASE("image() and name() should throw exception on index out of bounds") {
+        PackFile::write(FILE_NAME, exampleEntries());
+
+        {
+            const PackFile pack(FILE_NAME);
+
+            CHECK_THROWS_WITH((void) pack.image(3), "PackFile: index out of bounds 3");
+            CHECK_THROWS_WITH((void) pack.name(3), "PackFile: index out of bounds 3");
+        }
+
+        std::remove(FILE_NAME.c_str());
+    }
+
+    TEST_CASE("pack file should throw exception on wrong header") {
+        PackFile::write(FILE_NAME, exampleEntries());
+
+        SUBCASE("magic") {
+            patch(0, {'X'});
+            CHECK_THROWS_WITH(PackFile{FILE_NAME}, "PackFile: not a pack file");
+        }
+
+        SUBCASE("version") {
+            patch(4, {2});
+            CHECK_THROWS_WITH(PackFile{FILE_NAME}, "PackFile: unsupported version 2");
+        }
+
+        SUBCASE("image size") {
+            patch(5, {32});
+            CHECK_THROWS_WITH(PackFile{FILE_NAME}, "PackFile: unsupported image size 32");
+        }
+
+        SUBCASE("count larger than the file") {
+            patch(8, {0, 0, 1});
+            CHECK_THROWS_WITH(PackFile{FILE_NAME}, "PackFile: wrong size");
+        }
+
+        SUBCASE("too short") {
+            std::ofstream(FILE_NAME, std::ios::binary) << "8BPK";
+            CHECK_THROWS_WITH(PackFile{FILE_NAME}, "PackFile: not a pack file");
+        }
+
+        std::remove(FILE_NAME.c_str());
+    }
+
+    TEST_CASE("verifyChecksum() should throw exception on corrupt images") {
+        PackFile::write(FILE_NAME, exampleEntries());
+        patch(16 + 20, {0x99});
+
+        {
+            const PackFile pack(FILE_NAME);
+            CHECK_EQ(pack.image(1)[4], 0x99);
+            CHECK_THROWS_WITH(pack.verifyChecksum(), "PackFile: checksum mismatch");
+        }
+
+        std::remove(FILE_NAME.c_str());
+    }
+
+    TEST_CASE("pack file should throw exception if file does not exist") {
+        CHECK_THROWS_WITH(PackFile{"does_not_exist.8bpk"}, "PackFile: failed to open file: does_not_exist.8bpk");
+    }
+}
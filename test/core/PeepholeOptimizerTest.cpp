@@ -0,0 +1,177 @@
+#include <doctest.h>
+
+#include <iostream> // Due to bug with doctest on macOS in release mode: https://github.com/onqtam/doctest/issues/126
+#include <random>
+
+#include "core/Assembler.h"
+#include "core/Instructions.h"
+#include "core/Interpreter.h"
+#include "core/PeepholeOptimizer.h"
+
+using namespace Core;
+
+static MemoryImage assemble(const std::vector<std::string> &lines) {
+    return Assembler::toImage(Assembler().interpret(lines));
+}
+
+/** Runs for a number of cycles on the interpreter, and collects the output. */
+static std::vector<uint8_t> run(const MemoryImage &image, const unsigned long maxCycles, unsigned long &cycles,
+                                Interpreter::State &state) {
+    std::vector<uint8_t> outputs;
+    state = Interpreter::initialState(image);
+    cycles = 0;
+
+    while (!state.halted && !state.failed && cycles < maxCycles) {
+        const bool output = state.memory[state.programCounter] >> 4 == Instructions::OUT.opcode;
+        cycles += Interpreter::step(state);
+
+        if (output) {
+            outputs.push_back(state.outputRegister);
+        }
+    }
+
+    return outputs;
+}
+
+TEST_SUITE("PeepholeOptimizerTest") {
+    TEST_CASE("optimize() should skip a run of NOP") {
+        const PeepholeOptimizer::Result result = PeepholeOptimizer::optimize(
+                assemble({"LDI 10", "NOP", "NOP", "NOP", "OUT", "HLT"}));
+
+        REQUIRE_EQ(result.rewrites.size(), 1);
+        CHECK_EQ(result.rewrites[0].address, 1);
+        CHECK_EQ(result.rewrites[0].before, 0x00);
+        CHECK_EQ(result.rewrites[0].after, 0x64);
+        CHECK_EQ(result.rewrites[0].savedCycles, 10);
+        CHECK_EQ(PeepholeOptimizer::describe(result.rewrites[0]),
+                 "1: NOP -> JMP 4 (saves 10 cycles, skips 3 instructions that do nothing)");
+        CHECK_EQ(result.image, assemble({"LDI 10", "JMP 4", "NOP", "NOP", "OUT", "HLT"}));
+    }
+
+    TEST_CASE("optimize() should leave a single instruction that does nothing, since a jump is just as slow") {
+        const MemoryImage image = assemble({"LDI 10", "NOP", "OUT", "JMP 4", "HLT"});
+
+        const PeepholeOptimizer::Result result = PeepholeOptimizer::optimize(image);
+
+        CHECK(result.rewrites.empty());
+        CHECK_EQ(result.image, image);
+    }
+
+    TEST_CASE("optimize() should skip loading the value that was just stored, and jumps to the next address") {
+        const PeepholeOptimizer::Result result = PeepholeOptimizer::optimize(
+                assemble({"LDI 7", "STA 15", "LDA 15", "JZ 4", "OUT", "HLT"}));
+
+        REQUIRE_EQ(result.rewrites.size(), 1);
+        CHECK_EQ(result.rewrites[0].address, 2);
+        CHECK_EQ(result.image[2], 0x64);
+    }
+
+    TEST_CASE("optimize() should not skip loading when something else jumps there") {
+        const MemoryImage image = assemble({"LDI 7", "STA 15", "LDA 15", "NOP", "OUT", "JMP 2"});
+
+        CHECK(PeepholeOptimizer::optimize(image).rewrites.empty());
+    }
+
+    TEST_CASE("optimize() should jump straight past other jumps") {
+        const PeepholeOptimizer::Result result = PeepholeOptimizer::optimize(
+                assemble({"LDI 1", "JZ 3", "JMP 4", "JMP 2", "OUT", "HLT"}));
+
+        REQUIRE_EQ(result.rewrites.size(), 2);
+        CHECK_EQ(result.rewrites[0].address, 1);
+        CHECK_EQ(result.rewrites[0].savedCycles, 10);
+        CHECK_EQ(result.image[1], 0x84);
+        CHECK_EQ(result.rewrites[1].address, 3);
+        CHECK_EQ(result.rewrites[1].savedCycles, 5);
+        CHECK_EQ(result.image[3], 0x64);
+    }
+
+    TEST_CASE("optimize() should leave loops of jumps alone") {
+        const MemoryImage image = assemble({"JMP 1", "JMP 0"});
+
+        CHECK(PeepholeOptimizer::optimize(image).rewrites.empty());
+    }
+
+    TEST_CASE("optimize() should load constants that fit in 4 bits directly") {
+        const PeepholeOptimizer::Result result = PeepholeOptimizer::optimize(
+                assemble({"LDA 14", "OUT", "LDA 15", "OUT", "HLT", "ORG 14", "DB 9", "DB 16"}));
+
+        REQUIRE_EQ(result.rewrites.size(), 1);
+        CHECK_EQ(result.rewrites[0].savedCycles, 0);
+        CHECK_EQ(result.image[0], 0x59);
+        CHECK_EQ(result.image[2], 0x1F);
+    }
+
+    TEST_CASE("optimize() should not change bytes that are read as data") {
+        // NOP at 2 and 3 are also the data 0 for ADD
+        const MemoryImage image = assemble({"ADD 2", "OUT", "NOP", "NOP", "ADD 3", "HLT"});
+
+        CHECK(PeepholeOptimizer::optimize(image).rewrites.empty());
+    }
+
+    TEST_CASE("optimize() should leave programs that store into their own code alone") {
+        const MemoryImage image = assemble({"LDI 0", "STA 3", "NOP", "NOP", "NOP", "OUT", "HLT"});
+
+        CHECK(PeepholeOptimizer::optimize(image).rewrites.empty());
+    }
+
+    TEST_CASE("optimize() should not change the output of random programs, only make them faster") {
+        std::mt19937_64 random(42);
+        unsigned long optimizedPrograms = 0;
+
+        for (int i = 0; i < 20000; i++) {
+            MemoryImage image{};
+
+            // Many NOP and jumps, to get more to optimize
+            for (uint8_t &value : image) {
+                const int kind = random() % 4;
+                value = kind == 0 ? 0 : kind == 1 ? 0x60 | (random() % 16) : random() % 256;
+            }
+
+            const PeepholeOptimizer::Result result = PeepholeOptimizer::optimize(image);
+
+            if (result.rewrites.empty()) {
+                continue;
+            }
+
+            optimizedPrograms++;
+
+            unsigned long originalCycles;
+            unsigned long optimizedCycles;
+            Interpreter::State originalState;
+            Interpreter::State optimizedState;
+            const std::vector<uint8_t> originalOutputs = run(image, 500, originalCycles, originalState);
+            const std::vector<uint8_t> optimizedOutputs = run(result.image, 500, optimizedCycles, optimizedState);
+
+            // Within the same number of cycles, the faster program has come at least as far
+            REQUIRE_LE(originalOutputs.size(), optimizedOutputs.size());
+            REQUIRE(std::equal(originalOutputs.begin(), originalOutputs.end(), optimizedOutputs.begin()));
+
+            if (originalState.halted || originalState.failed) {
+                REQUIRE_EQ(originalOutputs, optimizedOutputs);
+                REQUIRE_EQ(originalState.halted, optimizedState.halted);
+                REQUIRE_EQ(originalState.aRegister, optimizedState.aRegister);
+                REQUIRE_LE(optimizedCycles, originalCycles);
+            }
+        }
+
+        CHECK_GT(optimizedPrograms, 1000);
+    }
+
+    TEST_CASE("assembler should only optimize when asked to") {
+        Assembler assembler;
+        const std::vector<std::string> lines = {"LDI 10", "NOP", "NOP", "OUT", "HLT"};
+
+        CHECK_EQ(Assembler::toImage(assembler.interpret(lines))[1], 0x00);
+        CHECK(assembler.getRewrites().empty());
+
+        assembler.setOptimize(true);
+
+        CHECK_EQ(Assembler::toImage(assembler.interpret(lines))[1], 0x63);
+        CHECK_EQ(assembler.getRewrites().size(), 1);
+
+        const Assembler::Result result = assembler.assemble("LDI 10\nNOP\nNOP\nOUT\nHLT\n");
+
+        CHECK_EQ(result.image[1], 0x63);
+        CHECK_EQ(result.instructions[1].opcode, Instructions::JMP.opcodeAsBitset());
+    }
+}
@@ -52,25 +52,75 @@ TEST_SUITE("RandomAccessMemoryTest") {
         }
 
         SUBCASE("program should notify observer of programmed value") {
-            fakeit::Mock<ValueObserver> observerMock;
-            auto observerPtr = std::shared_ptr<ValueObserver>(&observerMock(), [](...) {});
+            fakeit::Mock<RandomAccessMemoryObserver> observerMock;
+            auto observerPtr = std::shared_ptr<RandomAccessMemoryObserver>(&observerMock(), [](...) {});
             ram.setObserver(observerPtr);
             fakeit::When(Method(observerMock, valueUpdated)).AlwaysReturn();
 
             ram.program(std::bitset<4>("1111"), std::bitset<4>("1110"));
 
-            fakeit::Verify(Method(observerMock, valueUpdated).Using(254)).Once();
+            fakeit::Verify(Method(observerMock, valueUpdated).Using(0, 254)).Once();
             fakeit::VerifyNoOtherInvocations(observerMock);
         }
 
+        SUBCASE("program() with an image should set all of memory and notify observer of all of it") {
+            fakeit::Mock<RandomAccessMemoryObserver> observerMock;
+            auto observerPtr = std::shared_ptr<RandomAccessMemoryObserver>(&observerMock(), [](...) {});
+            ram.setObserver(observerPtr);
+            fakeit::When(Method(observerMock, valueUpdated)).AlwaysReturn();
+            fakeit::When(Method(observerMock, memoryUpdated)).AlwaysReturn();
+
+            MemoryImage image{};
+
+            for (int i = 0; i < RandomAccessMemory::MEMORY_SIZE; i++) {
+                image[i] = i * 3;
+            }
+
+            mar.registerValueChanged(2);
+            fakeit::Verify(Method(observerMock, valueUpdated).Using(2, 0)).Once();
+
+            ram.program(image);
+
+            // The whole image, and then the value at the current address
+            fakeit::Verify(Method(observerMock, memoryUpdated).Using(image)).Once();
+            fakeit::Verify(Method(observerMock, valueUpdated).Using(2, 6)).Once();
+            fakeit::VerifyNoOtherInvocations(observerMock);
+
+            for (int i = 0; i < RandomAccessMemory::MEMORY_SIZE; i++) {
+                mar.registerValueChanged(i);
+                ram.out();
+
+                CHECK_EQ(bus->read(), i * 3);
+            }
+        }
+
         SUBCASE("changing address should notify observer of value at new address") {
-            fakeit::Mock<ValueObserver> observerMock;
-            auto observerPtr = std::shared_ptr<ValueObserver>(&observerMock(), [](...) {});
+            fakeit::Mock<RandomAccessMemoryObserver> observerMock;
+            auto observerPtr = std::shared_ptr<RandomAccessMemoryObserver>(&observerMock(), [](...) {});
+            ram.setObserver(observerPtr);
+            fakeit::When(Method(observerMock, valueUpdated)).AlwaysReturn();
+
+            mar.registerValueChanged(1);
+            fakeit::Verify(Method(observerMock, valueUpdated).Using(1, 0)).Once();
+            fakeit::VerifyNoOtherInvocations(observerMock);
+        }
+
+        SUBCASE("changing address should notify observer when adjacent cells have the same value") {
+            mar.registerValueChanged(0);
+            ram.program(std::bitset<4>("0000"), std::bitset<4>("0101"));
+            mar.registerValueChanged(1);
+            ram.program(std::bitset<4>("0000"), std::bitset<4>("0101"));
+
+            fakeit::Mock<RandomAccessMemoryObserver> observerMock;
+            auto observerPtr = std::shared_ptr<RandomAccessMemoryObserver>(&observerMock(), [](...) {});
             ram.setObserver(observerPtr);
             fakeit::When(Method(observerMock, valueUpdated)).AlwaysReturn();
 
+            mar.registerValueChanged(0);
             mar.registerValueChanged(1);
-            fakeit::Verify(Method(observerMock, valueUpdated).Using(0)).Once();
+
+            fakeit::Verify(Method(observerMock, valueUpdated).Using(0, 5)).Once();
+            fakeit::Verify(Method(observerMock, valueUpdated).Using(1, 5)).Once();
             fakeit::VerifyNoOtherInvocations(observerMock);
         }
 
@@ -153,8 +203,8 @@ TEST_SUITE("RandomAccessMemoryTest") {
         }
 
         SUBCASE("observer should be notified when reading from the bus") {
-            fakeit::Mock<ValueObserver> observerMock;
-            auto observerPtr = std::shared_ptr<ValueObserver>(&observerMock(), [](...) {});
+            fakeit::Mock<RandomAccessMemoryObserver> observerMock;
+            auto observerPtr = std::shared_ptr<RandomAccessMemoryObserver>(&observerMock(), [](...) {});
             ram.setObserver(observerPtr);
             fakeit::When(Method(observerMock, valueUpdated)).Return();
 
@@ -169,7 +219,7 @@ TEST_SUITE("RandomAccessMemoryTest") {
 
             bus->write(4); // Change the bus after storing the last value, otherwise it's difficult to know
 
-            fakeit::Verify(Method(observerMock, valueUpdated).Using(6)).Once();
+            fakeit::Verify(Method(observerMock, valueUpdated).Using(0, 6)).Once();
             fakeit::VerifyNoOtherInvocations(observerMock);
         }
 
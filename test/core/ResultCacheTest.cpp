@@ -0,0 +1,150 @@
+#include <doctest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iostream> // Due to bug with doctest on macOS in release mode: https://github.com/onqtam/doctest/issues/126
+
+#include "core/ResultCache.h"
+
+using namespace Core;
+
+static const std::string FILE_NAME = "result_cache_test.8brc";
+
+static ResultCache::Key keyFor(const uint8_t firstByte) {
+    ResultCache::Key key{};
+    key.image[0] = firstByte;
+    key.maxCycles = 1000;
+    key.engine = ResultCache::Engine::EMULATOR;
+
+    return key;
+}
+
+static long fileSize() {
+    std::ifstream file(FILE_NAME, std::ios::binary | std::ios::ate);
+    return file.tellg();
+}
+
+TEST_SUITE("ResultCacheTest") {
+    TEST_CASE("find() should find what was stored, with the same key only") {
+        std::remove(FILE_NAME.c_str());
+        ResultCache cache(FILE_NAME);
+
+        ResultCache::Run run{};
+        CHECK_FALSE(cache.find(keyFor(0x50), run));
+
+        cache.store(keyFor(0x50), {{1, 2, 3}, 17, true, false});
+
+        REQUIRE(cache.find(keyFor(0x50), run));
+        CHECK_EQ(run.outputs, std::vector<uint8_t>{1, 2, 3});
+        CHECK_EQ(run.cycles, 17);
+        CHECK(run.halted);
+        CHECK_FALSE(run.failed);
+
+        ResultCache::Key otherCycles = keyFor(0x50);
+        otherCycles.maxCycles = 999;
+        ResultCache::Key otherEngine = keyFor(0x50);
+        otherEngine.engine = ResultCache::Engine::INTERPRETER;
+
+        CHECK_FALSE(cache.find(keyFor(0x51), run));
+        CHECK_FALSE(cache.find(otherCycles, run));
+        CHECK_FALSE(cache.find(otherEngine, run));
+
+        const ResultCache::Statistics statistics = cache.getStatistics();
+        CHECK_EQ(statistics.hits, 1);
+        CHECK_EQ(statistics.misses, 4);
+        CHECK_EQ(statistics.stored, 1);
+        CHECK_EQ(statistics.hitRate(), doctest::Approx(0.2));
+    }
+
+    TEST_CASE("flush() should keep the results for the next time the file is opened") {
+        std::remove(FILE_NAME.c_str());
+
+        {
+            ResultCache cache(FILE_NAME);
+            cache.store(keyFor(1), {{}, 2, true, false});
+            cache.store(keyFor(2), {std::vector<uint8_t>(1000, 7), 100000, false, false});
+            cache.store(keyFor(1), {{9}, 9, false, true}); // Already there
+            cache.flush();
+            cache.store(keyFor(3), {{}, 0, false, true}); // Flushed by the destructor
+        }
+
+        ResultCache cache(FILE_NAME);
+        ResultCache::Run run{};
+
+        CHECK_EQ(cache.size(), 3);
+        REQUIRE(cache.find(keyFor(1), run));
+        CHECK_EQ(run.cycles, 2);
+        CHECK(run.outputs.empty());
+        REQUIRE(cache.find(keyFor(2), run));
+        CHECK_EQ(run.outputs, std::vector<uint8_t>(1000, 7));
+        CHECK_EQ(run.cycles, 100000);
+        REQUIRE(cache.find(keyFor(3), run));
+        CHECK(run.failed);
+
+        std::remove(FILE_NAME.c_str());
+    }
+
+    TEST_CASE("flush() should share the results between runners using the same file") {
+        std::remove(FILE_NAME.c_str());
+
+        ResultCache first(FILE_NAME);
+        ResultCache second(FILE_NAME);
+        ResultCache::Run run{};
+
+        first.store(keyFor(1), {{1}, 1, true, false});
+        first.flush();
+        second.store(keyFor(2), {{2}, 2, true, false});
+        second.flush();
+        first.store(keyFor(3), {{3}, 3, true, false});
+        first.flush();
+
+        // Each sees what the others appended before its own flush
+        CHECK(first.find(keyFor(2), run));
+        CHECK(second.find(keyFor(1), run));
+        CHECK_FALSE(second.find(keyFor(3), run));
+        CHECK_EQ(ResultCache(FILE_NAME).size(), 3);
+
+        std::remove(FILE_NAME.c_str());
+    }
+
+    TEST_CASE("flush() should overwrite a record that was cut short") {
+        std::remove(FILE_NAME.c_str());
+
+        {
+            ResultCache cache(FILE_NAME);
+            cache.store(keyFor(1), {{1}, 1, true, false});
+        }
+
+        const long validSize = fileSize();
+
+        // Like from a crash in the middle of writing
+        std::ofstream(FILE_NAME, std::ios::binary | std::ios::app) << "garbage";
+
+        {
+            ResultCache cache(FILE_NAME);
+            CHECK_EQ(cache.size(), 1);
+            cache.store(keyFor(2), {{2}, 2, true, false});
+        }
+
+        ResultCache cache(FILE_NAME);
+        ResultCache::Run run{};
+
+        CHECK_EQ(cache.size(), 2);
+        CHECK(cache.find(keyFor(2), run));
+        CHECK_EQ(fileSize(), validSize + (validSize - 8));
+
+        std::remove(FILE_NAME.c_str());
+    }
+
+    TEST_CASE("constructor should throw exception on invalid files") {
+        std::ofstream(FILE_NAME, std::ios::binary) << "8BPK1234";
+        CHECK_THROWS_WITH(ResultCache{FILE_NAME}, "ResultCache: not a result cache");
+
+        std::ofstream(FILE_NAME, std::ios::binary) << "8BRC" << '\x02' << "123";
+        CHECK_THROWS_WITH(ResultCache{FILE_NAME}, "ResultCache: unsupported version 2");
+
+        std::remove(FILE_NAME.c_str());
+
+        CHECK_THROWS_WITH(ResultCache{"does/not/exist.8brc"}, "ResultCache: failed to open file: does/not/exist.8brc");
+    }
+}
@@ -0,0 +1,86 @@
+#include <doctest.h>
+
+#include <thread>
+
+#include "core/SpscQueue.h"
+
+using namespace Core;
+
+TEST_SUITE("SpscQueueTest") {
+    TEST_CASE("SpscQueue should round the capacity up to a power of 2") {
+        CHECK_EQ(SpscQueue<int>(1).capacity(), 1);
+        CHECK_EQ(SpscQueue<int>(5).capacity(), 8);
+        CHECK_EQ(SpscQueue<int>(1024).capacity(), 1024);
+    }
+
+    TEST_CASE("push() should refuse values when full") {
+        SpscQueue<int> queue(4);
+
+        for (int i = 0; i < 4; i++) {
+            CHECK(queue.push(i));
+        }
+
+        CHECK_FALSE(queue.push(4));
+
+        int values[2];
+        CHECK_EQ(queue.pop(values, 2), 2);
+        CHECK_EQ(values[0], 0);
+        CHECK_EQ(values[1], 1);
+
+        CHECK(queue.push(4));
+        CHECK(queue.push(5));
+        CHECK_FALSE(queue.push(6));
+    }
+
+    TEST_CASE("pop() should take everything there in order") {
+        SpscQueue<int> queue(8);
+        int values[8];
+
+        CHECK_EQ(queue.pop(values, 8), 0);
+
+        for (int round = 0; round < 3; round++) {
+            for (int i = 0; i < 5; i++) {
+                queue.push(round * 5 + i);
+            }
+
+            REQUIRE_EQ(queue.pop(values, 8), 5);
+
+            for (int i = 0; i < 5; i++) {
+                CHECK_EQ(values[i], round * 5 + i);
+            }
+        }
+    }
+
+    TEST_CASE("SpscQueue should pass every value from one thread to another in order") {
+        SpscQueue<unsigned long> queue(64);
+        const unsigned long total = 100000;
+        bool inOrder = true;
+
+        std::thread reader([&queue, &inOrder] {
+            unsigned long values[16];
+            unsigned long expected = 0;
+
+            while (expected < total) {
+                const size_t count = queue.pop(values, 16);
+
+                if (count == 0) {
+                    std::this_thread::yield();
+                }
+
+                for (size_t i = 0; i < count; i++) {
+                    inOrder = inOrder && values[i] == expected++;
+                }
+            }
+        });
+
+        for (unsigned long i = 0; i < total; i++) {
+            while (!queue.push(i)) {
+                std::this_thread::yield();
+            }
+        }
+
+        reader.join();
+
+        CHECK(inOrder);
+    }
+}
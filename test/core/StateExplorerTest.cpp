@@ -0,0 +1,98 @@
+#include <doctest.h>
+
+#include <iostream> // Due to bug with doctest on macOS in release mode: https://github.com/onqtam/doctest/issues/126
+
+#include "core/Assembler.h"
+#include "core/StateExplorer.h"
+
+using namespace Core;
+
+static std::vector<Assembler::Instruction> assemble(const std::string &fileName) {
+    Assembler assembler;
+    return assembler.loadInstructions(fileName);
+}
+
+TEST_SUITE("StateExplorerTest") {
+    TEST_CASE("explore() should find all states of a program without inputs") {
+        StateExplorer explorer(assemble("../../programs/nop_test.asm"), {});
+
+        const StateExplorer::Report report = explorer.explore(1000, 2);
+
+        // The start, and after each of the 6 instructions
+        CHECK_EQ(report.states, 7);
+        CHECK_EQ(report.haltingStates, 1);
+        CHECK_EQ(report.failingStates, 0);
+        CHECK_EQ(report.longestRun, 6);
+        CHECK(report.complete);
+        CHECK(report.deadCode.empty());
+        CHECK_EQ(report.outputs, std::vector<uint8_t>{10});
+    }
+
+    TEST_CASE("explore() should find all states over all the values of an input") {
+        StateExplorer explorer(assemble("../../programs/add_two_numbers.asm"), {15});
+
+        const StateExplorer::Report report = explorer.explore(10000, 4);
+
+        CHECK_EQ(report.states, 256 * 5);
+        CHECK_EQ(report.haltingStates, 256);
+        CHECK_EQ(report.longestRun, 4);
+        CHECK(report.complete);
+        CHECK_EQ(report.outputs.size(), 256);
+    }
+
+    TEST_CASE("explore() should finish programs that never halt") {
+        StateExplorer explorer(assemble("../../programs/fibonacci.asm"), {});
+
+        const StateExplorer::Report report = explorer.explore(10000, 4);
+
+        CHECK_EQ(report.haltingStates, 0);
+        CHECK(report.complete);
+        CHECK_EQ(report.outputs, std::vector<uint8_t>{0, 1, 2, 3, 5, 8, 13, 21, 34, 55, 89, 144, 233});
+    }
+
+    TEST_CASE("explore() should find dead code") {
+        StateExplorer explorer(assemble("../../programs/test/dead_code_test.asm"), {});
+
+        const StateExplorer::Report report = explorer.explore(1000, 1);
+
+        CHECK_EQ(report.deadCode, std::vector<uint8_t>{3, 4});
+    }
+
+    TEST_CASE("explore() should find failing states") {
+        StateExplorer explorer(assemble("../../programs/nop_test.asm"), {5});
+
+        const StateExplorer::Report report = explorer.explore(10000, 2);
+
+        // HLT is replaced by all the values, where 80 are unknown opcodes and 16 are HLT
+        CHECK_EQ(report.failingStates, 80);
+        CHECK_EQ(report.haltingStates, 16);
+        CHECK(report.complete);
+    }
+
+    TEST_CASE("explore() should stop when the states do not fit") {
+        StateExplorer explorer(assemble("../../programs/add_two_numbers.asm"), {15});
+
+        const StateExplorer::Report report = explorer.explore(300, 2);
+
+        CHECK_FALSE(report.complete);
+        CHECK_EQ(report.states, 300);
+    }
+
+    TEST_CASE("constructor should throw exception on too many addresses") {
+        CHECK_THROWS_WITH(StateExplorer(assemble("../../programs/nop_test.asm"), {13, 14, 15}),
+                          "StateExplorer: number of addresses must be from 0 to 2");
+    }
+
+    TEST_CASE("encode() should pack the flags together with the program counter") {
+        Interpreter::State state;
+        state.programCounter = 5;
+        state.carryFlag = true;
+        state.halted = true;
+        state.outputRegister = 7;
+
+        const ConcurrentStateSet::Key key = StateExplorer::encode(state);
+
+        CHECK_EQ(key[18], 0b01010101);
+        CHECK_EQ(key[19], 7);
+    }
+}
@@ -83,6 +83,22 @@ TEST_SUITE("StepCounterTest") {
             fakeit::VerifyNoOtherInvocations(stepListenerMock);
         }
 
+        SUBCASE("setState() should restore the step without notifying listener") {
+            clock.invertedClockTicked();
+            clock.invertedClockTicked();
+            const StepCounter::State state = stepCounter.getState();
+            CHECK_EQ(state.counter, 2);
+
+            stepCounter.reset();
+            stepCounter.setState(state);
+
+            fakeit::Verify(Method(stepListenerMock, stepReady).Using(2)).Once();
+
+            // Continues from the restored step
+            clock.invertedClockTicked();
+            fakeit::Verify(Method(stepListenerMock, stepReady).Using(3)).Once();
+        }
+
         SUBCASE("print() should not fail") {
             stepCounter.print();
         }
@@ -0,0 +1,96 @@
+#include <doctest.h>
+
+#include <iostream> // Due to bug with doctest on macOS in release mode: https://github.com/onqtam/doctest/issues/126
+
+#include "core/Superoptimizer.h"
+
+using namespace Core;
+
+TEST_SUITE("SuperoptimizerTest") {
+    TEST_CASE("search() should find HLT when there is nothing to output") {
+        Superoptimizer superoptimizer({}, Superoptimizer::Goal::SIZE, 1000);
+
+        const Superoptimizer::Solution solution = superoptimizer.search(4, 2);
+
+        REQUIRE(solution.found);
+        CHECK_EQ(solution.size, 1);
+        CHECK_EQ(solution.cycles, 2);
+        CHECK_EQ(superoptimizer.toAssembly(solution), "HLT\n");
+    }
+
+    TEST_CASE("search() should use the initial value of the A-register for 0") {
+        Superoptimizer superoptimizer({0}, Superoptimizer::Goal::SIZE, 1000);
+
+        const Superoptimizer::Solution solution = superoptimizer.search(4, 2);
+
+        REQUIRE(solution.found);
+        CHECK_EQ(solution.size, 2);
+        CHECK_EQ(solution.cycles, 7);
+        CHECK_EQ(superoptimizer.toAssembly(solution), "OUT\nHLT\n");
+    }
+
+    TEST_CASE("search() should find the same program with any number of threads") {
+        for (const unsigned int threads : {1u, 3u, 8u}) {
+            Superoptimizer superoptimizer({0, 0}, Superoptimizer::Goal::SIZE, 100);
+
+            const Superoptimizer::Solution solution = superoptimizer.search(4, threads);
+
+            REQUIRE(solution.found);
+            CHECK_EQ(solution.size, 3);
+            CHECK_EQ(solution.cycles, 12);
+            CHECK_EQ(superoptimizer.toAssembly(solution), "OUT\nOUT\nHLT\n");
+        }
+    }
+
+    TEST_CASE("search() should find the smallest program for a single value, using the program itself as data") {
+        Superoptimizer superoptimizer({10}, Superoptimizer::Goal::SIZE, 100);
+
+        const Superoptimizer::Solution solution = superoptimizer.search(4, 4);
+
+        // 0 - 246 = 10, and any value from 240 to 255 is HLT
+        REQUIRE(solution.found);
+        CHECK_EQ(solution.size, 3);
+        CHECK_EQ(solution.cycles, 12);
+        CHECK_EQ(superoptimizer.toAssembly(solution), "SUB 2\nOUT\nDB 246 ; HLT\n");
+
+        const Superoptimizer::Statistics statistics = superoptimizer.getStatistics();
+        CHECK_GT(statistics.candidates, 0);
+    }
+
+    TEST_CASE("toAssembly() should turn bytes that are only read into DB") {
+        Superoptimizer superoptimizer({200}, Superoptimizer::Goal::SIZE, 1000);
+
+        Superoptimizer::Solution solution;
+        solution.found = true;
+        solution.memory = {0x13, 0xE0, 0xF0, 200};
+        solution.size = 4;
+        solution.cycles = 12;
+
+        CHECK_EQ(superoptimizer.toAssembly(solution), "LDA 3\nOUT\nHLT\nDB 200\n");
+    }
+
+    TEST_CASE("search() should prefer fewer cycles when the goal is cycles") {
+        Superoptimizer superoptimizer({10}, Superoptimizer::Goal::CYCLES, 100);
+
+        const Superoptimizer::Solution solution = superoptimizer.search(3, 4);
+
+        REQUIRE(solution.found);
+        CHECK_EQ(solution.cycles, 12);
+        CHECK_EQ(solution.size, 3);
+    }
+
+    TEST_CASE("search() should not find anything when the program would be too large") {
+        Superoptimizer superoptimizer({1, 2, 3}, Superoptimizer::Goal::SIZE, 100);
+
+        const Superoptimizer::Solution solution = superoptimizer.search(3, 2);
+
+        CHECK_FALSE(solution.found);
+    }
+
+    TEST_CASE("search() should throw exception on invalid size") {
+        Superoptimizer superoptimizer({1}, Superoptimizer::Goal::SIZE, 1000);
+
+        CHECK_THROWS_WITH(superoptimizer.search(0, 1), "Superoptimizer: size must be from 1 to 16");
+        CHECK_THROWS_WITH(superoptimizer.search(17, 1), "Superoptimizer: size must be from 1 to 16");
+    }
+}
@@ -0,0 +1,155 @@
+#include <doctest.h>
+#include <cstdio>
+#include <sstream>
+
+#include "core/Assembler.h"
+#include "core/SweepRunner.h"
+
+using namespace Core;
+
+static std::vector<Assembler::Instruction> assemble(const std::string &fileName) {
+    Assembler assembler;
+    return assembler.loadInstructions(fileName);
+}
+
+TEST_SUITE("SweepRunnerTest") {
+    TEST_CASE("sweep should run all combinations of one address") {
+        SweepRunner runner(assemble("../../programs/add_two_numbers.asm"), {15});
+
+        CHECK_EQ(runner.combinations(), 256);
+
+        const std::vector<SweepRunner::Result> &results = runner.run(1000, 4);
+
+        REQUIRE_EQ(results.size(), 256);
+
+        for (int i = 0; i < 256; i++) {
+            const SweepRunner::Result &result = results[i];
+
+            CHECK_EQ(result.inputs, std::vector<uint8_t>{(uint8_t) i});
+            CHECK_EQ(result.outputs, std::vector<uint8_t>{(uint8_t) (28 + i)});
+            CHECK_EQ(result.cycles, 17);
+            CHECK(result.halted);
+            CHECK_FALSE(result.failed);
+        }
+    }
+
+    TEST_CASE("sweep should run all combinations of two addresses") {
+        SweepRunner runner(assemble("../../programs/subtract_two_numbers.asm"), {14, 15});
+
+        CHECK_EQ(runner.combinations(), 65536);
+
+        const std::vector<SweepRunner::Result> &results = runner.run(1000, 4);
+
+        REQUIRE_EQ(results.size(), 65536);
+
+        // Value at the last address counts fastest
+        CHECK_EQ(results[1].inputs, std::vector<uint8_t>{0, 1});
+        CHECK_EQ(results[256].inputs, std::vector<uint8_t>{1, 0});
+
+        CHECK_EQ(results[30 * 256 + 12].outputs, std::vector<uint8_t>{18});
+        CHECK_EQ(results[0 * 256 + 1].outputs, std::vector<uint8_t>{255});
+        CHECK_EQ(results[255 * 256 + 255].outputs, std::vector<uint8_t>{0});
+    }
+
+    TEST_CASE("sweep should add addresses that are not defined by the program") {
+        SweepRunner runner(assemble("../../programs/nop_test.asm"), {10});
+
+        const std::vector<SweepRunner::Result> &results = runner.run(1000, 2);
+
+        CHECK_EQ(results[200].outputs, std::vector<uint8_t>{10});
+    }
+
+    TEST_CASE("sweep should stop runs that do not halt") {
+        SweepRunner runner(assemble("../../programs/count_0_255.asm"), {15});
+
+        const std::vector<SweepRunner::Result> &results = runner.run(50, 2);
+
+        CHECK_EQ(results[1].cycles, 50);
+        CHECK_FALSE(results[1].halted);
+        CHECK_FALSE(results[1].failed);
+        CHECK_EQ(results[1].outputs, std::vector<uint8_t>{0, 1, 2});
+    }
+
+    TEST_CASE("sweep should mark runs that fail") {
+        // Replaces HLT at the end of the program
+        SweepRunner runner(assemble("../../programs/nop_test.asm"), {5});
+
+        const std::vector<SweepRunner::Result> &results = runner.run(1000, 2);
+
+        // Unknown opcode 1001
+        CHECK(results[0x90].failed);
+        CHECK_FALSE(results[0x90].halted);
+
+        // HLT
+        CHECK_FALSE(results[0xF0].failed);
+        CHECK(results[0xF0].halted);
+
+        // NOP, and the rest of the memory is NOP too
+        CHECK_FALSE(results[0x00].failed);
+        CHECK_FALSE(results[0x00].halted);
+    }
+
+    TEST_CASE("sweep should throw exception on invalid addresses") {
+        CHECK_THROWS_WITH(SweepRunner(assemble("../../programs/nop_test.asm"), {}),
+                          "SweepRunner: number of addresses must be from 1 to 3");
+        CHECK_THROWS_WITH(SweepRunner(assemble("../../programs/nop_test.asm"), {1, 2, 3, 4}),
+                          "SweepRunner: number of addresses must be from 1 to 3");
+        CHECK_THROWS_WITH(SweepRunner(assemble("../../programs/nop_test.asm"), {16}),
+                          "SweepRunner: address out of bounds 16");
+    }
+
+    TEST_CASE("printTable() should write one line per combination") {
+        SweepRunner runner(assemble("../../programs/add_two_numbers.asm"), {15});
+        std::stringstream stream;
+
+        runner.printTable(stream, runner.run(1000, 1));
+
+        std::string line;
+
+        std::getline(stream, line);
+        CHECK_EQ(line, "m15\tcycles\tstatus\toutputs");
+
+        std::getline(stream, line);
+        CHECK_EQ(line, "0\t17\thalted\t28");
+
+        std::getline(stream, line);
+        CHECK_EQ(line, "1\t17\thalted\t29");
+    }
+
+    TEST_CASE("sweep should use the results in the cache, and store the rest") {
+        const std::string fileName = "sweep_runner_test.8brc";
+        std::remove(fileName.c_str());
+
+        SweepRunner runner(assemble("../../programs/add_two_numbers.asm"), {15});
+        const std::vector<SweepRunner::Result> uncached = runner.run(1000, 4);
+
+        auto cache = std::make_shared<ResultCache>(fileName);
+        runner.setCache(cache);
+
+        const std::vector<SweepRunner::Result> first = runner.run(1000, 4);
+        CHECK_EQ(cache->getStatistics().misses, 256);
+        CHECK_EQ(cache->getStatistics().stored, 256);
+
+        const std::vector<SweepRunner::Result> second = runner.run(1000, 4);
+        CHECK_EQ(cache->getStatistics().hits, 256);
+
+        // Another budget is another key
+        CHECK_EQ(runner.run(999, 4).size(), 256);
+        CHECK_EQ(cache->getStatistics().misses, 512);
+
+        for (const auto &results : {first, second}) {
+            REQUIRE_EQ(results.size(), uncached.size());
+
+            for (size_t i = 0; i < results.size(); i++) {
+                CHECK_EQ(results[i].inputs, uncached[i].inputs);
+                CHECK_EQ(results[i].outputs, uncached[i].outputs);
+                CHECK_EQ(results[i].cycles, uncached[i].cycles);
+                CHECK_EQ(results[i].halted, uncached[i].halted);
+            }
+        }
+
+        cache.reset();
+        CHECK_EQ(ResultCache(fileName).size(), 512);
+        std::remove(fileName.c_str());
+    }
+}
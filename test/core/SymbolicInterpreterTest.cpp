@@ -0,0 +1,234 @@
+#include <doctest.h>
+
+#include <iostream> // Due to bug with doctest on macOS in release mode: https://github.com/onqtam/doctest/issues/126
+
+#include "core/Assembler.h"
+#include "core/Instructions.h"
+#include "core/Interpreter.h"
+#include "core/SymbolicInterpreter.h"
+
+using namespace Core;
+
+static MemoryImage imageWith(const std::vector<uint8_t> &bytes) {
+    MemoryImage image{};
+    std::copy(bytes.begin(), bytes.end(), image.begin());
+
+    return image;
+}
+
+static MemoryImage loadImage(const std::string &fileName) {
+    Assembler assembler;
+
+    return Assembler::toImage(assembler.loadInstructions(fileName));
+}
+
+static SymbolicInterpreter::Expression symbol(const uint8_t address) {
+    SymbolicInterpreter::Expression expression;
+    expression.coefficients[address] = 1;
+
+    return expression;
+}
+
+static SymbolicInterpreter::Expression constant(const uint8_t value) {
+    SymbolicInterpreter::Expression expression;
+    expression.constant = value;
+
+    return expression;
+}
+
+/** Runs the example on the interpreter, and checks that it does what the path says. */
+static void checkExample(const SymbolicInterpreter::Path &path) {
+    Interpreter::State state = Interpreter::initialState(path.example);
+    std::vector<uint8_t> outputs;
+    unsigned long cycles = 0;
+
+    while (!state.halted && !state.failed) {
+        const bool output = state.memory[state.programCounter] >> 4 == Instructions::OUT.opcode;
+        cycles += Interpreter::step(state);
+
+        if (output) {
+            outputs.push_back(state.outputRegister);
+        }
+    }
+
+    std::vector<uint8_t> expectedOutputs;
+
+    for (const auto &expression : path.outputs) {
+        expectedOutputs.push_back(SymbolicInterpreter::evaluate(expression, path.example));
+    }
+
+    for (const auto &condition : path.conditions) {
+        CHECK(SymbolicInterpreter::evaluate(condition, path.example));
+    }
+
+    CHECK(state.halted);
+    CHECK_EQ(cycles, path.cycles);
+    CHECK_EQ(outputs, expectedOutputs);
+}
+
+TEST_SUITE("SymbolicInterpreterTest") {
+    TEST_CASE("run() should find a single path through a straight program") {
+        const MemoryImage image = loadImage("../../programs/add_two_numbers.asm");
+        SymbolicInterpreter interpreter(image, {14, 15}, 1000, 100);
+
+        const SymbolicInterpreter::Result result = interpreter.run();
+
+        REQUIRE_EQ(result.paths.size(), 1);
+        CHECK(result.complete);
+
+        const SymbolicInterpreter::Path &path = result.paths[0];
+        CHECK(path.conditions.empty());
+        REQUIRE_EQ(path.outputs.size(), 1);
+        CHECK_EQ(SymbolicInterpreter::toString(path.outputs[0]), "x14 + x15");
+        CHECK_EQ(path.cycles, 17);
+        CHECK_EQ(path.end, SymbolicInterpreter::End::HALTED);
+        CHECK(path.solved);
+        CHECK_EQ(path.example, image);
+    }
+
+    TEST_CASE("run() should find a path for each number of loop iterations, with examples that take them") {
+        const MemoryImage image = loadImage("../../programs/multiply_two_numbers.asm");
+        SymbolicInterpreter interpreter(image, {14, 15}, 100000, 1000);
+
+        const SymbolicInterpreter::Result result = interpreter.run();
+
+        CHECK(result.complete);
+        REQUIRE_EQ(result.paths.size(), 256);
+
+        for (const auto &path : result.paths) {
+            REQUIRE(path.solved);
+            checkExample(path);
+        }
+
+        // Counting down from x14 to 0, adding x15 every time
+        CHECK_EQ(SymbolicInterpreter::toString(result.paths[0].outputs[0]), "0");
+        CHECK_EQ(SymbolicInterpreter::toString(result.paths[1].outputs[0]), "x15");
+        CHECK_EQ(SymbolicInterpreter::toString(result.paths[2].outputs[0]), "2*x15");
+        CHECK_GT(interpreter.getStatistics().solverChecks, 0);
+    }
+
+    TEST_CASE("run() should cover every input with exactly one path") {
+        // LDA 14, SUB 15, JC 5, LDA 15, JMP 6, LDA 14, OUT, HLT
+        const MemoryImage image = imageWith({0x1E, 0x3F, 0x75, 0x1F, 0x66, 0x1E, 0xE0, 0xF0});
+        SymbolicInterpreter interpreter(image, {14, 15}, 1000, 100);
+
+        const SymbolicInterpreter::Result result = interpreter.run();
+
+        REQUIRE_EQ(result.paths.size(), 2);
+        CHECK_EQ(SymbolicInterpreter::toString(result.paths[0].conditions[0]), "x14 - x15 does not carry");
+        CHECK_EQ(SymbolicInterpreter::toString(result.paths[1].conditions[0]), "x14 - x15 carries");
+
+        for (int x14 = 0; x14 < 256; x14++) {
+            for (int x15 = 0; x15 < 256; x15++) {
+                MemoryImage input = image;
+                input[14] = x14;
+                input[15] = x15;
+
+                int matches = 0;
+
+                for (const auto &path : result.paths) {
+                    bool holds = true;
+
+                    for (const auto &condition : path.conditions) {
+                        holds = holds && SymbolicInterpreter::evaluate(condition, input);
+                    }
+
+                    if (holds) {
+                        matches++;
+                        const uint8_t expected = x15 != 0 && x14 >= x15 ? x14 : x15;
+                        REQUIRE_EQ(SymbolicInterpreter::evaluate(path.outputs[0], input), expected);
+                    }
+                }
+
+                REQUIRE_EQ(matches, 1);
+            }
+        }
+    }
+
+    TEST_CASE("run() should not split on flags that do not depend on the symbols") {
+        const MemoryImage image = loadImage("../../programs/count_0_255_stop.asm");
+        SymbolicInterpreter interpreter(image, {}, 100000, 100);
+
+        const SymbolicInterpreter::Result result = interpreter.run();
+
+        REQUIRE_EQ(result.paths.size(), 1);
+        CHECK(result.paths[0].conditions.empty());
+        CHECK_EQ(result.paths[0].outputs.size(), 256);
+        checkExample(result.paths[0]);
+    }
+
+    TEST_CASE("run() should stop paths that can not be followed") {
+        SUBCASE("Symbolic code") {
+            SymbolicInterpreter interpreter(imageWith({0x00, 0xF0}), {1}, 1000, 100);
+            const SymbolicInterpreter::Result result = interpreter.run();
+
+            REQUIRE_EQ(result.paths.size(), 1);
+            CHECK_EQ(result.paths[0].end, SymbolicInterpreter::End::SYMBOLIC_CODE);
+            CHECK_EQ(result.paths[0].cycles, 5);
+        }
+
+        SUBCASE("Cycle limit") {
+            SymbolicInterpreter interpreter(imageWith({0x60}), {}, 100, 100);
+            const SymbolicInterpreter::Result result = interpreter.run();
+
+            REQUIRE_EQ(result.paths.size(), 1);
+            CHECK_EQ(result.paths[0].end, SymbolicInterpreter::End::CYCLE_LIMIT);
+            CHECK_EQ(result.paths[0].cycles, 100);
+        }
+
+        SUBCASE("Unknown opcode") {
+            SymbolicInterpreter interpreter(imageWith({0x90}), {}, 100, 100);
+            const SymbolicInterpreter::Result result = interpreter.run();
+
+            REQUIRE_EQ(result.paths.size(), 1);
+            CHECK_EQ(result.paths[0].end, SymbolicInterpreter::End::FAILED);
+            CHECK_EQ(result.paths[0].cycles, 2);
+        }
+
+        SUBCASE("Maximum number of paths") {
+            SymbolicInterpreter interpreter(loadImage("../../programs/multiply_two_numbers.asm"), {14}, 100000, 10);
+            const SymbolicInterpreter::Result result = interpreter.run();
+
+            CHECK_EQ(result.paths.size(), 10);
+            CHECK_FALSE(result.complete);
+        }
+    }
+
+    TEST_CASE("solve() should find values that satisfy the conditions, or prove there are none") {
+        SymbolicInterpreter interpreter(MemoryImage{}, {14, 15}, 1000, 100);
+        MemoryImage example{};
+
+        // Adding 0 never carries
+        const SymbolicInterpreter::Condition never = {symbol(14), constant(0), false,
+                                                       SymbolicInterpreter::Flag::CARRY, true};
+        CHECK_EQ(interpreter.solve({never}, example), SymbolicInterpreter::Satisfiability::UNSATISFIABLE);
+
+        // x14 = x15, and x14 + 1 carries, only for 255
+        const SymbolicInterpreter::Condition equal = {symbol(14), symbol(15), true,
+                                                       SymbolicInterpreter::Flag::ZERO, true};
+        const SymbolicInterpreter::Condition carries = {symbol(14), constant(1), false,
+                                                         SymbolicInterpreter::Flag::CARRY, true};
+        CHECK_EQ(interpreter.solve({equal, carries}, example), SymbolicInterpreter::Satisfiability::SATISFIABLE);
+        CHECK_EQ(example[14], 255);
+        CHECK_EQ(example[15], 255);
+    }
+
+    TEST_CASE("toString() should write expressions with subtraction for large coefficients") {
+        SymbolicInterpreter::Expression expression;
+        expression.constant = 253;
+        expression.coefficients[3] = 2;
+        expression.coefficients[9] = 255;
+
+        CHECK_EQ(SymbolicInterpreter::toString(expression), "2*x3 - x9 - 3");
+        CHECK_EQ(SymbolicInterpreter::toString(constant(200)), "200");
+
+        const SymbolicInterpreter::Condition condition = {expression, symbol(1), false,
+                                                           SymbolicInterpreter::Flag::CARRY, false};
+        CHECK_EQ(SymbolicInterpreter::toString(condition), "(2*x3 - x9 - 3) + x1 does not carry");
+    }
+
+    TEST_CASE("SymbolicInterpreter() should throw exception on symbol address out of range") {
+        CHECK_THROWS_WITH(SymbolicInterpreter(MemoryImage{}, {16}, 1000, 100),
+                          "SymbolicInterpreter: symbol address out of range: 16");
+    }
+}
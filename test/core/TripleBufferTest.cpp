@@ -0,0 +1,66 @@
+#include <doctest.h>
+
+#include <thread>
+
+#include "core/TripleBuffer.h"
+
+using namespace Core;
+
+TEST_SUITE("TripleBufferTest") {
+    TEST_CASE("TripleBuffer should give the reader the latest published value") {
+        TripleBuffer<int> buffer;
+
+        CHECK_EQ(buffer.read(), 0);
+
+        buffer.write() = 1;
+
+        // Not published yet
+        CHECK_EQ(buffer.read(), 0);
+
+        buffer.publish();
+        buffer.write() = 2;
+        buffer.publish();
+        buffer.write() = 3;
+
+        CHECK_EQ(buffer.read(), 2);
+        CHECK_EQ(buffer.read(), 2);
+
+        buffer.publish();
+
+        CHECK_EQ(buffer.read(), 3);
+    }
+
+    TEST_CASE("TripleBuffer should never give the reader a value that is partly from another publish") {
+        static const unsigned long PUBLISHES = 200000;
+
+        using Value = std::array<unsigned long, 16>;
+        TripleBuffer<Value> buffer;
+
+        std::thread writer([&buffer]() {
+            for (unsigned long i = 1; i <= PUBLISHES; i++) {
+                buffer.write().fill(i);
+                buffer.publish();
+            }
+        });
+
+        unsigned long last = 0;
+        bool whole = true;
+        bool ordered = true;
+
+        while (last < PUBLISHES) {
+            const Value &value = buffer.read();
+
+            for (const unsigned long part : value) {
+                whole = whole && part == value[0];
+            }
+
+            ordered = ordered && value[0] >= last;
+            last = value[0];
+        }
+
+        writer.join();
+
+        CHECK(whole);
+        CHECK(ordered);
+    }
+}
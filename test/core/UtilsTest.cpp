@@ -19,6 +19,22 @@ TEST_SUITE("UtilsTest") {
         CHECK_FALSE(Utils::startsWith("something", "something longer"));
     }
 
+    TEST_CASE("endsWith() should only return true when parameter is exact and at the end") {
+        CHECK(Utils::endsWith("program.8bim", ".8bim"));
+        CHECK(Utils::endsWith(".8bim", ".8bim"));
+        CHECK_FALSE(Utils::endsWith("program.asm", ".8bim"));
+        CHECK_FALSE(Utils::endsWith("8bim", ".8bim"));
+        CHECK_FALSE(Utils::endsWith("program.8bim.asm", ".8bim"));
+        CHECK_FALSE(Utils::endsWith("program.8bim", ""));
+    }
+
+    TEST_CASE("crc32() should give the standard check value") {
+        const std::string value = "123456789";
+
+        CHECK_EQ(Utils::crc32(reinterpret_cast<const uint8_t *>(value.data()), value.size()), 0xCBF43926);
+        CHECK_EQ(Utils::crc32(nullptr, 0), 0);
+    }
+
     TEST_CASE("isLessThan() should handle constants") {
         CHECK(Utils::isLessThan(0, 1));
         CHECK(Utils::isLessThan(0.1, 0.11));
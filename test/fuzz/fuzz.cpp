@@ -0,0 +1,500 @@
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <thread>
+
+#include "core/Assembler.h"
+#include "core/Disassembler.h"
+#include "core/Emulator.h"
+#include "core/Interpreter.h"
+#include "core/Log.h"
+#include "core/PackFile.h"
+
+/*
+ * Differential fuzzing of the emulator against the interpreter, and fuzzing of the assembler.
+ *
+ * Random memory images are run on both the emulator, one clock cycle at a time through all the parts,
+ * and the interpreter, one instruction at a time. The state is compared after every instruction.
+ * Any difference is reduced to a smaller image that still shows it, and saved as an .asm file.
+ *
+ * Images from a pack file can be run the same way, as a corpus of programs worth checking every time.
+ *
+ * Random lines of text are given to the assembler, which should either assemble them or
+ * throw a runtime_error. Anything else is saved as a text file.
+ */
+
+using namespace Core;
+
+static const unsigned long DEFAULT_ITERATIONS = 100000;
+
+/** Stop comparing programs that loop, after this many instructions. */
+static const int MAX_INSTRUCTIONS = 200;
+
+/** Keeps the last value of a register. */
+class ValueRecorder: public ValueObserver {
+
+public:
+    uint8_t value = 0;
+
+    void valueUpdated(const uint8_t newValue) override {
+        value = newValue;
+    }
+};
+
+/** Keeps a copy of the memory, from the values at each address and the whole memory when it's replaced. */
+class MemoryRecorder: public RandomAccessMemoryObserver {
+
+public:
+    MemoryImage memory{};
+
+    void valueUpdated(const uint8_t address, const uint8_t newValue) override {
+        memory[address] = newValue;
+    }
+
+    void memoryUpdated(const MemoryImage &newMemory) override {
+        memory = newMemory;
+    }
+};
+
+class FlagsRecorder: public FlagsRegisterObserver {
+
+public:
+    bool carryFlag = false;
+    bool zeroFlag = false;
+
+    void flagsUpdated(const bool newCarryFlag, const bool newZeroFlag) override {
+        carryFlag = newCarryFlag;
+        zeroFlag = newZeroFlag;
+    }
+};
+
+/** An emulator with observers for everything that the interpreter has in its state. */
+class ObservedEmulator {
+
+public:
+    Emulator emulator;
+    std::shared_ptr<ValueRecorder> aRegister = std::make_shared<ValueRecorder>();
+    std::shared_ptr<ValueRecorder> bRegister = std::make_shared<ValueRecorder>();
+    std::shared_ptr<ValueRecorder> programCounter = std::make_shared<ValueRecorder>();
+    std::shared_ptr<ValueRecorder> outputRegister = std::make_shared<ValueRecorder>();
+    std::shared_ptr<MemoryRecorder> memory = std::make_shared<MemoryRecorder>();
+    std::shared_ptr<FlagsRecorder> flags = std::make_shared<FlagsRecorder>();
+
+    ObservedEmulator() {
+        emulator.setARegisterObserver(aRegister);
+        emulator.setBRegisterObserver(bRegister);
+        emulator.setProgramCounterObserver(programCounter);
+        emulator.setOutputRegisterObserver(outputRegister);
+        emulator.setRandomAccessMemoryObserver(memory);
+        emulator.setFlagsRegisterObserver(flags);
+        emulator.setNotifyEveryWrite(true); // Writes of the same value still have to be recorded
+    }
+
+    void load(const MemoryImage &image) {
+        emulator.load(image);
+    }
+
+    /** The state as the interpreter would have it, after the last instruction. */
+    [[nodiscard]] Interpreter::State state(const bool failed) {
+        Interpreter::State state;
+        state.memory = memory->memory;
+        state.aRegister = aRegister->value;
+        state.bRegister = bRegister->value;
+        state.programCounter = programCounter->value;
+        state.outputRegister = outputRegister->value;
+        state.carryFlag = flags->carryFlag;
+        state.zeroFlag = flags->zeroFlag;
+        state.halted = emulator.isHalted();
+        state.failed = failed;
+
+        return state;
+    }
+};
+
+struct Statistics {
+    std::atomic<unsigned long> images{0};
+    std::atomic<unsigned long> instructions{0};
+    std::atomic<unsigned long> mismatches{0};
+    std::atomic<unsigned long> sources{0};
+    std::atomic<unsigned long> crashes{0};
+};
+
+static std::mutex reportMutex;
+
+static std::string describe(const Interpreter::State &state) {
+    std::string description = "A=" + std::to_string(state.aRegister) +
+                              " B=" + std::to_string(state.bRegister) +
+                              " PC=" + std::to_string(state.programCounter) +
+                              " OUT=" + std::to_string(state.outputRegister) +
+                              " C=" + std::to_string(state.carryFlag) +
+                              " Z=" + std::to_string(state.zeroFlag) +
+                              " halted=" + std::to_string(state.halted) +
+                              " failed=" + std::to_string(state.failed) + " RAM=";
+
+    for (const uint8_t value : state.memory) {
+        description += std::to_string(value) + ",";
+    }
+
+    return description;
+}
+
+/**
+ * Runs the image on both engines, and returns the number of the first instruction where they differ,
+ * or -1 if they agree. The states are returned in the last 2 parameters.
+ */
+static int compare(ObservedEmulator &observed, const MemoryImage &image, unsigned long &instructions,
+                   Interpreter::State &emulatorState, Interpreter::State &interpreterState) {
+    observed.load(image);
+    interpreterState = Interpreter::initialState(image);
+
+    for (int instruction = 0; instruction < MAX_INSTRUCTIONS; instruction++) {
+        bool failed = false;
+        unsigned long emulatorCycles = 0;
+
+        try {
+            emulatorCycles = observed.emulator.runSynchronous(Interpreter::INSTRUCTION_CYCLES);
+        } catch (const std::runtime_error &e) {
+            emulatorCycles = Interpreter::HALT_CYCLES; // The decoder fails in the third step
+            failed = true;
+        }
+
+        const unsigned long interpreterCycles = Interpreter::step(interpreterState);
+        emulatorState = observed.state(failed);
+        instructions++;
+
+        if (emulatorCycles != interpreterCycles || emulatorState != interpreterState) {
+            return instruction;
+        }
+
+        if (interpreterState.halted || interpreterState.failed) {
+            break;
+        }
+    }
+
+    return -1;
+}
+
+/** Zeroes as many bytes as possible, while the engines still disagree. */
+static MemoryImage minimize(ObservedEmulator &observed, MemoryImage image) {
+    unsigned long instructions = 0;
+    Interpreter::State emulatorState;
+    Interpreter::State interpreterState;
+    bool reduced = true;
+
+    while (reduced) {
+        reduced = false;
+
+        for (uint8_t &value : image) {
+            if (value == 0) {
+                continue;
+            }
+
+            const uint8_t original = value;
+            value = 0;
+
+            if (compare(observed, image, instructions, emulatorState, interpreterState) >= 0) {
+                reduced = true;
+            } else {
+                value = original;
+            }
+        }
+    }
+
+    return image;
+}
+
+static void saveImage(const std::string &fileName, const MemoryImage &image, const std::string &comment) {
+    std::ofstream file(fileName);
+    file << "; " << comment << std::endl;
+
+    for (const uint8_t value : image) {
+        file << "DB " << (int) value << " ; " << Disassembler::disassemble(value) << std::endl;
+    }
+}
+
+static void saveSource(const std::string &fileName, const std::vector<std::string> &lines) {
+    std::ofstream file(fileName);
+
+    for (const auto &line : lines) {
+        file << line << std::endl;
+    }
+}
+
+static MemoryImage randomImage(std::mt19937_64 &random) {
+    MemoryImage image{};
+    // Half of the images only have known opcodes, so they get to run for a while
+    const bool onlyKnown = random() % 2 == 0;
+    const uint8_t knownOpcodes[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 14, 15};
+
+    for (uint8_t &value : image) {
+        value = random();
+
+        if (onlyKnown) {
+            value = (knownOpcodes[random() % sizeof(knownOpcodes)] << 4) | (value & 0x0F);
+        }
+    }
+
+    return image;
+}
+
+static std::vector<std::string> randomSource(std::mt19937_64 &random) {
+    static const std::vector<std::string> words = {
+            "NOP", "LDA", "ADD", "SUB", "STA", "LDI", "JMP", "JC", "JZ", "OUT", "HLT", "ORG", "DB",
+            "lda", "0", "1", "15", "16", "255", "256", "-1", "-129", "99999999999", "0x10", "12abc", "", " ",
+            ";", "; comment", "\t", "monkey", "+5", "DB1", "ORG;"
+    };
+
+    std::vector<std::string> lines;
+    const size_t lineCount = random() % 24;
+
+    for (size_t i = 0; i < lineCount; i++) {
+        std::string line;
+        const size_t wordCount = random() % 4;
+
+        for (size_t j = 0; j < wordCount; j++) {
+            line += words[random() % words.size()];
+            line += random() % 4 == 0 ? "" : " ";
+        }
+
+        lines.push_back(line);
+    }
+
+    return lines;
+}
+
+/** Reduces the image with a mismatch, and saves it with the given prefix in the name. */
+static void reportMismatch(ObservedEmulator &observed, const MemoryImage &image, const int instruction,
+                           const std::string &prefix, Statistics &statistics, const std::string &outputDirectory) {
+    unsigned long instructions = 0;
+    Interpreter::State emulatorState;
+    Interpreter::State interpreterState;
+
+    const MemoryImage reduced = minimize(observed, image);
+    compare(observed, reduced, instructions, emulatorState, interpreterState);
+
+    const unsigned long mismatch = ++statistics.mismatches;
+    const std::string fileName = outputDirectory + "/mismatch-" + prefix + "-" + std::to_string(mismatch) + ".asm";
+    saveImage(fileName, reduced, "Emulator:    " + describe(emulatorState) + "\n; Interpreter: " +
+                                 describe(interpreterState));
+
+    std::lock_guard<std::mutex> lock(reportMutex);
+    std::cerr << "Mismatch after instruction " << instruction << ", saved to " << fileName << std::endl;
+}
+
+static void fuzzEmulator(const unsigned long iterations, const unsigned int seed, Statistics &statistics,
+                         const std::string &outputDirectory) {
+    std::mt19937_64 random(seed);
+    ObservedEmulator observed;
+    unsigned long instructions = 0;
+    Interpreter::State emulatorState;
+    Interpreter::State interpreterState;
+
+    for (unsigned long i = 0; i < iterations; i++) {
+        const MemoryImage image = randomImage(random);
+        const int instruction = compare(observed, image, instructions, emulatorState, interpreterState);
+
+        if (instruction >= 0) {
+            reportMismatch(observed, image, instruction, std::to_string(seed), statistics, outputDirectory);
+        }
+    }
+
+    statistics.images += iterations;
+    statistics.instructions += instructions;
+}
+
+/** Compares every image of the pack, where each of the threads takes every n-th image. */
+static void fuzzCorpus(const PackFile &corpus, const unsigned int thread, const unsigned int threads,
+                       Statistics &statistics, const std::string &outputDirectory) {
+    ObservedEmulator observed;
+    unsigned long instructions = 0;
+    unsigned long images = 0;
+    Interpreter::State emulatorState;
+    Interpreter::State interpreterState;
+
+    for (size_t i = thread; i < corpus.size(); i += threads) {
+        const int instruction = compare(observed, corpus.image(i), instructions, emulatorState, interpreterState);
+
+        if (instruction >= 0) {
+            reportMismatch(observed, corpus.image(i), instruction, "corpus-" + std::to_string(i), statistics,
+                           outputDirectory);
+        }
+
+        images++;
+    }
+
+    statistics.images += images;
+    statistics.instructions += instructions;
+}
+
+/** Assembles the lines both one by one and from memory, which must agree on the result or the first error. */
+static std::string compareAssemble(Assembler &assembler, const std::vector<std::string> &lines) {
+    std::string source;
+
+    for (const auto &line : lines) {
+        source += line + "\n";
+    }
+
+    try {
+        const Assembler::Result result = assembler.assemble(source);
+
+        try {
+            const MemoryImage image = Assembler::toImage(assembler.interpret(lines));
+
+            if (!result.ok()) {
+                return "assemble() reported an error for valid code: " + result.errors.front().message;
+            } else if (result.image != image) {
+                return "assemble() gave a different image";
+            }
+        } catch (const std::runtime_error &e) {
+            if (result.ok()) {
+                return "assemble() did not report an error for: " + std::string(e.what());
+            } else if (e.what() != "Assembler: " + result.errors.front().message) {
+                return "assemble() reported a different error: " + result.errors.front().message;
+            }
+        }
+    } catch (const std::exception &e) {
+        return e.what();
+    }
+
+    return "";
+}
+
+static void fuzzAssembler(const unsigned long iterations, const unsigned int seed, Statistics &statistics,
+                          const std::string &outputDirectory) {
+    std::mt19937_64 random(seed);
+    Assembler assembler;
+
+    for (unsigned long i = 0; i < iterations; i++) {
+        const std::vector<std::string> lines = randomSource(random);
+        std::string problem;
+
+        try {
+            for (const auto &instruction : assembler.interpret(lines)) {
+                if (instruction.address.to_ulong() > 15) {
+                    problem = "address out of bounds";
+                }
+            }
+        } catch (const std::runtime_error &e) {
+            // Expected for invalid code
+        } catch (const std::exception &e) {
+            problem = e.what();
+        }
+
+        if (problem.empty()) {
+            problem = compareAssemble(assembler, lines);
+        }
+
+        if (!problem.empty()) {
+            const unsigned long crash = ++statistics.crashes;
+            const std::string fileName = outputDirectory + "/crash-" + std::to_string(seed) + "-" +
+                                         std::to_string(crash) + ".txt";
+            saveSource(fileName, lines);
+
+            std::lock_guard<std::mutex> lock(reportMutex);
+            std::cerr << "Assembler failed with \"" << problem << "\", saved to " << fileName << std::endl;
+        }
+    }
+
+    statistics.sources += iterations;
+}
+
+static void printUsage() {
+    std::cerr << "Usage: 8bit-fuzz [--iterations <per thread>] [--threads <threads>] [--seed <seed>] "
+                 "[--output <directory>] [--corpus <pack.8bpk>]" << std::endl;
+}
+
+int main(int argc, char **argv) {
+    unsigned long iterations = DEFAULT_ITERATIONS;
+    unsigned int threads = std::max(std::thread::hardware_concurrency(), 1u);
+    unsigned int seed = std::random_device()();
+    std::string outputDirectory = ".";
+    std::string corpusFileName;
+
+    try {
+        for (int i = 1; i < argc; i++) {
+            std::string argument = argv[i];
+
+            if (argument == "--iterations" && i + 1 < argc) {
+                iterations = std::stoul(argv[++i]);
+            } else if (argument == "--threads" && i + 1 < argc) {
+                threads = std::stoul(argv[++i]);
+            } else if (argument == "--seed" && i + 1 < argc) {
+                seed = std::stoul(argv[++i]);
+            } else if (argument == "--output" && i + 1 < argc) {
+                outputDirectory = argv[++i];
+            } else if (argument == "--corpus" && i + 1 < argc) {
+                corpusFileName = argv[++i];
+            } else {
+                throw std::invalid_argument("Unknown argument: " + argument);
+            }
+        }
+    } catch (const std::logic_error &e) {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    std::cerr << "Fuzzing with " << threads << " threads, seed " << seed << std::endl;
+
+    Statistics statistics;
+    std::vector<std::thread> workers;
+
+    // The emulator logs to standard out
+    Core::Log::setQuiet(true);
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for (unsigned int i = 0; i < std::max(threads, 1u); i++) {
+        workers.emplace_back(fuzzEmulator, iterations, seed + i, std::ref(statistics), outputDirectory);
+    }
+
+    for (auto &worker : workers) {
+        worker.join();
+    }
+
+    if (!corpusFileName.empty()) {
+        try {
+            const PackFile corpus(corpusFileName);
+            workers.clear();
+
+            for (unsigned int i = 0; i < std::max(threads, 1u); i++) {
+                workers.emplace_back(fuzzCorpus, std::cref(corpus), i, std::max(threads, 1u), std::ref(statistics),
+                                     outputDirectory);
+            }
+
+            for (auto &worker : workers) {
+                worker.join();
+            }
+        } catch (const std::runtime_error &e) {
+            std::cerr << e.what() << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    const auto middle = std::chrono::steady_clock::now();
+    workers.clear();
+
+    for (unsigned int i = 0; i < std::max(threads, 1u); i++) {
+        workers.emplace_back(fuzzAssembler, iterations, seed + i, std::ref(statistics), outputDirectory);
+    }
+
+    for (auto &worker : workers) {
+        worker.join();
+    }
+
+    const auto end = std::chrono::steady_clock::now();
+
+    const double emulatorSeconds = std::chrono::duration<double>(middle - start).count();
+    const double assemblerSeconds = std::chrono::duration<double>(end - middle).count();
+
+    std::cout << "Emulator:  " << statistics.images << " images, " << statistics.instructions << " instructions, "
+              << (unsigned long) (statistics.images / emulatorSeconds) << " execs/sec, "
+              << statistics.mismatches << " mismatches" << std::endl;
+    std::cout << "Assembler: " << statistics.sources << " sources, "
+              << (unsigned long) (statistics.sources / assemblerSeconds) << " execs/sec, "
+              << statistics.crashes << " crashes" << std::endl;
+
+    return statistics.mismatches == 0 && statistics.crashes == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}